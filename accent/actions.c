@@ -155,7 +155,10 @@ yy yy_6_2_1_1;
 yy yy_8;
 yy yyv_Keys;
 yy yy_9;
-yy yy_10_1;
+yy yy_10_2_4_1;
+yy yy_10_2_6_1;
+yy yy_10_2_8_1;
+yy yy_10_3_1_1;
 yyb = yyh;
 yyh += 1; if (yyh > yyhx) yyExtend();
 yy_1 = yyb + 0;
@@ -190,8 +193,33 @@ yyglov_LabelCount = yy_8;
 yy_9 = yyglov_LHS_List;
 if (yy_9 == (yy) yyu) yyErr(1,52);
 yyv_Keys = yy_9;
-yy_10_1 = yyv_Keys;
-put_actions_LHSKEYS(yy_10_1);
+{
+yy yysb = yyb;
+if (! AstMode()) goto yyfl_1_1_10_1;
+PutAstStart();
+goto yysl_1_1_10;
+yyfl_1_1_10_1 : ;
+if (! StackMode()) goto yyfl_1_1_10_2;
+PutStackWalkSupport();
+StartDeclPass();
+yy_10_2_4_1 = yyv_Keys;
+put_actions_LHSKEYS(yy_10_2_4_1);
+EndDeclPass();
+yy_10_2_6_1 = yyv_Keys;
+put_frame_LHSKEYS(yy_10_2_6_1);
+PutStackWalkStart();
+yy_10_2_8_1 = yyv_Keys;
+put_actions_LHSKEYS(yy_10_2_8_1);
+PutStackWalkEnd();
+goto yysl_1_1_10;
+yyfl_1_1_10_2 : ;
+yy_10_3_1_1 = yyv_Keys;
+put_actions_LHSKEYS(yy_10_3_1_1);
+goto yysl_1_1_10;
+yysl_1_1_10 : ;
+yyb = yysb;
+}
+PutParallelDefault();
 fix_code();
 return;
 }
@@ -207,7 +235,8 @@ yy yy_0_1_1;
 yy yyv_Key;
 yy yy_0_1_2;
 yy yy_1_1;
-yy yy_2_1;
+yy yy_2_1_2_1;
+yy yy_2_2_1_1;
 yy_0_1 = yyin_1;
 if (yy_0_1[0] != 1) goto yyfl_4_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
@@ -216,8 +245,19 @@ yyv_Keys = yy_0_1_1;
 yyv_Key = yy_0_1_2;
 yy_1_1 = yyv_Keys;
 put_actions_LHSKEYS(yy_1_1);
-yy_2_1 = yyv_Key;
-put_actions_LHSKEY(yy_2_1);
+{
+yy yysb = yyb;
+if (! StackMode()) goto yyfl_4_1_2_1;
+yy_2_1_2_1 = yyv_Key;
+put_stack_LHSKEY(yy_2_1_2_1);
+goto yysl_4_1_2;
+yyfl_4_1_2_1 : ;
+yy_2_2_1_1 = yyv_Key;
+put_actions_LHSKEY(yy_2_2_1_1);
+goto yysl_4_1_2;
+yysl_4_1_2 : ;
+yyb = yysb;
+}
 return;
 yyfl_4_1 : ;
 }
@@ -279,6 +319,13 @@ yy yy_2_1_21_2_1_1;
 yy yy_2_1_22_1;
 yy yy_2_1_22_1_1;
 yy yy_2_1_24_1;
+yy yy_2_1_4_3_1;
+yy yy_2_1_4_3_2;
+yy yy_2_1_16_2_1;
+yy yy_2_1_16_2_2;
+yy yy_2_1_26_1;
+yy yy_2_1_26_2;
+yy yy_2_1_26_3;
 yy_0_1 = yyin_1;
 yyv_Key = yy_0_1;
 yy_1 = (yy) yyv_Key[1];
@@ -304,6 +351,9 @@ Nl();
 yy_2_1_4_1 = yyv_Id;
 id_to_string(yy_2_1_4_1, &yy_2_1_4_2);
 yyv_Str = yy_2_1_4_2;
+yy_2_1_4_3_1 = yyv_Str;
+yy_2_1_4_3_2 = yyv_FP;
+put_parallel_struct(yy_2_1_4_3_1, yy_2_1_4_3_2);
 yy_2_1_5_1 = yyv_Str;
 Put(yy_2_1_5_1);
 yy_2_1_6_1 = ((yy)" (");
@@ -329,6 +379,9 @@ yy_2_1_15_1 = (yy)(((long)yy_2_1_15_1_1));
 indentation(yy_2_1_15_1);
 yy_2_1_16_1 = yyv_Clauses;
 local_declarations(yy_2_1_16_1);
+yy_2_1_16_2_1 = yyv_Str;
+yy_2_1_16_2_2 = yyv_FP;
+put_parallel_prologue(yy_2_1_16_2_1, yy_2_1_16_2_2);
 yy_2_1_17 = (yy) yyv_Key[2];
 if (yy_2_1_17 == (yy) yyu) yyErr(1,127);
 yyv_Prelude = yy_2_1_17;
@@ -379,6 +432,10 @@ indent();
 yy_2_1_24_1 = ((yy)"}");
 Put(yy_2_1_24_1);
 Nl();
+yy_2_1_26_1 = yyv_Str;
+yy_2_1_26_2 = yyv_FP;
+yy_2_1_26_3 = yyv_Clauses;
+put_parallel_walk(yy_2_1_26_1, yy_2_1_26_2, yy_2_1_26_3);
 goto yysl_5_1_2;
 yyfl_5_1_2_1 : ;
 goto yysl_5_1_2;
@@ -492,7 +549,7 @@ yy_4_1_1 = ((yy)1);
 yy_4_1 = (yy)(((long)yy_4_1_1));
 indentation(yy_4_1);
 yy_5_1 = yyv_Members;
-put_actions_MEMBERLIST(yy_5_1);
+put_scoped_MEMBERLIST(yy_5_1);
 {
 yy yysb = yyb;
 yy_6_1_1 = yyglov_GrammarClass;
@@ -522,6 +579,23 @@ yyfl_7_1 : ;
 }
 yyErr(2,159);
 }
+put_scoped_MEMBERLIST(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yyv_Members;
+yy yy_0_1;
+yy yy_2_1;
+yy_0_1 = yyin_1;
+yyv_Members = yy_0_1;
+OpenActionScope();
+yy_2_1 = yyv_Members;
+put_actions_MEMBERLIST(yy_2_1);
+CloseActionScope();
+return;
+}
+}
 put_actions_MEMBERLIST(yyin_1)
 yy yyin_1;
 {
@@ -535,7 +609,7 @@ yy yy_0_1_2;
 yy yy_1_1;
 yy yy_2_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_8_1;
+if (yy_0_1[0] != 1) goto yyfl_9_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_H = yy_0_1_1;
@@ -545,15 +619,15 @@ put_actions_MEMBER(yy_1_1);
 yy_2_1 = yyv_T;
 put_actions_MEMBERLIST(yy_2_1);
 return;
-yyfl_8_1 : ;
+yyfl_9_1 : ;
 }
 {
 yy yyb;
 yy yy_0_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 2) goto yyfl_8_2;
+if (yy_0_1[0] != 2) goto yyfl_9_2;
 return;
-yyfl_8_2 : ;
+yyfl_9_2 : ;
 }
 yyErr(2,192);
 }
@@ -595,13 +669,16 @@ yy yy_2_2_1_2_1;
 yy yy_2_2_1_2_2;
 yy yyv_Formals;
 yy yy_2_2_1_2_3;
-yy yy_2_2_3_1;
-yy yy_2_2_4_1;
-yy yy_2_2_5_1;
-yy yy_2_2_5_2;
-yy yy_2_2_6_1;
+yy yy_2_2_2_1_2_1;
+yy yy_2_2_2_1_2_2;
+yy yy_2_2_2_1_2_3;
+yy yy_2_2_2_2_2_1;
+yy yy_2_2_2_2_3_1;
+yy yy_2_2_2_2_4_1;
+yy yy_2_2_2_2_4_2;
+yy yy_2_2_2_2_5_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_9_1;
+if (yy_0_1[0] != 1) goto yyfl_10_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
@@ -615,8 +692,8 @@ yyv_Str = yy_1_2;
 {
 yy yysb = yyb;
 yy_2_1_1_1 = yyv_Id;
-if (! HasMeaning(yy_2_1_1_1, &yy_2_1_1_2)) goto yyfl_9_1_2_1;
-if (yy_2_1_1_2[0] != 1) goto yyfl_9_1_2_1;
+if (! HasMeaning(yy_2_1_1_1, &yy_2_1_1_2)) goto yyfl_10_1_2_1;
+if (yy_2_1_1_2[0] != 1) goto yyfl_10_1_2_1;
 yy_2_1_1_2_1 = ((yy)yy_2_1_1_2[1]);
 yy_2_1_1_2_2 = ((yy)yy_2_1_1_2[2]);
 yyv_N = yy_2_1_1_2_1;
@@ -625,13 +702,13 @@ yyv_FParams = yy_2_1_1_2_2;
 yy yysb = yyb;
 yy_2_1_2_1_1 = yyglov_GrammarClass;
 if (yy_2_1_2_1_1 == (yy) yyu) yyErr(1,204);
-if (yy_2_1_2_1_1[0] != 2) goto yyfl_9_1_2_1_2_1;
+if (yy_2_1_2_1_1[0] != 2) goto yyfl_10_1_2_1_2_1;
 indent();
 yy_2_1_2_1_3_1 = ((yy)"get_lexval();");
 Put(yy_2_1_2_1_3_1);
 Nl();
-goto yysl_9_1_2_1_2;
-yyfl_9_1_2_1_2_1 : ;
+goto yysl_10_1_2_1_2;
+yyfl_10_1_2_1_2_1 : ;
 indent();
 yy_2_1_2_2_2_1 = ((yy)"yycheck(");
 Put(yy_2_1_2_2_2_1);
@@ -640,8 +717,8 @@ PutI(yy_2_1_2_2_3_1);
 yy_2_1_2_2_4_1 = ((yy)");");
 Put(yy_2_1_2_2_4_1);
 Nl();
-goto yysl_9_1_2_1_2;
-yysl_9_1_2_1_2 : ;
+goto yysl_10_1_2_1_2;
+yysl_10_1_2_1_2 : ;
 yyb = yysb;
 }
 yy_2_1_3_1 = yyv_Params;
@@ -652,45 +729,58 @@ handle_token_params(yy_2_1_3_1, yy_2_1_3_2, yy_2_1_3_3);
 yy yysb = yyb;
 yy_2_1_4_1_1 = yyglov_GrammarClass;
 if (yy_2_1_4_1_1 == (yy) yyu) yyErr(1,218);
-if (yy_2_1_4_1_1[0] != 2) goto yyfl_9_1_2_1_4_1;
-goto yysl_9_1_2_1_4;
-yyfl_9_1_2_1_4_1 : ;
+if (yy_2_1_4_1_1[0] != 2) goto yyfl_10_1_2_1_4_1;
+goto yysl_10_1_2_1_4;
+yyfl_10_1_2_1_4_1 : ;
 indent();
 yy_2_1_4_2_2_1 = ((yy)"yycursym = yylex();");
 Put(yy_2_1_4_2_2_1);
 Nl();
-goto yysl_9_1_2_1_4;
-yysl_9_1_2_1_4 : ;
+goto yysl_10_1_2_1_4;
+yysl_10_1_2_1_4 : ;
 yyb = yysb;
 }
-goto yysl_9_1_2;
-yyfl_9_1_2_1 : ;
+goto yysl_10_1_2;
+yyfl_10_1_2_1 : ;
 yy_2_2_1_1 = yyv_Id;
-if (! HasMeaning(yy_2_2_1_1, &yy_2_2_1_2)) goto yyfl_9_1_2_2;
-if (yy_2_2_1_2[0] != 2) goto yyfl_9_1_2_2;
+if (! HasMeaning(yy_2_2_1_1, &yy_2_2_1_2)) goto yyfl_10_1_2_2;
+if (yy_2_2_1_2[0] != 2) goto yyfl_10_1_2_2;
 yy_2_2_1_2_1 = ((yy)yy_2_2_1_2[1]);
 yy_2_2_1_2_2 = ((yy)yy_2_2_1_2[2]);
 yy_2_2_1_2_3 = ((yy)yy_2_2_1_2[3]);
 yyv_Formals = yy_2_2_1_2_3;
+{
+yy yysb = yyb;
+if (! StackMode()) goto yyfl_10_1_2_2_2_1;
+yy_2_2_2_1_2_1 = yyv_Str;
+yy_2_2_2_1_2_2 = yyv_Params;
+yy_2_2_2_1_2_3 = yyv_Formals;
+put_stack_call(yy_2_2_2_1_2_1, yy_2_2_2_1_2_2, yy_2_2_2_1_2_3);
+goto yysl_10_1_2_2_2;
+yyfl_10_1_2_2_2_1 : ;
 indent();
-yy_2_2_3_1 = yyv_Str;
-Put(yy_2_2_3_1);
-yy_2_2_4_1 = ((yy)"(");
-Put(yy_2_2_4_1);
-yy_2_2_5_1 = yyv_Params;
-yy_2_2_5_2 = yyv_Formals;
-handle_actual_params(yy_2_2_5_1, yy_2_2_5_2);
-yy_2_2_6_1 = ((yy)");");
-Put(yy_2_2_6_1);
-Nl();
-goto yysl_9_1_2;
-yyfl_9_1_2_2 : ;
-goto yyfl_9_1;
-yysl_9_1_2 : ;
+yy_2_2_2_2_2_1 = yyv_Str;
+Put(yy_2_2_2_2_2_1);
+yy_2_2_2_2_3_1 = ((yy)"(");
+Put(yy_2_2_2_2_3_1);
+yy_2_2_2_2_4_1 = yyv_Params;
+yy_2_2_2_2_4_2 = yyv_Formals;
+handle_actual_params(yy_2_2_2_2_4_1, yy_2_2_2_2_4_2);
+yy_2_2_2_2_5_1 = ((yy)");");
+Put(yy_2_2_2_2_5_1);
+Nl();
+goto yysl_10_1_2_2_2;
+yysl_10_1_2_2_2 : ;
+yyb = yysb;
+}
+goto yysl_10_1_2;
+yyfl_10_1_2_2 : ;
+goto yyfl_10_1;
+yysl_10_1_2 : ;
 yyb = yysb;
 }
 return;
-yyfl_9_1 : ;
+yyfl_10_1 : ;
 }
 {
 yy yyb;
@@ -704,20 +794,20 @@ yy yy_1_2_3_1;
 yy yy_1_2_4_1;
 yy yy_1_2_7_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 2) goto yyfl_9_2;
+if (yy_0_1[0] != 2) goto yyfl_10_2;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yyv_N = yy_0_1_1;
 {
 yy yysb = yyb;
 yy_1_1_1 = yyglov_GrammarClass;
 if (yy_1_1_1 == (yy) yyu) yyErr(1,235);
-if (yy_1_1_1[0] != 2) goto yyfl_9_2_1_1;
+if (yy_1_1_1[0] != 2) goto yyfl_10_2_1_1;
 indent();
 yy_1_1_3_1 = ((yy)"get_lexval();");
 Put(yy_1_1_3_1);
 Nl();
-goto yysl_9_2_1;
-yyfl_9_2_1_1 : ;
+goto yysl_10_2_1;
+yyfl_10_2_1_1 : ;
 indent();
 yy_1_2_2_1 = ((yy)"yycheck(");
 Put(yy_1_2_2_1);
@@ -730,12 +820,12 @@ indent();
 yy_1_2_7_1 = ((yy)"yycursym = yylex();");
 Put(yy_1_2_7_1);
 Nl();
-goto yysl_9_2_1;
-yysl_9_2_1 : ;
+goto yysl_10_2_1;
+yysl_10_2_1 : ;
 yyb = yysb;
 }
 return;
-yyfl_9_2 : ;
+yyfl_10_2 : ;
 }
 {
 yy yyb;
@@ -753,13 +843,13 @@ yy yy_4_1;
 yy yy_6_1;
 yy yy_9_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 3) goto yyfl_9_3;
+if (yy_0_1[0] != 3) goto yyfl_10_3;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
 yy_0_1_4 = ((yy)yy_0_1[4]);
 yy_0_1_5 = ((yy)yy_0_1[5]);
-if (yy_0_1_1[0] != 1) goto yyfl_9_3;
+if (yy_0_1_1[0] != 1) goto yyfl_10_3;
 yyv_Alternatives = yy_0_1_2;
 yyv_Key = yy_0_1_3;
 yyv_Coordinate = yy_0_1_5;
@@ -778,7 +868,7 @@ yy_9_1 = ((yy)"}");
 Put(yy_9_1);
 Nl();
 return;
-yyfl_9_3 : ;
+yyfl_10_3 : ;
 }
 {
 yy yyb;
@@ -809,13 +899,13 @@ yy yy_23_1;
 yy yy_24_1;
 yy yy_25_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 3) goto yyfl_9_4;
+if (yy_0_1[0] != 3) goto yyfl_10_4;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
 yy_0_1_4 = ((yy)yy_0_1[4]);
 yy_0_1_5 = ((yy)yy_0_1[5]);
-if (yy_0_1_1[0] != 2) goto yyfl_9_4;
+if (yy_0_1_1[0] != 2) goto yyfl_10_4;
 yyv_Alternatives = yy_0_1_2;
 yyv_Key = yy_0_1_3;
 yyv_Coordinate = yy_0_1_5;
@@ -862,7 +952,7 @@ yy_25_1 = ((yy)": ;");
 Put(yy_25_1);
 Nl();
 return;
-yyfl_9_4 : ;
+yyfl_10_4 : ;
 }
 {
 yy yyb;
@@ -879,14 +969,15 @@ yy yy_2_1;
 yy yy_4_1;
 yy yy_6_1;
 yy yy_9_1;
+yy yy_12_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 3) goto yyfl_9_5;
+if (yy_0_1[0] != 3) goto yyfl_10_5;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
 yy_0_1_4 = ((yy)yy_0_1[4]);
 yy_0_1_5 = ((yy)yy_0_1[5]);
-if (yy_0_1_1[0] != 3) goto yyfl_9_5;
+if (yy_0_1_1[0] != 3) goto yyfl_10_5;
 yyv_Alternatives = yy_0_1_2;
 yyv_Key = yy_0_1_3;
 yyv_Coordinate = yy_0_1_5;
@@ -897,15 +988,19 @@ Nl();
 yy_4_1 = yyv_Alternatives;
 put_actions_ALTERNATIVELIST(yy_4_1);
 indent();
-yy_6_1 = ((yy)"default: printf(\"???\\n\"); exit(1);");
+yy_6_1 = ((yy)"case 0: break;");
 Put(yy_6_1);
 Nl();
 indent();
-yy_9_1 = ((yy)"}");
+yy_9_1 = ((yy)"default: printf(\"???\\n\"); exit(1);");
 Put(yy_9_1);
 Nl();
+indent();
+yy_12_1 = ((yy)"}");
+Put(yy_12_1);
+Nl();
 return;
-yyfl_9_5 : ;
+yyfl_10_5 : ;
 }
 {
 yy yyb;
@@ -916,7 +1011,7 @@ yy yy_1_1;
 yy yy_1_2;
 yy yy_1_3;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 4) goto yyfl_9_6;
+if (yy_0_1[0] != 4) goto yyfl_10_6;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yyv_Blk = yy_0_1_1;
 yy_1_1 = ((yy)"");
@@ -924,7 +1019,7 @@ yy_1_2 = yyv_Blk;
 yy_1_3 = ((yy)"");
 put_CodeBlock(yy_1_1, yy_1_2, yy_1_3);
 return;
-yyfl_9_6 : ;
+yyfl_10_6 : ;
 }
 yyErr(2,198);
 }
@@ -941,7 +1036,7 @@ yy yy_0_1_2;
 yy yy_1_1;
 yy yy_2_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_10_1;
+if (yy_0_1[0] != 1) goto yyfl_11_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_H = yy_0_1_1;
@@ -951,15 +1046,15 @@ put_actions_ALTERNATIVE(yy_1_1);
 yy_2_1 = yyv_T;
 put_actions_ALTERNATIVELIST(yy_2_1);
 return;
-yyfl_10_1 : ;
+yyfl_11_1 : ;
 }
 {
 yy yyb;
 yy yy_0_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 2) goto yyfl_10_2;
+if (yy_0_1[0] != 2) goto yyfl_11_2;
 return;
-yyfl_10_2 : ;
+yyfl_11_2 : ;
 }
 yyErr(2,306);
 }
@@ -990,7 +1085,7 @@ yy yy_11_1;
 yy yy_13_1;
 yy yy_13_1_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_11_1;
+if (yy_0_1[0] != 1) goto yyfl_12_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
@@ -1016,7 +1111,7 @@ yy_8_1_1 = ((yy)1);
 yy_8_1 = (yy)(((long)yy_8_1_1));
 indentation(yy_8_1);
 yy_9_1 = yyv_Members;
-put_actions_MEMBERLIST(yy_9_1);
+put_scoped_MEMBERLIST(yy_9_1);
 indent();
 yy_11_1 = ((yy)"} break;");
 Put(yy_11_1);
@@ -1025,7 +1120,7 @@ yy_13_1_1 = ((yy)1);
 yy_13_1 = (yy)(-((long)yy_13_1_1));
 indentation(yy_13_1);
 return;
-yyfl_11_1 : ;
+yyfl_12_1 : ;
 }
 yyErr(2,312);
 }
@@ -1054,7 +1149,7 @@ yy yy_4_1_1_2;
 yy yy_4_1_2_1;
 yy yy_5_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_12_1;
+if (yy_0_1[0] != 1) goto yyfl_13_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_H = yy_0_1_1;
@@ -1063,7 +1158,7 @@ yy_1_1 = yyv_H;
 handle_formal_param_1(yy_1_1);
 yy_2_1 = yyv_H;
 yy_2_2 = yy_2_1;
-if (yy_2_2[0] != 1) goto yyfl_12_1;
+if (yy_2_2[0] != 1) goto yyfl_13_1;
 yy_2_2_1 = ((yy)yy_2_2[1]);
 yy_2_2_2 = ((yy)yy_2_2[2]);
 yy_2_2_3 = ((yy)yy_2_2[3]);
@@ -1076,27 +1171,27 @@ check_formal_param(yy_3_1, yy_3_2);
 yy yysb = yyb;
 yy_4_1_1_1 = yyv_T;
 yy_4_1_1_2 = yy_4_1_1_1;
-if (yy_4_1_1_2[0] != 1) goto yyfl_12_1_4_1;
+if (yy_4_1_1_2[0] != 1) goto yyfl_13_1_4_1;
 yy_4_1_2_1 = ((yy)", ");
 Put(yy_4_1_2_1);
-goto yysl_12_1_4;
-yyfl_12_1_4_1 : ;
-goto yysl_12_1_4;
-yysl_12_1_4 : ;
+goto yysl_13_1_4;
+yyfl_13_1_4_1 : ;
+goto yysl_13_1_4;
+yysl_13_1_4 : ;
 yyb = yysb;
 }
 yy_5_1 = yyv_T;
 handle_formal_params_1(yy_5_1);
 return;
-yyfl_12_1 : ;
+yyfl_13_1 : ;
 }
 {
 yy yyb;
 yy yy_0_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 2) goto yyfl_12_2;
+if (yy_0_1[0] != 2) goto yyfl_13_2;
 return;
-yyfl_12_2 : ;
+yyfl_13_2 : ;
 }
 yyErr(2,357);
 }
@@ -1119,7 +1214,7 @@ yy yyv_NStr;
 yy yy_1_2;
 yy yy_2_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_13_1;
+if (yy_0_1[0] != 1) goto yyfl_14_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
@@ -1134,7 +1229,7 @@ yyv_NStr = yy_1_2;
 yy_2_1 = yyv_NStr;
 Put(yy_2_1);
 return;
-yyfl_13_1 : ;
+yyfl_14_1 : ;
 }
 yyErr(2,369);
 }
@@ -1167,10 +1262,10 @@ yy yy_2_2;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
 yyv_Name1 = yy_0_1;
-if (yy_0_2[0] != 1) goto yyfl_14_1;
+if (yy_0_2[0] != 1) goto yyfl_15_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
-if (yy_0_2_1[0] != 1) goto yyfl_14_1;
+if (yy_0_2_1[0] != 1) goto yyfl_15_1;
 yy_0_2_1_1 = ((yy)yy_0_2_1[1]);
 yy_0_2_1_2 = ((yy)yy_0_2_1[2]);
 yy_0_2_1_3 = ((yy)yy_0_2_1[3]);
@@ -1182,23 +1277,23 @@ yyv_Tl = yy_0_2_2;
 yy yysb = yyb;
 yy_1_1_1_1 = yyv_Name1;
 yy_1_1_1_2 = yyv_Name2;
-if (! yyeq_IDENT(yy_1_1_1_1, yy_1_1_1_2)) goto yyfl_14_1_1_1;
+if (! yyeq_IDENT(yy_1_1_1_1, yy_1_1_1_2)) goto yyfl_15_1_1_1;
 yy_1_1_2_1 = ((yy)"formal parameter '");
 yy_1_1_2_2 = yyv_Name1;
 yy_1_1_2_3 = ((yy)"' declared more than once");
 yy_1_1_2_4 = yyv_Pos;
 ErrorI(yy_1_1_2_1, yy_1_1_2_2, yy_1_1_2_3, yy_1_1_2_4);
-goto yysl_14_1_1;
-yyfl_14_1_1_1 : ;
-goto yysl_14_1_1;
-yysl_14_1_1 : ;
+goto yysl_15_1_1;
+yyfl_15_1_1_1 : ;
+goto yysl_15_1_1;
+yysl_15_1_1 : ;
 yyb = yysb;
 }
 yy_2_1 = yyv_Name1;
 yy_2_2 = yyv_Tl;
 check_formal_param(yy_2_1, yy_2_2);
 return;
-yyfl_14_1 : ;
+yyfl_15_1 : ;
 }
 {
 yy yyb;
@@ -1206,9 +1301,9 @@ yy yy_0_1;
 yy yy_0_2;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_2[0] != 2) goto yyfl_14_2;
+if (yy_0_2[0] != 2) goto yyfl_15_2;
 return;
-yyfl_14_2 : ;
+yyfl_15_2 : ;
 }
 yyErr(2,374);
 }
@@ -1225,7 +1320,7 @@ yy yy_0_1_2;
 yy yy_1_1;
 yy yy_2_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_15_1;
+if (yy_0_1[0] != 1) goto yyfl_16_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_H = yy_0_1_1;
@@ -1235,15 +1330,15 @@ handle_formal_param_2(yy_1_1);
 yy_2_1 = yyv_T;
 handle_formal_params_2(yy_2_1);
 return;
-yyfl_15_1 : ;
+yyfl_16_1 : ;
 }
 {
 yy yyb;
 yy yy_0_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 2) goto yyfl_15_2;
+if (yy_0_1[0] != 2) goto yyfl_16_2;
 return;
-yyfl_15_2 : ;
+yyfl_16_2 : ;
 }
 yyErr(2,385);
 }
@@ -1265,21 +1360,21 @@ yy yy_1_1;
 yy yyv_TStr;
 yy yy_1_2;
 yy yy_2_1;
-yy yy_3_1;
-yy yy_4_1;
-yy yy_5_1_1_1;
-yy yy_5_1_1_2;
-yy yy_5_1_2_1;
-yy yy_6_1;
 yy yyv_NStr;
-yy yy_6_2;
-yy yy_7_1;
-yy yy_8_1;
-yy yy_10_1;
-yy yy_10_2;
-yy yy_10_3;
+yy yy_2_2;
+yy yy_3_1_1_1;
+yy yy_3_1_1_2;
+yy yy_3_1_2_1;
+yy yy_3_1_2_2;
+yy yy_3_1_2_3;
+yy yy_3_2_1_1;
+yy yy_3_2_1_2;
+yy yy_3_2_1_3;
+yy yy_4_1;
+yy yy_4_2;
+yy yy_4_3;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_16_1;
+if (yy_0_1[0] != 1) goto yyfl_17_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
@@ -1291,39 +1386,34 @@ yyv_Pos = yy_0_1_4;
 yy_1_1 = yyv_Type;
 id_to_string(yy_1_1, &yy_1_2);
 yyv_TStr = yy_1_2;
-yy_2_1 = ((yy)"   ");
-Put(yy_2_1);
-yy_3_1 = yyv_TStr;
-Put(yy_3_1);
-yy_4_1 = ((yy)" ");
-Put(yy_4_1);
+yy_2_1 = yyv_Name;
+id_to_string(yy_2_1, &yy_2_2);
+yyv_NStr = yy_2_2;
 {
 yy yysb = yyb;
-yy_5_1_1_1 = yyv_Mode;
-yy_5_1_1_2 = yy_5_1_1_1;
-if (yy_5_1_1_2[0] != 2) goto yyfl_16_1_5_1;
-yy_5_1_2_1 = ((yy)"*");
-Put(yy_5_1_2_1);
-goto yysl_16_1_5;
-yyfl_16_1_5_1 : ;
-goto yysl_16_1_5;
-yysl_16_1_5 : ;
+yy_3_1_1_1 = yyv_Mode;
+yy_3_1_1_2 = yy_3_1_1_1;
+if (yy_3_1_1_2[0] != 2) goto yyfl_17_1_3_1;
+yy_3_1_2_1 = yyv_TStr;
+yy_3_1_2_2 = ((yy)"*");
+yy_3_1_2_3 = yyv_NStr;
+PutLocalDecl(yy_3_1_2_1, yy_3_1_2_2, yy_3_1_2_3);
+goto yysl_17_1_3;
+yyfl_17_1_3_1 : ;
+yy_3_2_1_1 = yyv_TStr;
+yy_3_2_1_2 = ((yy)"");
+yy_3_2_1_3 = yyv_NStr;
+PutLocalDecl(yy_3_2_1_1, yy_3_2_1_2, yy_3_2_1_3);
+goto yysl_17_1_3;
+yysl_17_1_3 : ;
 yyb = yysb;
 }
-yy_6_1 = yyv_Name;
-id_to_string(yy_6_1, &yy_6_2);
-yyv_NStr = yy_6_2;
-yy_7_1 = yyv_NStr;
-Put(yy_7_1);
-yy_8_1 = ((yy)";");
-Put(yy_8_1);
-Nl();
-yy_10_1 = yyv_Mode;
-yy_10_2 = yyv_Type;
-yy_10_3 = yyv_Name;
-define_local_name(yy_10_1, yy_10_2, yy_10_3);
+yy_4_1 = yyv_Mode;
+yy_4_2 = yyv_Type;
+yy_4_3 = yyv_Name;
+define_local_name(yy_4_1, yy_4_2, yy_4_3);
 return;
-yyfl_16_1 : ;
+yyfl_17_1 : ;
 }
 yyErr(2,393);
 }
@@ -1353,13 +1443,13 @@ yy yy_3_1;
 yy yy_3_2;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 1) goto yyfl_17_1;
+if (yy_0_1[0] != 1) goto yyfl_18_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
 yyv_H = yy_0_1_1;
 yyv_T = yy_0_1_2;
-if (yy_0_2[0] != 1) goto yyfl_17_1;
+if (yy_0_2[0] != 1) goto yyfl_18_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yyv_H2 = yy_0_2_1;
@@ -1371,20 +1461,20 @@ handle_actual_param(yy_1_1, yy_1_2);
 yy yysb = yyb;
 yy_2_1_1_1 = yyv_T;
 yy_2_1_1_2 = yy_2_1_1_1;
-if (yy_2_1_1_2[0] != 1) goto yyfl_17_1_2_1;
+if (yy_2_1_1_2[0] != 1) goto yyfl_18_1_2_1;
 yy_2_1_2_1 = ((yy)", ");
 Put(yy_2_1_2_1);
-goto yysl_17_1_2;
-yyfl_17_1_2_1 : ;
-goto yysl_17_1_2;
-yysl_17_1_2 : ;
+goto yysl_18_1_2;
+yyfl_18_1_2_1 : ;
+goto yysl_18_1_2;
+yysl_18_1_2 : ;
 yyb = yysb;
 }
 yy_3_1 = yyv_T;
 yy_3_2 = yyv_T2;
 handle_actual_params(yy_3_1, yy_3_2);
 return;
-yyfl_17_1 : ;
+yyfl_18_1 : ;
 }
 {
 yy yyb;
@@ -1392,10 +1482,10 @@ yy yy_0_1;
 yy yy_0_2;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 2) goto yyfl_17_2;
-if (yy_0_2[0] != 2) goto yyfl_17_2;
+if (yy_0_1[0] != 2) goto yyfl_18_2;
+if (yy_0_2[0] != 2) goto yyfl_18_2;
 return;
-yyfl_17_2 : ;
+yyfl_18_2 : ;
 }
 yyErr(2,413);
 }
@@ -1434,11 +1524,11 @@ yy yy_3_2;
 yy yy_4_1;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 1) goto yyfl_18_1;
+if (yy_0_1[0] != 1) goto yyfl_19_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_Id = yy_0_1_1;
-if (yy_0_2[0] != 1) goto yyfl_18_1;
+if (yy_0_2[0] != 1) goto yyfl_19_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yy_0_2_3 = ((yy)yy_0_2[3]);
@@ -1446,43 +1536,43 @@ yy_0_2_4 = ((yy)yy_0_2[4]);
 yyv_FMode = yy_0_2_1;
 yyv_FType = yy_0_2_2;
 yy_1_1 = yyv_Id;
-if (! defined_locally(yy_1_1, &yy_1_2, &yy_1_3)) goto yyfl_18_1;
+if (! defined_locally(yy_1_1, &yy_1_2, &yy_1_3)) goto yyfl_19_1;
 yyv_AMode = yy_1_2;
 {
 yy yysb = yyb;
 yy_2_1_1_1 = yyv_FMode;
 yy_2_1_1_2 = yy_2_1_1_1;
-if (yy_2_1_1_2[0] != 2) goto yyfl_18_1_2_1;
+if (yy_2_1_1_2[0] != 2) goto yyfl_19_1_2_1;
 {
 yy yysb = yyb;
 yy_2_1_2_1_1_1 = yyv_AMode;
 yy_2_1_2_1_1_2 = yy_2_1_2_1_1_1;
-if (yy_2_1_2_1_1_2[0] != 2) goto yyfl_18_1_2_1_2_1;
-goto yysl_18_1_2_1_2;
-yyfl_18_1_2_1_2_1 : ;
+if (yy_2_1_2_1_1_2[0] != 2) goto yyfl_19_1_2_1_2_1;
+goto yysl_19_1_2_1_2;
+yyfl_19_1_2_1_2_1 : ;
 yy_2_1_2_2_1_1 = ((yy)"&");
 Put(yy_2_1_2_2_1_1);
-goto yysl_18_1_2_1_2;
-yysl_18_1_2_1_2 : ;
+goto yysl_19_1_2_1_2;
+yysl_19_1_2_1_2 : ;
 yyb = yysb;
 }
-goto yysl_18_1_2;
-yyfl_18_1_2_1 : ;
+goto yysl_19_1_2;
+yyfl_19_1_2_1 : ;
 {
 yy yysb = yyb;
 yy_2_2_1_1_1_1 = yyv_AMode;
 yy_2_2_1_1_1_2 = yy_2_2_1_1_1_1;
-if (yy_2_2_1_1_1_2[0] != 2) goto yyfl_18_1_2_2_1_1;
+if (yy_2_2_1_1_1_2[0] != 2) goto yyfl_19_1_2_2_1_1;
 yy_2_2_1_1_2_1 = ((yy)"*");
 Put(yy_2_2_1_1_2_1);
-goto yysl_18_1_2_2_1;
-yyfl_18_1_2_2_1_1 : ;
-goto yysl_18_1_2_2_1;
-yysl_18_1_2_2_1 : ;
+goto yysl_19_1_2_2_1;
+yyfl_19_1_2_2_1_1 : ;
+goto yysl_19_1_2_2_1;
+yysl_19_1_2_2_1 : ;
 yyb = yysb;
 }
-goto yysl_18_1_2;
-yysl_18_1_2 : ;
+goto yysl_19_1_2;
+yysl_19_1_2 : ;
 yyb = yysb;
 }
 yy_3_1 = yyv_Id;
@@ -1491,7 +1581,7 @@ yyv_Str = yy_3_2;
 yy_4_1 = yyv_Str;
 Put(yy_4_1);
 return;
-yyfl_18_1 : ;
+yyfl_19_1 : ;
 }
 yyErr(2,420);
 }
@@ -1521,13 +1611,13 @@ yy yy_1_3;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
 yy_0_3 = yyin_3;
-if (yy_0_1[0] != 1) goto yyfl_19_1;
+if (yy_0_1[0] != 1) goto yyfl_20_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
 yyv_H = yy_0_1_1;
 yyv_T = yy_0_1_2;
-if (yy_0_2[0] != 1) goto yyfl_19_1;
+if (yy_0_2[0] != 1) goto yyfl_20_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yyv_H2 = yy_0_2_1;
@@ -1538,7 +1628,7 @@ yy_1_2 = yyv_H2;
 yy_1_3 = yyv_N;
 handle_token_param(yy_1_1, yy_1_2, yy_1_3);
 return;
-yyfl_19_1 : ;
+yyfl_20_1 : ;
 }
 {
 yy yyb;
@@ -1548,9 +1638,9 @@ yy yy_0_3;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
 yy_0_3 = yyin_3;
-if (yy_0_1[0] != 2) goto yyfl_19_2;
+if (yy_0_1[0] != 2) goto yyfl_20_2;
 return;
-yyfl_19_2 : ;
+yyfl_20_2 : ;
 }
 yyErr(2,445);
 }
@@ -1591,11 +1681,11 @@ yy yy_6_1;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
 yy_0_3 = yyin_3;
-if (yy_0_1[0] != 1) goto yyfl_20_1;
+if (yy_0_1[0] != 1) goto yyfl_21_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_Id = yy_0_1_1;
-if (yy_0_2[0] != 1) goto yyfl_20_1;
+if (yy_0_2[0] != 1) goto yyfl_21_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yy_0_2_3 = ((yy)yy_0_2[3]);
@@ -1604,31 +1694,31 @@ yyv_FMode = yy_0_2_1;
 yyv_FType = yy_0_2_2;
 yyv_N = yy_0_3;
 yy_1_1 = yyv_Id;
-if (! defined_locally(yy_1_1, &yy_1_2, &yy_1_3)) goto yyfl_20_1;
+if (! defined_locally(yy_1_1, &yy_1_2, &yy_1_3)) goto yyfl_21_1;
 yyv_AMode = yy_1_2;
 indent();
 {
 yy yysb = yyb;
 yy_3_1_1_1 = yyv_FMode;
 yy_3_1_1_2 = yy_3_1_1_1;
-if (yy_3_1_1_2[0] != 2) goto yyfl_20_1_3_1;
+if (yy_3_1_1_2[0] != 2) goto yyfl_21_1_3_1;
 {
 yy yysb = yyb;
 yy_3_1_2_1_1_1 = yyv_AMode;
 yy_3_1_2_1_1_2 = yy_3_1_2_1_1_1;
-if (yy_3_1_2_1_1_2[0] != 2) goto yyfl_20_1_3_1_2_1;
+if (yy_3_1_2_1_1_2[0] != 2) goto yyfl_21_1_3_1_2_1;
 yy_3_1_2_1_2_1 = ((yy)"*");
 Put(yy_3_1_2_1_2_1);
-goto yysl_20_1_3_1_2;
-yyfl_20_1_3_1_2_1 : ;
-goto yysl_20_1_3_1_2;
-yysl_20_1_3_1_2 : ;
+goto yysl_21_1_3_1_2;
+yyfl_21_1_3_1_2_1 : ;
+goto yysl_21_1_3_1_2;
+yysl_21_1_3_1_2 : ;
 yyb = yysb;
 }
-goto yysl_20_1_3;
-yyfl_20_1_3_1 : ;
-goto yysl_20_1_3;
-yysl_20_1_3 : ;
+goto yysl_21_1_3;
+yyfl_21_1_3_1 : ;
+goto yysl_21_1_3;
+yysl_21_1_3 : ;
 yyb = yysb;
 }
 yy_4_1 = yyv_Id;
@@ -1640,7 +1730,7 @@ yy_6_1 = ((yy)" = yylval;");
 Put(yy_6_1);
 Nl();
 return;
-yyfl_20_1 : ;
+yyfl_21_1 : ;
 }
 yyErr(2,451);
 }
@@ -1695,7 +1785,7 @@ yy yy_0_1_2;
 yy yy_1_1;
 yy yy_2_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_24_1;
+if (yy_0_1[0] != 1) goto yyfl_25_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_Keys = yy_0_1_1;
@@ -1705,15 +1795,15 @@ local_declarations_CLAUSEKEYS(yy_1_1);
 yy_2_1 = yyv_Key;
 local_declarations_CLAUSEKEY(yy_2_1);
 return;
-yyfl_24_1 : ;
+yyfl_25_1 : ;
 }
 {
 yy yyb;
 yy yy_0_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 2) goto yyfl_24_2;
+if (yy_0_1[0] != 2) goto yyfl_25_2;
 return;
-yyfl_24_2 : ;
+yyfl_25_2 : ;
 }
 yyErr(2,490);
 }
@@ -1732,7 +1822,7 @@ yy_0_1 = yyin_1;
 yyv_ClauseKey = yy_0_1;
 yy_1 = (yy) yyv_ClauseKey[2];
 if (yy_1 == (yy) yyu) yyErr(1,498);
-if (yy_1[0] != 1) goto yyfl_25_1;
+if (yy_1[0] != 1) goto yyfl_26_1;
 yy_1_1 = ((yy)yy_1[1]);
 yyv_Members = yy_1_1;
 yy_2_1 = yyv_Members;
@@ -1741,7 +1831,7 @@ extern local_declarations_sweep();
 yybroadcast_MEMBERLIST(yy_2_1, 0, &yynull, local_declarations_sweep);
 }
 return;
-yyfl_25_1 : ;
+yyfl_26_1 : ;
 }
 yyErr(2,496);
 }
@@ -1780,7 +1870,7 @@ yy yy_2_2_1_2_1;
 yy yy_2_2_1_2_2;
 yy yy_2_2_2_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_26_10001;
+if (yy_0_1[0] != 1) goto yyfl_27_10001;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
@@ -1789,13 +1879,13 @@ yyv_Id = yy_0_1_1;
 yyv_ActParams = yy_0_1_2;
 yyv_Pos = yy_0_1_4;
 yy_1_1 = yyv_Id;
-if (! HasMeaning(yy_1_1, &yy_1_2)) goto yyfl_26_10001;
+if (! HasMeaning(yy_1_1, &yy_1_2)) goto yyfl_27_10001;
 yyv_Meaning = yy_1_2;
 {
 yy yysb = yyb;
 yy_2_1_1_1 = yyv_Meaning;
 yy_2_1_1_2 = yy_2_1_1_1;
-if (yy_2_1_1_2[0] != 2) goto yyfl_26_10001_2_1;
+if (yy_2_1_1_2[0] != 2) goto yyfl_27_10001_2_1;
 yy_2_1_1_2_1 = ((yy)yy_2_1_1_2[1]);
 yy_2_1_1_2_2 = ((yy)yy_2_1_1_2[2]);
 yy_2_1_1_2_3 = ((yy)yy_2_1_1_2[3]);
@@ -1803,25 +1893,25 @@ yyv_FormalParams = yy_2_1_1_2_3;
 yy_2_1_2_1 = yyv_FormalParams;
 yy_2_1_2_2 = yyv_ActParams;
 process_formal_and_actual_params(yy_2_1_2_1, yy_2_1_2_2);
-goto yysl_26_10001_2;
-yyfl_26_10001_2_1 : ;
+goto yysl_27_10001_2;
+yyfl_27_10001_2_1 : ;
 yy_2_2_1_1 = yyv_Meaning;
 yy_2_2_1_2 = yy_2_2_1_1;
-if (yy_2_2_1_2[0] != 1) goto yyfl_26_10001_2_2;
+if (yy_2_2_1_2[0] != 1) goto yyfl_27_10001_2_2;
 yy_2_2_1_2_1 = ((yy)yy_2_2_1_2[1]);
 yy_2_2_1_2_2 = ((yy)yy_2_2_1_2[2]);
 yyv_FormalParams = yy_2_2_1_2_2;
 yy_2_2_2_1 = yyv_ActParams;
 process_token_param(yy_2_2_2_1);
-goto yysl_26_10001_2;
-yyfl_26_10001_2_2 : ;
-goto yyfl_26_10001;
-yysl_26_10001_2 : ;
+goto yysl_27_10001_2;
+yyfl_27_10001_2_2 : ;
+goto yyfl_27_10001;
+yysl_27_10001_2 : ;
 yyb = yysb;
 }
 *yyout_1 = yyin_2;
 return 1;
-yyfl_26_10001 : ;
+yyfl_27_10001 : ;
 }
 return 0;
 }
@@ -1853,12 +1943,12 @@ yy yy_2_1;
 yy yy_2_2;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 1) goto yyfl_27_1;
+if (yy_0_1[0] != 1) goto yyfl_28_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yyv_FHd = yy_0_1_1;
 yyv_FTl = yy_0_1_2;
-if (yy_0_2[0] != 1) goto yyfl_27_1;
+if (yy_0_2[0] != 1) goto yyfl_28_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yy_0_2_3 = ((yy)yy_0_2[3]);
@@ -1872,7 +1962,7 @@ yy_2_1 = yyv_FTl;
 yy_2_2 = yyv_ATl;
 process_formal_and_actual_params(yy_2_1, yy_2_2);
 return;
-yyfl_27_1 : ;
+yyfl_28_1 : ;
 }
 {
 yy yyb;
@@ -1881,11 +1971,11 @@ yy yy_0_2;
 yy yy_0_2_1;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 2) goto yyfl_27_2;
-if (yy_0_2[0] != 2) goto yyfl_27_2;
+if (yy_0_1[0] != 2) goto yyfl_28_2;
+if (yy_0_2[0] != 2) goto yyfl_28_2;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 return;
-yyfl_27_2 : ;
+yyfl_28_2 : ;
 }
 {
 yy yyb;
@@ -1899,8 +1989,8 @@ yy yy_1_1;
 yy yy_1_2;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 2) goto yyfl_27_3;
-if (yy_0_2[0] != 1) goto yyfl_27_3;
+if (yy_0_1[0] != 2) goto yyfl_28_3;
+if (yy_0_2[0] != 1) goto yyfl_28_3;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yy_0_2_3 = ((yy)yy_0_2[3]);
@@ -1909,7 +1999,7 @@ yy_1_1 = ((yy)"too many actual parameters");
 yy_1_2 = yyv_Pos;
 Error(yy_1_1, yy_1_2);
 return;
-yyfl_27_3 : ;
+yyfl_28_3 : ;
 }
 {
 yy yyb;
@@ -1923,17 +2013,17 @@ yy yy_1_1;
 yy yy_1_2;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 1) goto yyfl_27_4;
+if (yy_0_1[0] != 1) goto yyfl_28_4;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
-if (yy_0_2[0] != 2) goto yyfl_27_4;
+if (yy_0_2[0] != 2) goto yyfl_28_4;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yyv_Pos = yy_0_2_1;
 yy_1_1 = ((yy)"too few actual parameters");
 yy_1_2 = yyv_Pos;
 Error(yy_1_1, yy_1_2);
 return;
-yyfl_27_4 : ;
+yyfl_28_4 : ;
 }
 yyErr(2,512);
 }
@@ -1971,19 +2061,17 @@ yy yy_1_2_1_1;
 yy yy_1_2_1_2;
 yy yy_1_2_1_3;
 yy yy_1_2_2_1;
-yy yy_1_2_3_1;
 yy yyv_FTypeStr;
+yy yy_1_2_2_2;
+yy yy_1_2_3_1;
+yy yyv_ANameStr;
 yy yy_1_2_3_2;
 yy yy_1_2_4_1;
-yy yy_1_2_5_1;
-yy yy_1_2_6_1;
-yy yyv_ANameStr;
-yy yy_1_2_6_2;
-yy yy_1_2_7_1;
-yy yy_1_2_8_1;
+yy yy_1_2_4_2;
+yy yy_1_2_4_3;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 1) goto yyfl_28_1;
+if (yy_0_1[0] != 1) goto yyfl_29_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
@@ -1991,7 +2079,7 @@ yy_0_1_4 = ((yy)yy_0_1[4]);
 yyv_FMode = yy_0_1_1;
 yyv_FType = yy_0_1_2;
 yyv_FName = yy_0_1_3;
-if (yy_0_2[0] != 1) goto yyfl_28_1;
+if (yy_0_2[0] != 1) goto yyfl_29_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yyv_AName = yy_0_2_1;
@@ -1999,27 +2087,27 @@ yyv_Pos = yy_0_2_2;
 {
 yy yysb = yyb;
 yy_1_1_1_1 = yyv_AName;
-if (! defined_locally(yy_1_1_1_1, &yy_1_1_1_2, &yy_1_1_1_3)) goto yyfl_28_1_1_1;
+if (! defined_locally(yy_1_1_1_1, &yy_1_1_1_2, &yy_1_1_1_3)) goto yyfl_29_1_1_1;
 yyv_AMode = yy_1_1_1_2;
 yyv_AType = yy_1_1_1_3;
 {
 yy yysb = yyb;
 yy_1_1_2_1_1_1 = yyv_FType;
 yy_1_1_2_1_1_2 = yyv_AType;
-if (yyeq_IDENT(yy_1_1_2_1_1_1, yy_1_1_2_1_1_2)) goto yyfl_28_1_1_1_2_1;
+if (yyeq_IDENT(yy_1_1_2_1_1_1, yy_1_1_2_1_1_2)) goto yyfl_29_1_1_1_2_1;
 yy_1_1_2_1_2_1 = ((yy)"'");
 yy_1_1_2_1_2_2 = yyv_AName;
 yy_1_1_2_1_2_3 = ((yy)"' has inconsistent type");
 yy_1_1_2_1_2_4 = yyv_Pos;
 ErrorI(yy_1_1_2_1_2_1, yy_1_1_2_1_2_2, yy_1_1_2_1_2_3, yy_1_1_2_1_2_4);
-goto yysl_28_1_1_1_2;
-yyfl_28_1_1_1_2_1 : ;
-goto yysl_28_1_1_1_2;
-yysl_28_1_1_1_2 : ;
+goto yysl_29_1_1_1_2;
+yyfl_29_1_1_1_2_1 : ;
+goto yysl_29_1_1_1_2;
+yysl_29_1_1_1_2 : ;
 yyb = yysb;
 }
-goto yysl_28_1_1;
-yyfl_28_1_1_1 : ;
+goto yysl_29_1_1;
+yyfl_29_1_1_1 : ;
 yyb = yyh;
 yyh += 1; if (yyh > yyhx) yyExtend();
 yy_1_2_1_1 = yyb + 0;
@@ -2027,29 +2115,22 @@ yy_1_2_1_1[0] = 3;
 yy_1_2_1_2 = yyv_FType;
 yy_1_2_1_3 = yyv_AName;
 define_local_name(yy_1_2_1_1, yy_1_2_1_2, yy_1_2_1_3);
-yy_1_2_2_1 = ((yy)"   ");
-Put(yy_1_2_2_1);
-yy_1_2_3_1 = yyv_FType;
+yy_1_2_2_1 = yyv_FType;
+id_to_string(yy_1_2_2_1, &yy_1_2_2_2);
+yyv_FTypeStr = yy_1_2_2_2;
+yy_1_2_3_1 = yyv_AName;
 id_to_string(yy_1_2_3_1, &yy_1_2_3_2);
-yyv_FTypeStr = yy_1_2_3_2;
+yyv_ANameStr = yy_1_2_3_2;
 yy_1_2_4_1 = yyv_FTypeStr;
-Put(yy_1_2_4_1);
-yy_1_2_5_1 = ((yy)" ");
-Put(yy_1_2_5_1);
-yy_1_2_6_1 = yyv_AName;
-id_to_string(yy_1_2_6_1, &yy_1_2_6_2);
-yyv_ANameStr = yy_1_2_6_2;
-yy_1_2_7_1 = yyv_ANameStr;
-Put(yy_1_2_7_1);
-yy_1_2_8_1 = ((yy)";");
-Put(yy_1_2_8_1);
-Nl();
-goto yysl_28_1_1;
-yysl_28_1_1 : ;
+yy_1_2_4_2 = ((yy)"");
+yy_1_2_4_3 = yyv_ANameStr;
+PutLocalDecl(yy_1_2_4_1, yy_1_2_4_2, yy_1_2_4_3);
+goto yysl_29_1_1;
+yysl_29_1_1 : ;
 yyb = yysb;
 }
 return;
-yyfl_28_1 : ;
+yyfl_29_1 : ;
 }
 yyErr(2,522);
 }
@@ -2085,27 +2166,25 @@ yy yy_2_2_1_1;
 yy yy_2_2_1_2;
 yy yy_2_2_1_3;
 yy yy_2_2_2_1;
-yy yy_2_2_3_1;
 yy yyv_FTypeStr;
+yy yy_2_2_2_2;
+yy yy_2_2_3_1;
+yy yyv_ANameStr;
 yy yy_2_2_3_2;
 yy yy_2_2_4_1;
-yy yy_2_2_5_1;
-yy yy_2_2_6_1;
-yy yyv_ANameStr;
-yy yy_2_2_6_2;
-yy yy_2_2_7_1;
-yy yy_2_2_8_1;
+yy yy_2_2_4_2;
+yy yy_2_2_4_3;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_29_1;
+if (yy_0_1[0] != 1) goto yyfl_30_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
-if (yy_0_1_1[0] != 1) goto yyfl_29_1;
+if (yy_0_1_1[0] != 1) goto yyfl_30_1;
 yy_0_1_1_1 = ((yy)yy_0_1_1[1]);
 yy_0_1_1_2 = ((yy)yy_0_1_1[2]);
 yyv_AName = yy_0_1_1_1;
 yyv_Pos = yy_0_1_1_2;
-if (yy_0_1_2[0] != 2) goto yyfl_29_1;
+if (yy_0_1_2[0] != 2) goto yyfl_30_1;
 yy_0_1_2_1 = ((yy)yy_0_1_2[1]);
 yy_1_1 = ((yy)"YYSTYPE");
 string_to_id(yy_1_1, &yy_1_2);
@@ -2113,27 +2192,27 @@ yyv_FType = yy_1_2;
 {
 yy yysb = yyb;
 yy_2_1_1_1 = yyv_AName;
-if (! defined_locally(yy_2_1_1_1, &yy_2_1_1_2, &yy_2_1_1_3)) goto yyfl_29_1_2_1;
+if (! defined_locally(yy_2_1_1_1, &yy_2_1_1_2, &yy_2_1_1_3)) goto yyfl_30_1_2_1;
 yyv_AMode = yy_2_1_1_2;
 yyv_AType = yy_2_1_1_3;
 {
 yy yysb = yyb;
 yy_2_1_2_1_1_1 = yyv_FType;
 yy_2_1_2_1_1_2 = yyv_AType;
-if (yyeq_IDENT(yy_2_1_2_1_1_1, yy_2_1_2_1_1_2)) goto yyfl_29_1_2_1_2_1;
+if (yyeq_IDENT(yy_2_1_2_1_1_1, yy_2_1_2_1_1_2)) goto yyfl_30_1_2_1_2_1;
 yy_2_1_2_1_2_1 = ((yy)"'");
 yy_2_1_2_1_2_2 = yyv_AName;
 yy_2_1_2_1_2_3 = ((yy)"' has inconsistent type");
 yy_2_1_2_1_2_4 = yyv_Pos;
 ErrorI(yy_2_1_2_1_2_1, yy_2_1_2_1_2_2, yy_2_1_2_1_2_3, yy_2_1_2_1_2_4);
-goto yysl_29_1_2_1_2;
-yyfl_29_1_2_1_2_1 : ;
-goto yysl_29_1_2_1_2;
-yysl_29_1_2_1_2 : ;
+goto yysl_30_1_2_1_2;
+yyfl_30_1_2_1_2_1 : ;
+goto yysl_30_1_2_1_2;
+yysl_30_1_2_1_2 : ;
 yyb = yysb;
 }
-goto yysl_29_1_2;
-yyfl_29_1_2_1 : ;
+goto yysl_30_1_2;
+yyfl_30_1_2_1 : ;
 yyb = yyh;
 yyh += 1; if (yyh > yyhx) yyExtend();
 yy_2_2_1_1 = yyb + 0;
@@ -2141,37 +2220,30 @@ yy_2_2_1_1[0] = 3;
 yy_2_2_1_2 = yyv_FType;
 yy_2_2_1_3 = yyv_AName;
 define_local_name(yy_2_2_1_1, yy_2_2_1_2, yy_2_2_1_3);
-yy_2_2_2_1 = ((yy)"   ");
-Put(yy_2_2_2_1);
-yy_2_2_3_1 = yyv_FType;
+yy_2_2_2_1 = yyv_FType;
+id_to_string(yy_2_2_2_1, &yy_2_2_2_2);
+yyv_FTypeStr = yy_2_2_2_2;
+yy_2_2_3_1 = yyv_AName;
 id_to_string(yy_2_2_3_1, &yy_2_2_3_2);
-yyv_FTypeStr = yy_2_2_3_2;
+yyv_ANameStr = yy_2_2_3_2;
 yy_2_2_4_1 = yyv_FTypeStr;
-Put(yy_2_2_4_1);
-yy_2_2_5_1 = ((yy)" ");
-Put(yy_2_2_5_1);
-yy_2_2_6_1 = yyv_AName;
-id_to_string(yy_2_2_6_1, &yy_2_2_6_2);
-yyv_ANameStr = yy_2_2_6_2;
-yy_2_2_7_1 = yyv_ANameStr;
-Put(yy_2_2_7_1);
-yy_2_2_8_1 = ((yy)";");
-Put(yy_2_2_8_1);
-Nl();
-goto yysl_29_1_2;
-yysl_29_1_2 : ;
+yy_2_2_4_2 = ((yy)"");
+yy_2_2_4_3 = yyv_ANameStr;
+PutLocalDecl(yy_2_2_4_1, yy_2_2_4_2, yy_2_2_4_3);
+goto yysl_30_1_2;
+yysl_30_1_2 : ;
 yyb = yysb;
 }
 return;
-yyfl_29_1 : ;
+yyfl_30_1 : ;
 }
 {
 yy yyb;
 yy yy_0_1;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 2) goto yyfl_29_2;
+if (yy_0_1[0] != 2) goto yyfl_30_2;
 return;
-yyfl_29_2 : ;
+yyfl_30_2 : ;
 }
 {
 yy yyb;
@@ -2194,20 +2266,20 @@ yy yy_0_1_3;
 yy yy_1_1;
 yy yy_1_2;
 yy_0_1 = yyin_1;
-if (yy_0_1[0] != 1) goto yyfl_29_3;
+if (yy_0_1[0] != 1) goto yyfl_30_3;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
 yy_0_1_3 = ((yy)yy_0_1[3]);
-if (yy_0_1_1[0] != 1) goto yyfl_29_3;
+if (yy_0_1_1[0] != 1) goto yyfl_30_3;
 yy_0_1_1_1 = ((yy)yy_0_1_1[1]);
 yy_0_1_1_2 = ((yy)yy_0_1_1[2]);
 yyv_Name = yy_0_1_1_1;
 yyv_Pos = yy_0_1_1_2;
-if (yy_0_1_2[0] != 1) goto yyfl_29_3;
+if (yy_0_1_2[0] != 1) goto yyfl_30_3;
 yy_0_1_2_1 = ((yy)yy_0_1_2[1]);
 yy_0_1_2_2 = ((yy)yy_0_1_2[2]);
 yy_0_1_2_3 = ((yy)yy_0_1_2[3]);
-if (yy_0_1_2_1[0] != 1) goto yyfl_29_3;
+if (yy_0_1_2_1[0] != 1) goto yyfl_30_3;
 yy_0_1_2_1_1 = ((yy)yy_0_1_2_1[1]);
 yy_0_1_2_1_2 = ((yy)yy_0_1_2_1[2]);
 yyv_Name2 = yy_0_1_2_1_1;
@@ -2217,7 +2289,7 @@ yy_1_1 = ((yy)"Too many parameters for token");
 yy_1_2 = yyv_Pos;
 Error(yy_1_1, yy_1_2);
 return;
-yyfl_29_3 : ;
+yyfl_30_3 : ;
 }
 yyErr(2,544);
 }
@@ -2296,7 +2368,7 @@ if (yy_1 == (yy) yyu) yyErr(1,585);
 yyv_L = yy_1;
 yy_2_1 = yyv_L;
 yy_2_2 = yyv_Name;
-if (! defined_locally_h(yy_2_1, yy_2_2, &yy_2_3, &yy_2_4)) goto yyfl_34_1;
+if (! defined_locally_h(yy_2_1, yy_2_2, &yy_2_3, &yy_2_4)) goto yyfl_35_1;
 yyv_Mode = yy_2_3;
 yyv_Type = yy_2_4;
 yy_0_2 = yyv_Mode;
@@ -2304,7 +2376,7 @@ yy_0_3 = yyv_Type;
 *yyout_1 = yy_0_2;
 *yyout_2 = yy_0_3;
 return 1;
-yyfl_34_1 : ;
+yyfl_35_1 : ;
 }
 return 0;
 }
@@ -2344,10 +2416,10 @@ yy yy_1_2_1_3;
 yy yy_1_2_1_4;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
-if (yy_0_1[0] != 1) goto yyfl_35_1;
+if (yy_0_1[0] != 1) goto yyfl_36_1;
 yy_0_1_1 = ((yy)yy_0_1[1]);
 yy_0_1_2 = ((yy)yy_0_1[2]);
-if (yy_0_1_1[0] != 1) goto yyfl_35_1;
+if (yy_0_1_1[0] != 1) goto yyfl_36_1;
 yy_0_1_1_1 = ((yy)yy_0_1_1[1]);
 yy_0_1_1_2 = ((yy)yy_0_1_1[2]);
 yy_0_1_1_3 = ((yy)yy_0_1_1[3]);
@@ -2360,24 +2432,24 @@ yyv_Name = yy_0_2;
 yy yysb = yyb;
 yy_1_1_1_1 = yyv_N;
 yy_1_1_1_2 = yyv_Name;
-if (! yyeq_IDENT(yy_1_1_1_1, yy_1_1_1_2)) goto yyfl_35_1_1_1;
+if (! yyeq_IDENT(yy_1_1_1_1, yy_1_1_1_2)) goto yyfl_36_1_1_1;
 yy_1_1_2_1 = yyv_M;
 yy_1_1_2_2 = yy_1_1_2_1;
 yyv_Mode = yy_1_1_2_2;
 yy_1_1_3_1 = yyv_T;
 yy_1_1_3_2 = yy_1_1_3_1;
 yyv_Type = yy_1_1_3_2;
-goto yysl_35_1_1;
-yyfl_35_1_1_1 : ;
+goto yysl_36_1_1;
+yyfl_36_1_1_1 : ;
 yy_1_2_1_1 = yyv_Tail;
 yy_1_2_1_2 = yyv_Name;
-if (! defined_locally_h(yy_1_2_1_1, yy_1_2_1_2, &yy_1_2_1_3, &yy_1_2_1_4)) goto yyfl_35_1_1_2;
+if (! defined_locally_h(yy_1_2_1_1, yy_1_2_1_2, &yy_1_2_1_3, &yy_1_2_1_4)) goto yyfl_36_1_1_2;
 yyv_Mode = yy_1_2_1_3;
 yyv_Type = yy_1_2_1_4;
-goto yysl_35_1_1;
-yyfl_35_1_1_2 : ;
-goto yyfl_35_1;
-yysl_35_1_1 : ;
+goto yysl_36_1_1;
+yyfl_36_1_1_2 : ;
+goto yyfl_36_1;
+yysl_36_1_1 : ;
 yyb = yysb;
 }
 yy_0_3 = yyv_Mode;
@@ -2385,7 +2457,7 @@ yy_0_4 = yyv_Type;
 *yyout_1 = yy_0_3;
 *yyout_2 = yy_0_4;
 return 1;
-yyfl_35_1 : ;
+yyfl_36_1 : ;
 }
 return 0;
 }
@@ -2407,70 +2479,74 @@ yy yyv_Str2;
 yy yy_0_3;
 yy yy_1_1;
 yy yy_2_1;
-yy yyv_N1;
-yy yy_2_2;
 yy yy_3_1;
-yy yyv_Name;
+yy yyv_N1;
+yy yy_3_2;
 yy yy_4_1;
+yy yyv_Name;
 yy yy_5_1;
 yy yy_6_1;
 yy yy_7_1;
-yy yy_9_1;
+yy yy_8_1;
 yy yy_10_1;
 yy yy_11_1;
+yy yy_12_1;
 yy yyv_N2;
-yy yy_13_1;
 yy yy_14_1;
 yy yy_15_1;
-yy yy_15_1_1;
-yy yy_15_1_2;
 yy yy_16_1;
+yy yy_16_1_1;
+yy yy_16_1_2;
+yy yy_17_1;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
 yy_0_3 = yyin_3;
 yyv_Str1 = yy_0_1;
-if (yy_0_2[0] != 1) goto yyfl_36_1;
+if (yy_0_2[0] != 1) goto yyfl_37_1;
 yy_0_2_1 = ((yy)yy_0_2[1]);
 yy_0_2_2 = ((yy)yy_0_2[2]);
 yyv_BlkTxt = yy_0_2_1;
 yyv_BlkPos = yy_0_2_2;
 yyv_Str2 = yy_0_3;
-yy_1_1 = ((yy)"#line ");
-Put(yy_1_1);
-yy_2_1 = yyv_BlkPos;
-POS_to_LineNumber(yy_2_1, &yy_2_2);
-yyv_N1 = yy_2_2;
-yy_3_1 = yyv_N1;
-PutI(yy_3_1);
-GetSourceFileName(&yy_4_1);
-yyv_Name = yy_4_1;
-yy_5_1 = ((yy)" \"");
-Put(yy_5_1);
-yy_6_1 = yyv_Name;
+yy_1_1 = yyv_BlkTxt;
+PutFrameIn(yy_1_1);
+yy_2_1 = ((yy)"#line ");
+Put(yy_2_1);
+yy_3_1 = yyv_BlkPos;
+POS_to_LineNumber(yy_3_1, &yy_3_2);
+yyv_N1 = yy_3_2;
+yy_4_1 = yyv_N1;
+PutI(yy_4_1);
+GetSourceFileName(&yy_5_1);
+yyv_Name = yy_5_1;
+yy_6_1 = ((yy)" \"");
 Put(yy_6_1);
-yy_7_1 = ((yy)"\"");
+yy_7_1 = yyv_Name;
 Put(yy_7_1);
+yy_8_1 = ((yy)"\"");
+Put(yy_8_1);
 Nl();
-yy_9_1 = yyv_Str1;
-Put(yy_9_1);
-yy_10_1 = yyv_BlkTxt;
-PutBlockText(yy_10_1);
-yy_11_1 = yyv_Str2;
-Put(yy_11_1);
+yy_10_1 = yyv_Str1;
+Put(yy_10_1);
+yy_11_1 = yyv_BlkTxt;
+PutActionText(yy_11_1);
+yy_12_1 = yyv_Str2;
+Put(yy_12_1);
 Nl();
-GetOutputLineCount(&yy_13_1);
-yyv_N2 = yy_13_1;
-yy_14_1 = ((yy)"# line ");
-Put(yy_14_1);
-yy_15_1_1 = yyv_N2;
-yy_15_1_2 = ((yy)2);
-yy_15_1 = (yy)(((long)yy_15_1_1)+((long)yy_15_1_2));
-PutI(yy_15_1);
-yy_16_1 = ((yy)" \"yygrammar.c\"");
-Put(yy_16_1);
+GetOutputLineCount(&yy_14_1);
+yyv_N2 = yy_14_1;
+yy_15_1 = ((yy)"# line ");
+Put(yy_15_1);
+yy_16_1_1 = yyv_N2;
+yy_16_1_2 = ((yy)2);
+yy_16_1 = (yy)(((long)yy_16_1_1)+((long)yy_16_1_2));
+PutI(yy_16_1);
+yy_17_1 = ((yy)" \"yygrammar.c\"");
+Put(yy_17_1);
 Nl();
+PutFrameOut();
 return;
-yyfl_36_1 : ;
+yyfl_37_1 : ;
 }
 {
 yy yyb;
@@ -2480,9 +2556,1309 @@ yy yy_0_3;
 yy_0_1 = yyin_1;
 yy_0_2 = yyin_2;
 yy_0_3 = yyin_3;
-if (yy_0_2[0] != 2) goto yyfl_36_2;
+if (yy_0_2[0] != 2) goto yyfl_37_2;
 return;
-yyfl_36_2 : ;
+yyfl_37_2 : ;
 }
 yyErr(2,600);
 }
+put_parallel_struct(yyin_1, yyin_2)
+yy yyin_1;
+yy yyin_2;
+{
+{
+yy yyb;
+yy yyv_Str;
+yy yy_0_1;
+yy yyv_FP;
+yy yy_0_2;
+yy yy_1_1;
+yy yy_2_1;
+yy yy_3_1;
+yy yy_4_1;
+yy yy_6_1;
+yy yy_7_1_1_1;
+yy yy_7_1_1_2;
+yy yy_7_1_2_1;
+yy yy_8_1;
+yy yy_10_1;
+yy yy_12_1;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yyv_Str = yy_0_1;
+yyv_FP = yy_0_2;
+yy_1_1 = yyv_Str;
+if (! IsParallelNonterm(yy_1_1)) goto yyfl_38_1;
+yy_2_1 = ((yy)"struct yyres_");
+Put(yy_2_1);
+yy_3_1 = yyv_Str;
+Put(yy_3_1);
+yy_4_1 = ((yy)" {");
+Put(yy_4_1);
+Nl();
+yy_6_1 = yyv_FP;
+put_parallel_fields(yy_6_1);
+{
+yy yysb = yyb;
+yy_7_1_1_1 = yyv_FP;
+yy_7_1_1_2 = yy_7_1_1_1;
+if (yy_7_1_1_2[0] != 2) goto yyfl_38_1_7_1;
+yy_7_1_2_1 = ((yy)"   int yyunused;");
+Put(yy_7_1_2_1);
+Nl();
+goto yysl_38_1_7;
+yyfl_38_1_7_1 : ;
+goto yysl_38_1_7;
+yysl_38_1_7 : ;
+yyb = yysb;
+}
+yy_8_1 = ((yy)"};");
+Put(yy_8_1);
+Nl();
+yy_10_1 = ((yy)"extern void *yyparallel_result();");
+Put(yy_10_1);
+Nl();
+yy_12_1 = ((yy)"extern int yyparallel_worker();");
+Put(yy_12_1);
+Nl();
+Nl();
+return;
+yyfl_38_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_2;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+return;
+yyfl_38_2 : ;
+}
+yyErr(2,640);
+}
+put_parallel_fields(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_1_1;
+yy yyv_Mode;
+yy yy_0_1_1_1;
+yy yyv_Type;
+yy yy_0_1_1_2;
+yy yyv_Name;
+yy yy_0_1_1_3;
+yy yyv_Pos;
+yy yy_0_1_1_4;
+yy yyv_T;
+yy yy_0_1_2;
+yy yy_1_1_1_1;
+yy yy_1_1_1_2;
+yy yy_1_1_2_1;
+yy yy_1_1_2_2;
+yy yy_1_1_2_3;
+yy yy_1_1_2_4;
+yy yy_2_1;
+yy yyv_TStr;
+yy yy_2_2;
+yy yy_3_1;
+yy yyv_NStr;
+yy yy_3_2;
+yy yy_4_1;
+yy yy_5_1;
+yy yy_6_1;
+yy yy_7_1;
+yy yy_8_1;
+yy yy_10_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_39_1;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+if (yy_0_1_1[0] != 1) goto yyfl_39_1;
+yy_0_1_1_1 = ((yy)yy_0_1_1[1]);
+yy_0_1_1_2 = ((yy)yy_0_1_1[2]);
+yy_0_1_1_3 = ((yy)yy_0_1_1[3]);
+yy_0_1_1_4 = ((yy)yy_0_1_1[4]);
+yyv_Mode = yy_0_1_1_1;
+yyv_Type = yy_0_1_1_2;
+yyv_Name = yy_0_1_1_3;
+yyv_Pos = yy_0_1_1_4;
+yyv_T = yy_0_1_2;
+{
+yy yysb = yyb;
+yy_1_1_1_1 = yyv_Mode;
+yy_1_1_1_2 = yy_1_1_1_1;
+if (yy_1_1_1_2[0] != 1) goto yyfl_39_1_1_1;
+yy_1_1_2_1 = ((yy)"parameter '");
+yy_1_1_2_2 = yyv_Name;
+yy_1_1_2_3 = ((yy)"' of a parallel nonterminal must be an output parameter");
+yy_1_1_2_4 = yyv_Pos;
+ErrorI(yy_1_1_2_1, yy_1_1_2_2, yy_1_1_2_3, yy_1_1_2_4);
+goto yysl_39_1_1;
+yyfl_39_1_1_1 : ;
+goto yysl_39_1_1;
+yysl_39_1_1 : ;
+yyb = yysb;
+}
+yy_2_1 = yyv_Type;
+id_to_string(yy_2_1, &yy_2_2);
+yyv_TStr = yy_2_2;
+yy_3_1 = yyv_Name;
+id_to_string(yy_3_1, &yy_3_2);
+yyv_NStr = yy_3_2;
+yy_4_1 = ((yy)"   ");
+Put(yy_4_1);
+yy_5_1 = yyv_TStr;
+Put(yy_5_1);
+yy_6_1 = ((yy)" ");
+Put(yy_6_1);
+yy_7_1 = yyv_NStr;
+Put(yy_7_1);
+yy_8_1 = ((yy)";");
+Put(yy_8_1);
+Nl();
+yy_10_1 = yyv_T;
+put_parallel_fields(yy_10_1);
+return;
+yyfl_39_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 2) goto yyfl_39_2;
+return;
+yyfl_39_2 : ;
+}
+yyErr(2,656);
+}
+put_parallel_prologue(yyin_1, yyin_2)
+yy yyin_1;
+yy yyin_2;
+{
+{
+yy yyb;
+yy yyv_Str;
+yy yy_0_1;
+yy yyv_FP;
+yy yy_0_2;
+yy yy_1_1;
+yy yy_3_1;
+yy yy_4_1;
+yy yy_5_1;
+yy yy_8_1;
+yy yy_9_1;
+yy yy_10_1;
+yy yy_12_1;
+yy yy_14_1;
+yy yy_17_1;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yyv_Str = yy_0_1;
+yyv_FP = yy_0_2;
+yy_1_1 = yyv_Str;
+if (! IsParallelNonterm(yy_1_1)) goto yyfl_40_1;
+indent();
+yy_3_1 = ((yy)"struct yyres_");
+Put(yy_3_1);
+yy_4_1 = yyv_Str;
+Put(yy_4_1);
+yy_5_1 = ((yy)" *yyres;");
+Put(yy_5_1);
+Nl();
+indent();
+yy_8_1 = ((yy)"if ((yyres = (struct yyres_");
+Put(yy_8_1);
+yy_9_1 = yyv_Str;
+Put(yy_9_1);
+yy_10_1 = ((yy)" *) yyparallel_result()) != 0) {");
+Put(yy_10_1);
+Nl();
+yy_12_1 = yyv_FP;
+put_parallel_copies(yy_12_1);
+indent();
+yy_14_1 = ((yy)"   return;");
+Put(yy_14_1);
+Nl();
+indent();
+yy_17_1 = ((yy)"}");
+Put(yy_17_1);
+Nl();
+return;
+yyfl_40_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_2;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+return;
+yyfl_40_2 : ;
+}
+yyErr(2,677);
+}
+put_parallel_copies(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_1_1;
+yy yy_0_1_1_1;
+yy yy_0_1_1_2;
+yy yyv_Name;
+yy yy_0_1_1_3;
+yy yy_0_1_1_4;
+yy yyv_T;
+yy yy_0_1_2;
+yy yy_1_1;
+yy yyv_NStr;
+yy yy_1_2;
+yy yy_3_1;
+yy yy_4_1;
+yy yy_5_1;
+yy yy_6_1;
+yy yy_7_1;
+yy yy_9_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_41_1;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+if (yy_0_1_1[0] != 1) goto yyfl_41_1;
+yy_0_1_1_1 = ((yy)yy_0_1_1[1]);
+yy_0_1_1_2 = ((yy)yy_0_1_1[2]);
+yy_0_1_1_3 = ((yy)yy_0_1_1[3]);
+yy_0_1_1_4 = ((yy)yy_0_1_1[4]);
+yyv_Name = yy_0_1_1_3;
+yyv_T = yy_0_1_2;
+yy_1_1 = yyv_Name;
+id_to_string(yy_1_1, &yy_1_2);
+yyv_NStr = yy_1_2;
+indent();
+yy_3_1 = ((yy)"   *");
+Put(yy_3_1);
+yy_4_1 = yyv_NStr;
+Put(yy_4_1);
+yy_5_1 = ((yy)" = yyres->");
+Put(yy_5_1);
+yy_6_1 = yyv_NStr;
+Put(yy_6_1);
+yy_7_1 = ((yy)";");
+Put(yy_7_1);
+Nl();
+yy_9_1 = yyv_T;
+put_parallel_copies(yy_9_1);
+return;
+yyfl_41_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 2) goto yyfl_41_2;
+return;
+yyfl_41_2 : ;
+}
+yyErr(2,689);
+}
+put_parallel_walk(yyin_1, yyin_2, yyin_3)
+yy yyin_1;
+yy yyin_2;
+yy yyin_3;
+{
+{
+yy yyb;
+yy yyv_Str;
+yy yy_0_1;
+yy yyv_FP;
+yy yy_0_2;
+yy yyv_Clauses;
+yy yy_0_3;
+yy yy_1_1;
+yy yy_3_1;
+yy yy_5_1;
+yy yy_7_1;
+yy yy_9_1;
+yy yy_10_1;
+yy yy_11_1;
+yy yy_12_1;
+yy yy_13_1;
+yy yy_15_1;
+yy yy_16_1;
+yy yy_17_1;
+yy yy_18_1;
+yy yy_19_1;
+yy yy_21_1;
+yy yy_24_1;
+yy yy_25_1;
+yy yy_26_1;
+yy yy_28_1;
+yy yy_30_1;
+yy yy_31_1;
+yy yy_33_1;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yy_0_3 = yyin_3;
+yyv_Str = yy_0_1;
+yyv_FP = yy_0_2;
+yyv_Clauses = yy_0_3;
+yy_1_1 = yyv_Str;
+if (! IsParallelNonterm(yy_1_1)) goto yyfl_42_1;
+Nl();
+yy_3_1 = ((yy)"void yyparallel_walk (res)");
+Put(yy_3_1);
+Nl();
+yy_5_1 = ((yy)"   void *res;");
+Put(yy_5_1);
+Nl();
+yy_7_1 = ((yy)"{");
+Put(yy_7_1);
+Nl();
+yy_9_1 = ((yy)"   struct yyres_");
+Put(yy_9_1);
+yy_10_1 = yyv_Str;
+Put(yy_10_1);
+yy_11_1 = ((yy)" *yyres = (struct yyres_");
+Put(yy_11_1);
+yy_12_1 = yyv_Str;
+Put(yy_12_1);
+yy_13_1 = ((yy)" *) res;");
+Put(yy_13_1);
+Nl();
+yy_15_1 = ((yy)"   ");
+Put(yy_15_1);
+yy_16_1 = yyv_Str;
+Put(yy_16_1);
+yy_17_1 = ((yy)"(");
+Put(yy_17_1);
+yy_18_1 = yyv_FP;
+put_parallel_args(yy_18_1);
+yy_19_1 = ((yy)");");
+Put(yy_19_1);
+Nl();
+yy_21_1 = ((yy)"}");
+Put(yy_21_1);
+Nl();
+Nl();
+yy_24_1 = ((yy)"int yyparallel_width = sizeof(struct yyres_");
+Put(yy_24_1);
+yy_25_1 = yyv_Str;
+Put(yy_25_1);
+yy_26_1 = ((yy)");");
+Put(yy_26_1);
+Nl();
+yy_28_1 = ((yy)"int yyparallel_rules[] = {");
+Put(yy_28_1);
+Nl();
+yy_30_1 = yyv_Clauses;
+put_parallel_rules(yy_30_1);
+yy_31_1 = ((yy)"0");
+Put(yy_31_1);
+Nl();
+yy_33_1 = ((yy)"};");
+Put(yy_33_1);
+Nl();
+return;
+yyfl_42_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_2;
+yy yy_0_3;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yy_0_3 = yyin_3;
+return;
+yyfl_42_2 : ;
+}
+yyErr(2,723);
+}
+put_parallel_args(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_1_1;
+yy yy_0_1_1_1;
+yy yy_0_1_1_2;
+yy yyv_Name;
+yy yy_0_1_1_3;
+yy yy_0_1_1_4;
+yy yyv_T;
+yy yy_0_1_2;
+yy yy_1_1;
+yy yyv_NStr;
+yy yy_1_2;
+yy yy_2_1;
+yy yy_3_1;
+yy yy_4_1_1_1;
+yy yy_4_1_1_2;
+yy yy_4_1_2_1;
+yy yy_5_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_43_1;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+if (yy_0_1_1[0] != 1) goto yyfl_43_1;
+yy_0_1_1_1 = ((yy)yy_0_1_1[1]);
+yy_0_1_1_2 = ((yy)yy_0_1_1[2]);
+yy_0_1_1_3 = ((yy)yy_0_1_1[3]);
+yy_0_1_1_4 = ((yy)yy_0_1_1[4]);
+yyv_Name = yy_0_1_1_3;
+yyv_T = yy_0_1_2;
+yy_1_1 = yyv_Name;
+id_to_string(yy_1_1, &yy_1_2);
+yyv_NStr = yy_1_2;
+yy_2_1 = ((yy)"&yyres->");
+Put(yy_2_1);
+yy_3_1 = yyv_NStr;
+Put(yy_3_1);
+{
+yy yysb = yyb;
+yy_4_1_1_1 = yyv_T;
+yy_4_1_1_2 = yy_4_1_1_1;
+if (yy_4_1_1_2[0] != 1) goto yyfl_43_1_4_1;
+yy_4_1_2_1 = ((yy)", ");
+Put(yy_4_1_2_1);
+goto yysl_43_1_4;
+yyfl_43_1_4_1 : ;
+goto yysl_43_1_4;
+yysl_43_1_4 : ;
+yyb = yysb;
+}
+yy_5_1 = yyv_T;
+put_parallel_args(yy_5_1);
+return;
+yyfl_43_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 2) goto yyfl_43_2;
+return;
+yyfl_43_2 : ;
+}
+yyErr(2,731);
+}
+put_parallel_rules(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Keys;
+yy yy_0_1_1;
+yy yyv_Key;
+yy yy_0_1_2;
+yy yy_1_1;
+yy yy_2;
+yy yyv_N;
+yy yy_3_1;
+yy yy_4_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_44_1;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+yyv_Keys = yy_0_1_1;
+yyv_Key = yy_0_1_2;
+yy_1_1 = yyv_Keys;
+put_parallel_rules(yy_1_1);
+yy_2 = (yy) yyv_Key[7];
+if (yy_2 == (yy) yyu) yyErr(1,751);
+yyv_N = yy_2;
+yy_3_1 = yyv_N;
+PutI(yy_3_1);
+yy_4_1 = ((yy)", ");
+Put(yy_4_1);
+return;
+yyfl_44_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 2) goto yyfl_44_2;
+return;
+yyfl_44_2 : ;
+}
+yyErr(2,739);
+}
+put_ast_header()
+{
+{
+yy yyb;
+yy yy_2_1;
+yy yy_3_1;
+yy yy_5_1;
+yy yy_7;
+yy yyv_Keys;
+yy yy_8_1;
+if (! AstMode()) goto yyfl_45_1;
+yy_2_1 = ((yy)"yyast.h");
+OpenOutput(yy_2_1);
+yy_3_1 = ((yy)"#include \"yygrammar.h\"");
+Put(yy_3_1);
+Nl();
+yy_5_1 = ((yy)"#define yyast_lexval(m) (*(YYSTYPE *) (m)->lexval)");
+Put(yy_5_1);
+Nl();
+yy_7 = yyglov_LHS_List;
+if (yy_7 == (yy) yyu) yyErr(1,779);
+yyv_Keys = yy_7;
+yy_8_1 = yyv_Keys;
+put_ast_LHSKEYS(yy_8_1);
+CloseOutput();
+return;
+yyfl_45_1 : ;
+}
+{
+yy yyb;
+return;
+}
+}
+put_ast_LHSKEYS(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Keys;
+yy yy_0_1_1;
+yy yyv_Key;
+yy yy_0_1_2;
+yy yy_1_1;
+yy yy_2_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_46_1;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+yyv_Keys = yy_0_1_1;
+yyv_Key = yy_0_1_2;
+yy_1_1 = yyv_Keys;
+put_ast_LHSKEYS(yy_1_1);
+yy_2_1 = yyv_Key;
+put_ast_LHSKEY(yy_2_1);
+return;
+yyfl_46_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 2) goto yyfl_46_2;
+return;
+yyfl_46_2 : ;
+}
+yyErr(2,783);
+}
+put_ast_LHSKEY(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yyv_Key;
+yy yy_0_1;
+yy yyv_Lhs;
+yy yy_1;
+yy yy_2_1;
+yy yy_2_2;
+yy yyv_Id;
+yy yy_2_2_1;
+yy yy_3_1;
+yy yyv_Str;
+yy yy_3_2;
+yy yyv_Pos;
+yy yy_4;
+yy yy_6_1;
+yy yy_7_1;
+yy yy_8_1;
+yy yy_9_1;
+yy yy_11;
+yy yyv_Clauses;
+yy yy_12_1;
+yy yy_12_2;
+yy yy_12_3;
+yy_0_1 = yyin_1;
+yyv_Key = yy_0_1;
+yy_1 = (yy) yyv_Key[1];
+if (yy_1 == (yy) yyu) yyErr(1,791);
+yyv_Lhs = yy_1;
+yy_2_1 = yyv_Lhs;
+yy_2_2 = yy_2_1;
+if (yy_2_2[0] != 1) goto yyfl_47_1;
+yy_2_2_1 = ((yy)yy_2_2[1]);
+yyv_Id = yy_2_2_1;
+yy_3_1 = yyv_Id;
+id_to_string(yy_3_1, &yy_3_2);
+yyv_Str = yy_3_2;
+yy_4 = (yy) yyv_Key[4];
+if (yy_4 == (yy) yyu) yyErr(1,794);
+yyv_Pos = yy_4;
+Nl();
+yy_6_1 = ((yy)"#define yynonterm_");
+Put(yy_6_1);
+yy_7_1 = yyv_Str;
+Put(yy_7_1);
+yy_8_1 = ((yy)" ");
+Put(yy_8_1);
+yy_9_1 = yyv_Pos;
+PutI(yy_9_1);
+Nl();
+yy_11 = (yy) yyv_Key[3];
+if (yy_11 == (yy) yyu) yyErr(1,801);
+yyv_Clauses = yy_11;
+yy_12_1 = yyv_Str;
+yy_12_2 = yyv_Clauses;
+put_ast_clauses(yy_12_1, yy_12_2, &yy_12_3);
+return;
+yyfl_47_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+return;
+}
+}
+put_ast_clauses(yyin_1, yyin_2, yyout_1)
+yy yyin_1;
+yy yyin_2;
+yy *yyout_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Str;
+yy yy_0_2;
+yy yyv_Keys;
+yy yy_0_2_1;
+yy yyv_Key;
+yy yy_0_2_2;
+yy yy_0_3;
+yy yy_0_3_1;
+yy yy_0_3_2;
+yy yy_1_1;
+yy yy_1_2;
+yy yy_1_3;
+yy yyv_N;
+yy yy_2;
+yy yyv_Rule;
+yy yy_3_1;
+yy yy_4_1;
+yy yy_5_1;
+yy yy_6_1;
+yy yy_6_1_1;
+yy yy_6_1_2;
+yy yy_7_1;
+yy yy_8_1;
+yy yy_10;
+yy yyv_Elems;
+yy yy_11_1;
+yy yy_11_1_1;
+yy yy_11_1_2;
+yy yy_11_2;
+yy yy_12_1;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yyv_Str = yy_0_1;
+if (yy_0_2[0] != 1) goto yyfl_48_1;
+yy_0_2_1 = ((yy)yy_0_2[1]);
+yy_0_2_2 = ((yy)yy_0_2[2]);
+yyv_Keys = yy_0_2_1;
+yyv_Key = yy_0_2_2;
+yy_1_1 = yyv_Str;
+yy_1_2 = yyv_Keys;
+put_ast_clauses(yy_1_1, yy_1_2, &yy_1_3);
+yyv_N = yy_1_3;
+yy_2 = (yy) yyv_Key[7];
+if (yy_2 == (yy) yyu) yyErr(1,808);
+yyv_Rule = yy_2;
+yy_3_1 = ((yy)"#define yyrule_");
+Put(yy_3_1);
+yy_4_1 = yyv_Str;
+Put(yy_4_1);
+yy_5_1 = ((yy)"_");
+Put(yy_5_1);
+yy_6_1_1 = yyv_N;
+yy_6_1_2 = ((yy)1);
+yy_6_1 = (yy)(((long)yy_6_1_1)+((long)yy_6_1_2));
+PutI(yy_6_1);
+yy_7_1 = ((yy)" ");
+Put(yy_7_1);
+yy_8_1 = yyv_Rule;
+PutI(yy_8_1);
+Nl();
+yy_10 = (yy) yyv_Key[1];
+if (yy_10 == (yy) yyu) yyErr(1,956);
+yyv_Elems = yy_10;
+yy_11_1 = yyv_Str;
+yy_11_1_1 = yyv_N;
+yy_11_1_2 = ((yy)1);
+yy_11_2 = (yy)(((long)yy_11_1_1)+((long)yy_11_1_2));
+StartAstMembers(yy_11_1, yy_11_2);
+yy_12_1 = yyv_Elems;
+put_ast_members(yy_12_1);
+yy_0_3_1 = yyv_N;
+yy_0_3_2 = ((yy)1);
+yy_0_3 = (yy)(((long)yy_0_3_1)+((long)yy_0_3_2));
+*yyout_1 = yy_0_3;
+return;
+yyfl_48_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_2;
+yy yy_0_3;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+if (yy_0_2[0] != 2) goto yyfl_48_2;
+yy_0_3 = ((yy)0);
+*yyout_1 = yy_0_3;
+return;
+yyfl_48_2 : ;
+}
+yyErr(2,805);
+}
+put_ast_members(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Elems;
+yy yy_0_1_1;
+yy yy_0_1_2;
+yy yyv_Id;
+yy yy_0_1_2_1;
+yy yy_0_1_2_2;
+yy yy_0_1_2_3;
+yy yy_1_1;
+yy yy_2_1;
+yy yyv_Name;
+yy yy_2_2;
+yy yy_3_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_49_1;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+if (yy_0_1_2[0] != 1) goto yyfl_49_1;
+yy_0_1_2_1 = ((yy)yy_0_1_2[1]);
+yy_0_1_2_2 = ((yy)yy_0_1_2[2]);
+yy_0_1_2_3 = ((yy)yy_0_1_2[3]);
+yyv_Id = yy_0_1_2_1;
+yyv_Elems = yy_0_1_1;
+yy_1_1 = yyv_Elems;
+put_ast_members(yy_1_1);
+yy_2_1 = yyv_Id;
+id_to_string(yy_2_1, &yy_2_2);
+yyv_Name = yy_2_2;
+yy_3_1 = yyv_Name;
+PutAstMember(yy_3_1);
+return;
+yyfl_49_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Elems;
+yy yy_0_1_1;
+yy yy_0_1_2;
+yy yy_0_1_2_1;
+yy yy_1_1;
+yy yy_2_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_49_2;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+if (yy_0_1_2[0] != 2) goto yyfl_49_2;
+yy_0_1_2_1 = ((yy)yy_0_1_2[1]);
+yyv_Elems = yy_0_1_1;
+yy_1_1 = yyv_Elems;
+put_ast_members(yy_1_1);
+yy_2_1 = ((yy)"");
+PutAstMember(yy_2_1);
+return;
+yyfl_49_2 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Elems;
+yy yy_0_1_1;
+yy yy_0_1_2;
+yy yy_0_1_2_1;
+yy yy_0_1_2_2;
+yy yy_0_1_2_3;
+yy yy_1_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_49_3;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+if (yy_0_1_2[0] != 3) goto yyfl_49_3;
+yy_0_1_2_1 = ((yy)yy_0_1_2[1]);
+yy_0_1_2_2 = ((yy)yy_0_1_2[2]);
+yy_0_1_2_3 = ((yy)yy_0_1_2[3]);
+yyv_Elems = yy_0_1_1;
+yy_1_1 = yyv_Elems;
+put_ast_members(yy_1_1);
+PutAstSubphrase();
+return;
+yyfl_49_3 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 2) goto yyfl_49_4;
+return;
+yyfl_49_4 : ;
+}
+yyErr(2,961);
+}
+put_frame_LHSKEYS(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Keys;
+yy yy_0_1_1;
+yy yyv_Key;
+yy yy_0_1_2;
+yy yy_1_1;
+yy yy_2_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 1) goto yyfl_50_1;
+yy_0_1_1 = ((yy)yy_0_1[1]);
+yy_0_1_2 = ((yy)yy_0_1[2]);
+yyv_Keys = yy_0_1_1;
+yyv_Key = yy_0_1_2;
+yy_1_1 = yyv_Keys;
+put_frame_LHSKEYS(yy_1_1);
+yy_2_1 = yyv_Key;
+put_frame_LHSKEY(yy_2_1);
+return;
+yyfl_50_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+if (yy_0_1[0] != 2) goto yyfl_50_2;
+return;
+yyfl_50_2 : ;
+}
+yyErr(2,648);
+}
+put_frame_LHSKEY(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yyv_Key;
+yy yy_0_1;
+yy yyv_Lhs;
+yy yy_1;
+yy yy_2_1;
+yy yy_2_2;
+yy yyv_Id;
+yy yy_2_2_1;
+yy yy_3_1;
+yy yy_3_2;
+yy yy_3_2_1;
+yy yy_3_2_2;
+yy yyv_FP;
+yy yy_3_2_3;
+yy yy_4_1;
+yy yyv_Str;
+yy yy_4_2;
+yy yy_6_1;
+yy yy_7_1;
+yy yy_8_1;
+yy yy_10_1;
+yy yy_12_1;
+yy yy_12_2;
+yy yy_13;
+yy yy_14_1;
+yy yy_15;
+yy yyv_Clauses;
+yy yy_16_1;
+yy yy_17_1;
+yy yy_18_1;
+yy yy_18_2;
+yy yy_19_1;
+yy_0_1 = yyin_1;
+yyv_Key = yy_0_1;
+yyb = yyh;
+yyh += 1; if (yyh > yyhx) yyExtend();
+yy_1 = (yy) yyv_Key[1];
+if (yy_1 == (yy) yyu) yyErr(1,656);
+yyv_Lhs = yy_1;
+yy_2_1 = yyv_Lhs;
+yy_2_2 = yy_2_1;
+if (yy_2_2[0] != 1) goto yyfl_51_1;
+yy_2_2_1 = ((yy)yy_2_2[1]);
+yyv_Id = yy_2_2_1;
+yy_3_1 = yyv_Id;
+if (! HasMeaning(yy_3_1, &yy_3_2)) goto yyfl_51_1;
+if (yy_3_2[0] != 2) goto yyfl_51_1;
+yy_3_2_1 = ((yy)yy_3_2[1]);
+yy_3_2_2 = ((yy)yy_3_2[2]);
+yy_3_2_3 = ((yy)yy_3_2[3]);
+yyv_FP = yy_3_2_3;
+yy_4_1 = yyv_Id;
+id_to_string(yy_4_1, &yy_4_2);
+yyv_Str = yy_4_2;
+Nl();
+yy_6_1 = ((yy)"struct yyframe_");
+Put(yy_6_1);
+yy_7_1 = yyv_Str;
+Put(yy_7_1);
+yy_8_1 = ((yy)" {");
+Put(yy_8_1);
+Nl();
+yy_10_1 = ((yy)"   struct yyframe yyf;");
+Put(yy_10_1);
+Nl();
+yy_12_1 = ((yy)1);
+yy_12_2 = yyv_Str;
+SetDeclMode(yy_12_1, yy_12_2);
+yy_13 = yyb + 0;
+yy_13[0] = 2;
+yyglov_LocalNames = yy_13;
+yy_14_1 = yyv_FP;
+handle_formal_params_2(yy_14_1);
+yy_15 = (yy) yyv_Key[3];
+if (yy_15 == (yy) yyu) yyErr(1,670);
+yyv_Clauses = yy_15;
+yy_16_1 = yyv_Clauses;
+local_declarations(yy_16_1);
+yy_17_1 = yyv_Str;
+PutDeclFields(yy_17_1);
+yy_18_1 = ((yy)0);
+yy_18_2 = yyv_Str;
+SetDeclMode(yy_18_1, yy_18_2);
+yy_19_1 = ((yy)"};");
+Put(yy_19_1);
+Nl();
+return;
+yyfl_51_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+return;
+}
+}
+put_stack_LHSKEY(yyin_1)
+yy yyin_1;
+{
+{
+yy yyb;
+yy yyv_Key;
+yy yy_0_1;
+yy yyv_Lhs;
+yy yy_1;
+yy yy_2_1;
+yy yy_2_2;
+yy yyv_Id;
+yy yy_2_2_1;
+yy yy_3_1;
+yy yy_3_2;
+yy yy_3_2_1;
+yy yy_3_2_2;
+yy yyv_FP;
+yy yy_3_2_3;
+yy yy_4_1;
+yy yyv_Str;
+yy yy_4_2;
+yy yy_6_1;
+yy yy_6_2;
+yy yy_7;
+yy yy_8_1;
+yy yy_9;
+yy yyv_Clauses;
+yy yy_10_1;
+yy yy_11_1;
+yy yy_12_1;
+yy yy_13_1;
+yy yy_15_1;
+yy yy_15_1_1;
+yy yy_16;
+yy yyv_Prelude;
+yy yy_17_1;
+yy yy_17_2;
+yy yy_17_3;
+yy yy_19_1;
+yy yy_21_1;
+yy yy_23_1;
+yy yy_26_1;
+yy yy_28_1;
+yy yy_28_1_1;
+yy_0_1 = yyin_1;
+yyv_Key = yy_0_1;
+yyb = yyh;
+yyh += 1; if (yyh > yyhx) yyExtend();
+yy_1 = (yy) yyv_Key[1];
+if (yy_1 == (yy) yyu) yyErr(1,679);
+yyv_Lhs = yy_1;
+yy_2_1 = yyv_Lhs;
+yy_2_2 = yy_2_1;
+if (yy_2_2[0] != 1) goto yyfl_52_1;
+yy_2_2_1 = ((yy)yy_2_2[1]);
+yyv_Id = yy_2_2_1;
+yy_3_1 = yyv_Id;
+if (! HasMeaning(yy_3_1, &yy_3_2)) goto yyfl_52_1;
+if (yy_3_2[0] != 2) goto yyfl_52_1;
+yy_3_2_1 = ((yy)yy_3_2[1]);
+yy_3_2_2 = ((yy)yy_3_2[2]);
+yy_3_2_3 = ((yy)yy_3_2[3]);
+yyv_FP = yy_3_2_3;
+yy_4_1 = yyv_Id;
+id_to_string(yy_4_1, &yy_4_2);
+yyv_Str = yy_4_2;
+Nl();
+yy_6_1 = ((yy)2);
+yy_6_2 = yyv_Str;
+SetDeclMode(yy_6_1, yy_6_2);
+yy_7 = yyb + 0;
+yy_7[0] = 2;
+yyglov_LocalNames = yy_7;
+yy_8_1 = yyv_FP;
+handle_formal_params_2(yy_8_1);
+yy_9 = (yy) yyv_Key[3];
+if (yy_9 == (yy) yyu) yyErr(1,687);
+yyv_Clauses = yy_9;
+yy_10_1 = yyv_Clauses;
+local_declarations(yy_10_1);
+yy_11_1 = ((yy)"yyenter_");
+Put(yy_11_1);
+yy_12_1 = yyv_Str;
+Put(yy_12_1);
+yy_13_1 = ((yy)":");
+Put(yy_13_1);
+Nl();
+yy_15_1_1 = ((yy)1);
+yy_15_1 = (yy)(((long)yy_15_1_1));
+indentation(yy_15_1);
+yy_16 = (yy) yyv_Key[2];
+if (yy_16 == (yy) yyu) yyErr(1,694);
+yyv_Prelude = yy_16;
+yy_17_1 = ((yy)"");
+yy_17_2 = yyv_Prelude;
+yy_17_3 = ((yy)"");
+put_CodeBlock(yy_17_1, yy_17_2, yy_17_3);
+indent();
+yy_19_1 = ((yy)"switch(yyselect()) {");
+Put(yy_19_1);
+Nl();
+yy_21_1 = yyv_Clauses;
+put_actions_for_nonterm_CLAUSEKEYS(yy_21_1);
+indent();
+yy_23_1 = ((yy)"}");
+Put(yy_23_1);
+Nl();
+indent();
+yy_26_1 = ((yy)"goto yyreturn;");
+Put(yy_26_1);
+Nl();
+yy_28_1_1 = ((yy)1);
+yy_28_1 = (yy)(-((long)yy_28_1_1));
+indentation(yy_28_1);
+PutUndefs();
+return;
+yyfl_52_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy_0_1 = yyin_1;
+return;
+}
+}
+put_stack_call(yyin_1, yyin_2, yyin_3)
+yy yyin_1;
+yy yyin_2;
+yy yyin_3;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Str;
+yy yy_0_2;
+yy yyv_Params;
+yy yy_0_3;
+yy yyv_Formals;
+yy yy_1_1;
+yy yyv_L;
+yy yy_3_1;
+yy yy_4_1;
+yy yy_5_1;
+yy yy_6_1;
+yy yy_7_1;
+yy yy_9_1;
+yy yy_9_2;
+yy yy_9_3;
+yy yy_11_1;
+yy yy_14_1;
+yy yy_15_1;
+yy yy_16_1;
+yy yy_19_1;
+yy yy_20_1;
+yy yy_21_1;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yy_0_3 = yyin_3;
+yyv_Str = yy_0_1;
+yyv_Params = yy_0_2;
+yyv_Formals = yy_0_3;
+NextReturnLabel(&yy_1_1);
+yyv_L = yy_1_1;
+indent();
+yy_3_1 = ((yy)"yynew = yypush_frame(sizeof(struct yyframe_");
+Put(yy_3_1);
+yy_4_1 = yyv_Str;
+Put(yy_4_1);
+yy_5_1 = ((yy)"), yyfp, ");
+Put(yy_5_1);
+yy_6_1 = yyv_L;
+PutI(yy_6_1);
+yy_7_1 = ((yy)");");
+Put(yy_7_1);
+Nl();
+yy_9_1 = yyv_Str;
+yy_9_2 = yyv_Params;
+yy_9_3 = yyv_Formals;
+put_stack_params(yy_9_1, yy_9_2, yy_9_3);
+indent();
+yy_11_1 = ((yy)"yyfp = yynew;");
+Put(yy_11_1);
+Nl();
+indent();
+yy_14_1 = ((yy)"goto yyenter_");
+Put(yy_14_1);
+yy_15_1 = yyv_Str;
+Put(yy_15_1);
+yy_16_1 = ((yy)";");
+Put(yy_16_1);
+Nl();
+indent();
+yy_19_1 = ((yy)"yyr");
+Put(yy_19_1);
+yy_20_1 = yyv_L;
+PutI(yy_20_1);
+yy_21_1 = ((yy)": ;");
+Put(yy_21_1);
+Nl();
+return;
+}
+}
+put_stack_params(yyin_1, yyin_2, yyin_3)
+yy yyin_1;
+yy yyin_2;
+yy yyin_3;
+{
+{
+yy yyb;
+yy yy_0_1;
+yy yyv_Str;
+yy yy_0_2;
+yy yyv_H;
+yy yy_0_2_1;
+yy yyv_T;
+yy yy_0_2_2;
+yy yy_0_2_3;
+yy yy_0_3;
+yy yyv_H2;
+yy yy_0_3_1;
+yy yyv_T2;
+yy yy_0_3_2;
+yy yy_1_1;
+yy yy_1_2;
+yy yy_1_2_1;
+yy yy_1_2_2;
+yy yyv_Name;
+yy yy_1_2_3;
+yy yy_1_2_4;
+yy yy_2_1;
+yy yyv_NStr;
+yy yy_2_2;
+yy yy_4_1;
+yy yy_5_1;
+yy yy_6_1;
+yy yy_7_1;
+yy yy_8_1;
+yy yy_9_1;
+yy yy_9_2;
+yy yy_10_1;
+yy yy_12_1;
+yy yy_12_2;
+yy yy_12_3;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yy_0_3 = yyin_3;
+yyv_Str = yy_0_1;
+if (yy_0_2[0] != 1) goto yyfl_54_1;
+yy_0_2_1 = ((yy)yy_0_2[1]);
+yy_0_2_2 = ((yy)yy_0_2[2]);
+yy_0_2_3 = ((yy)yy_0_2[3]);
+yyv_H = yy_0_2_1;
+yyv_T = yy_0_2_2;
+if (yy_0_3[0] != 1) goto yyfl_54_1;
+yy_0_3_1 = ((yy)yy_0_3[1]);
+yy_0_3_2 = ((yy)yy_0_3[2]);
+yyv_H2 = yy_0_3_1;
+yyv_T2 = yy_0_3_2;
+yy_1_1 = yyv_H2;
+yy_1_2 = yy_1_1;
+if (yy_1_2[0] != 1) goto yyfl_54_1;
+yy_1_2_1 = ((yy)yy_1_2[1]);
+yy_1_2_2 = ((yy)yy_1_2[2]);
+yy_1_2_3 = ((yy)yy_1_2[3]);
+yy_1_2_4 = ((yy)yy_1_2[4]);
+yyv_Name = yy_1_2_3;
+yy_2_1 = yyv_Name;
+id_to_string(yy_2_1, &yy_2_2);
+yyv_NStr = yy_2_2;
+indent();
+yy_4_1 = ((yy)"((struct yyframe_");
+Put(yy_4_1);
+yy_5_1 = yyv_Str;
+Put(yy_5_1);
+yy_6_1 = ((yy)" *) yynew)->yya_");
+Put(yy_6_1);
+yy_7_1 = yyv_NStr;
+Put(yy_7_1);
+yy_8_1 = ((yy)" = ");
+Put(yy_8_1);
+yy_9_1 = yyv_H;
+yy_9_2 = yyv_H2;
+handle_actual_param(yy_9_1, yy_9_2);
+yy_10_1 = ((yy)";");
+Put(yy_10_1);
+Nl();
+yy_12_1 = yyv_Str;
+yy_12_2 = yyv_T;
+yy_12_3 = yyv_T2;
+put_stack_params(yy_12_1, yy_12_2, yy_12_3);
+return;
+yyfl_54_1 : ;
+}
+{
+yy yyb;
+yy yy_0_1;
+yy yy_0_2;
+yy yy_0_3;
+yy_0_1 = yyin_1;
+yy_0_2 = yyin_2;
+yy_0_3 = yyin_3;
+return;
+}
+}
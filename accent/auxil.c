@@ -21,19 +21,28 @@
  */
 
 
+/*
+ * source positions are byte offsets (see errmsg.c)
+ */
+
+extern long yyLineAtPos();
+extern long yyColAtPos();
+
+/* line*1000+col as used for yycoordinate, columns beyond 999 are cut */
+
 POS_to_INT(pos, ref_number)
    long pos;
    long *ref_number;
 {
-   *ref_number = pos;
-}
+   long col = yyColAtPos(pos);
 
-#define yyLCODE 1000L
-#define yyFCODE 1000000000L
+   if (col > 999) col = 999;
+   *ref_number = yyLineAtPos(pos)*1000 + col;
+}
 
 POS_to_LineNumber(pos, ref_number)
    long pos;
    long *ref_number;
 {
-   *ref_number = (pos % yyFCODE) / yyLCODE;
+   *ref_number = yyLineAtPos(pos);
 }
@@ -1382,6 +1382,7 @@ OpenOutput(yy_8_1);
 put_actions();
 ENCODE();
 CloseOutput();
+put_ast_header();
 return;
 yyfl_2_1 : ;
 }
@@ -16,22 +16,21 @@ fix_code()
 yy yyb;
 yy yy_2_1;
 yy yy_4_1;
-yy yy_6_1;
-yy yy_8_1_1;
-yy yy_8_1_2_1;
-yy yy_8_2_1_1;
-yy yy_8_2_3_1;
+yy yy_7_1;
 yy yy_9_1;
-yy yy_11_1;
-yy yy_13_1;
-yy yy_15_1;
-yy yy_17_1;
-yy yy_19_1;
-yy yy_21_1;
-yy yy_23_1;
-yy yy_25_1;
-yy yy_27_1;
-yy yy_29_1;
+yy yy_11_1_1;
+yy yy_11_1_2_1;
+yy yy_11_2_1_1;
+yy yy_11_2_3_1;
+yy yy_12_1;
+yy yy_14_1;
+yy yy_16_1;
+yy yy_18_1;
+yy yy_20_1;
+yy yy_22_1;
+yy yy_24_1;
+yy yy_26_1;
+yy yy_28_1;
 yy yy_31_1;
 yy yy_33_1;
 yy yy_35_1;
@@ -68,177 +67,378 @@ yy yy_95_1;
 yy yy_97_1;
 yy yy_99_1;
 yy yy_101_1;
-Nl();
-yy_2_1 = ((yy)"extern YYSTYPE yylval;");
+yy yy_103_1;
+yy yy_105_1;
+yy yy_107_1;
+yy yy_109_1;
+yy yy_111_1;
+yy yy_113_1;
+yy yy_115_1;
+yy yy_117_1;
+yy yy_119_1;
+yy yy_121_1;
+yy yy_123_1;
+yy yy_125_1;
+yy yy_127_1;
+yy yy_129_1;
+yy yy_131_1;
+yy yy_133_1;
+yy yy_137_1;
+yy yy_139_1;
+yy yy_141_1;
+yy yy_143_1;
+yy yy_145_1;
+yy yy_147_1;
+yy yy_149_1;
+yy yy_151_1;
+yy yy_153_1;
+yy yy_155_1;
+yy yy_157_1;
+yy yy_159_1;
+yy yy_161_1;
+yy yy_163_1;
+yy yy_165_1;
+yy yy_167_1;
+yy yy_169_1;
+yy yy_171_1;
+yy yy_173_1;
+yy yy_175_1;
+yy yy_177_1;
+yy yy_179_1;
+yy yy_181_1;
+yy yy_183_1;
+yy yy_185_1;
+yy yy_187_1;
+yy yy_189_1;
+yy yy_191_1;
+yy yy_193_1;
+yy yy_195_1;
+yy yy_197_1;
+yy yy_199_1;
+yy yy_201_1;
+yy yy_203_1;
+Nl();
+yy_2_1 = ((yy)"extern ");
 Put(yy_2_1);
-Nl();
+PutThreadLocal();
 yy_4_1 = ((yy)"YYSTYPE yylval;");
 Put(yy_4_1);
 Nl();
-yy_6_1 = ((yy)"extern long yypos;");
-Put(yy_6_1);
+PutThreadLocal();
+yy_7_1 = ((yy)"YYSTYPE yylval;");
+Put(yy_7_1);
+Nl();
+yy_9_1 = ((yy)"extern long yypos;");
+Put(yy_9_1);
 Nl();
 {
 yy yysb = yyb;
-yy_8_1_1 = yyglov_GentleFlag;
-if (yy_8_1_1 == (yy) yyu) yyErr(1,41);
-if (yy_8_1_1[0] != 1) goto yyfl_3_1_8_1;
-yy_8_1_2_1 = ((yy)"/* GentleFlag = yes */");
-Put(yy_8_1_2_1);
-Nl();
-goto yysl_3_1_8;
-yyfl_3_1_8_1 : ;
-yy_8_2_1_1 = ((yy)"long yypos = 1;");
-Put(yy_8_2_1_1);
-Nl();
-yy_8_2_3_1 = ((yy)"/* GentleFlag = no */");
-Put(yy_8_2_3_1);
-Nl();
-goto yysl_3_1_8;
-yysl_3_1_8 : ;
+yy_11_1_1 = yyglov_GentleFlag;
+if (yy_11_1_1 == (yy) yyu) yyErr(1,43);
+if (yy_11_1_1[0] != 1) goto yyfl_3_1_11_1;
+yy_11_1_2_1 = ((yy)"/* GentleFlag = yes */");
+Put(yy_11_1_2_1);
+Nl();
+goto yysl_3_1_11;
+yyfl_3_1_11_1 : ;
+yy_11_2_1_1 = ((yy)"long yypos = 1;");
+Put(yy_11_2_1_1);
+Nl();
+yy_11_2_3_1 = ((yy)"/* GentleFlag = no */");
+Put(yy_11_2_3_1);
+Nl();
+goto yysl_3_1_11;
+yysl_3_1_11 : ;
 yyb = yysb;
 }
-yy_9_1 = ((yy)"");
-Put(yy_9_1);
-Nl();
-yy_11_1 = ((yy)"typedef struct LEXELEMSTRUCT {");
-Put(yy_11_1);
+yy_12_1 = ((yy)"");
+Put(yy_12_1);
 Nl();
-yy_13_1 = ((yy)"   YYSTYPE val;");
-Put(yy_13_1);
+yy_14_1 = ((yy)"typedef struct {");
+Put(yy_14_1);
 Nl();
-yy_15_1 = ((yy)"   long pos;");
-Put(yy_15_1);
+yy_16_1 = ((yy)"   YYSTYPE val;");
+Put(yy_16_1);
 Nl();
-yy_17_1 = ((yy)"   long sym;");
-Put(yy_17_1);
+yy_18_1 = ((yy)"   long pos;");
+Put(yy_18_1);
 Nl();
-yy_19_1 = ((yy)"   char * text;");
-Put(yy_19_1);
+yy_20_1 = ((yy)"} LEXELEM;");
+Put(yy_20_1);
 Nl();
-yy_21_1 = ((yy)"   struct LEXELEMSTRUCT *next;");
-Put(yy_21_1);
+yy_22_1 = ((yy)"   ");
+Put(yy_22_1);
 Nl();
-yy_23_1 = ((yy)"} LEXELEM;");
-Put(yy_23_1);
+yy_24_1 = ((yy)"LEXELEM *lexelems = 0;");
+Put(yy_24_1);
 Nl();
-yy_25_1 = ((yy)"   ");
-Put(yy_25_1);
+yy_26_1 = ((yy)"long lexelem_count = 0;");
+Put(yy_26_1);
 Nl();
-yy_27_1 = ((yy)"LEXELEM *first_lexelem, *cur_lexelem;");
-Put(yy_27_1);
+yy_28_1 = ((yy)"long lexelem_room = 0;");
+Put(yy_28_1);
 Nl();
-yy_29_1 = ((yy)"");
-Put(yy_29_1);
-Nl();
-yy_31_1 = ((yy)"init_lexelem()");
+PutThreadLocal();
+yy_31_1 = ((yy)"long cur_lexelem = 0;");
 Put(yy_31_1);
 Nl();
-yy_33_1 = ((yy)"{");
+yy_33_1 = ((yy)"");
 Put(yy_33_1);
 Nl();
-yy_35_1 = ((yy)"   cur_lexelem = first_lexelem;");
+yy_35_1 = ((yy)"extern void *yymemrealloc();");
 Put(yy_35_1);
 Nl();
-yy_37_1 = ((yy)"}");
+yy_37_1 = ((yy)"extern void yymemfree();");
 Put(yy_37_1);
 Nl();
 yy_39_1 = ((yy)"");
 Put(yy_39_1);
 Nl();
-yy_41_1 = ((yy)"first_lexval () {");
+yy_41_1 = ((yy)"void init_lexelem()");
 Put(yy_41_1);
 Nl();
-yy_43_1 = ((yy)"   LEXELEM *p;");
+yy_43_1 = ((yy)"{");
 Put(yy_43_1);
 Nl();
-yy_45_1 = ((yy)"   p = (LEXELEM *)malloc(sizeof(LEXELEM));");
+yy_45_1 = ((yy)"   cur_lexelem = 0;");
 Put(yy_45_1);
 Nl();
-yy_47_1 = ((yy)"   if (! p) yymallocerror();");
+yy_47_1 = ((yy)"}");
 Put(yy_47_1);
 Nl();
-yy_49_1 = ((yy)"   p->val = yylval;");
+yy_49_1 = ((yy)"");
 Put(yy_49_1);
 Nl();
-yy_51_1 = ((yy)"   p->pos = yypos;");
+yy_51_1 = ((yy)"static void append_lexelem(YYSTYPE *val, long pos) {");
 Put(yy_51_1);
 Nl();
-yy_53_1 = ((yy)"   p->next = 0;");
+yy_53_1 = ((yy)"   if (lexelem_count == lexelem_room) {");
 Put(yy_53_1);
 Nl();
-yy_55_1 = ((yy)"   cur_lexelem = p;");
+yy_55_1 = ((yy)"      long room = lexelem_room ? 2 * lexelem_room : 1024;");
 Put(yy_55_1);
 Nl();
-yy_57_1 = ((yy)"   first_lexelem = p;");
+yy_57_1 = ((yy)"      LEXELEM *p;");
 Put(yy_57_1);
 Nl();
-yy_59_1 = ((yy)"}");
+yy_59_1 = ((yy)"      p = (LEXELEM *)yymemrealloc(lexelems, room * sizeof(LEXELEM));");
 Put(yy_59_1);
 Nl();
-yy_61_1 = ((yy)"");
+yy_61_1 = ((yy)"      if (! p) yymallocerror();");
 Put(yy_61_1);
 Nl();
-yy_63_1 = ((yy)"next_lexval() {");
+yy_63_1 = ((yy)"      lexelems = p;");
 Put(yy_63_1);
 Nl();
-yy_65_1 = ((yy)"   LEXELEM *p;");
+yy_65_1 = ((yy)"      lexelem_room = room;");
 Put(yy_65_1);
 Nl();
-yy_67_1 = ((yy)"   p = (LEXELEM *)malloc(sizeof(LEXELEM));");
+yy_67_1 = ((yy)"   }");
 Put(yy_67_1);
 Nl();
-yy_69_1 = ((yy)"   if (! p) yymallocerror();");
+yy_69_1 = ((yy)"   lexelems[lexelem_count].val = *val;");
 Put(yy_69_1);
 Nl();
-yy_71_1 = ((yy)"   cur_lexelem-> next = p;");
+yy_71_1 = ((yy)"   lexelems[lexelem_count].pos = pos;");
 Put(yy_71_1);
 Nl();
-yy_73_1 = ((yy)"   p->val = yylval;");
+yy_73_1 = ((yy)"   lexelem_count++;");
 Put(yy_73_1);
 Nl();
-yy_75_1 = ((yy)"   p->pos = yypos;");
+yy_75_1 = ((yy)"}");
 Put(yy_75_1);
 Nl();
-yy_77_1 = ((yy)"   p->next = 0;");
+yy_77_1 = ((yy)"");
 Put(yy_77_1);
 Nl();
-yy_79_1 = ((yy)"   cur_lexelem = p;");
+yy_79_1 = ((yy)"void first_lexval_at (void *val, long pos) {");
 Put(yy_79_1);
 Nl();
-yy_81_1 = ((yy)"}");
+yy_81_1 = ((yy)"   lexelem_count = 0;");
 Put(yy_81_1);
 Nl();
-yy_83_1 = ((yy)"");
+yy_83_1 = ((yy)"   cur_lexelem = 0;");
 Put(yy_83_1);
 Nl();
-yy_85_1 = ((yy)"get_lexval() {");
+yy_85_1 = ((yy)"   append_lexelem((YYSTYPE *)val, pos);");
 Put(yy_85_1);
 Nl();
-yy_87_1 = ((yy)"   extern int FREE_LEXELEMS;");
+yy_87_1 = ((yy)"}");
 Put(yy_87_1);
 Nl();
-yy_89_1 = ((yy)"   LEXELEM *p;");
+yy_89_1 = ((yy)"");
 Put(yy_89_1);
 Nl();
-yy_91_1 = ((yy)"   yylval = cur_lexelem->val;");
+yy_91_1 = ((yy)"void next_lexval_at (void *val, long pos) {");
 Put(yy_91_1);
 Nl();
-yy_93_1 = ((yy)"   yypos = cur_lexelem->pos;");
+yy_93_1 = ((yy)"   append_lexelem((YYSTYPE *)val, pos);");
 Put(yy_93_1);
 Nl();
-yy_95_1 = ((yy)"   p = cur_lexelem;");
+yy_95_1 = ((yy)"}");
 Put(yy_95_1);
 Nl();
-yy_97_1 = ((yy)"   cur_lexelem = cur_lexelem->next;");
+yy_97_1 = ((yy)"");
 Put(yy_97_1);
 Nl();
-yy_99_1 = ((yy)"   free(p);");
+yy_99_1 = ((yy)"void first_lexval () {");
 Put(yy_99_1);
 Nl();
-yy_101_1 = ((yy)"}");
+yy_101_1 = ((yy)"   first_lexval_at(&yylval, yypos);");
 Put(yy_101_1);
 Nl();
+yy_103_1 = ((yy)"}");
+Put(yy_103_1);
+Nl();
+yy_105_1 = ((yy)"");
+Put(yy_105_1);
+Nl();
+yy_107_1 = ((yy)"void next_lexval() {");
+Put(yy_107_1);
+Nl();
+yy_109_1 = ((yy)"   next_lexval_at(&yylval, yypos);");
+Put(yy_109_1);
+Nl();
+yy_111_1 = ((yy)"}");
+Put(yy_111_1);
+Nl();
+yy_113_1 = ((yy)"");
+Put(yy_113_1);
+Nl();
+yy_115_1 = ((yy)"int yylval_size() {");
+Put(yy_115_1);
+Nl();
+yy_117_1 = ((yy)"   return sizeof(YYSTYPE);");
+Put(yy_117_1);
+Nl();
+yy_119_1 = ((yy)"}");
+Put(yy_119_1);
+Nl();
+yy_121_1 = ((yy)"");
+Put(yy_121_1);
+Nl();
+yy_123_1 = ((yy)"void *yylval_address() {");
+Put(yy_123_1);
+Nl();
+yy_125_1 = ((yy)"   return &yylval;");
+Put(yy_125_1);
+Nl();
+yy_127_1 = ((yy)"}");
+Put(yy_127_1);
+Nl();
+yy_129_1 = ((yy)"");
+Put(yy_129_1);
+Nl();
+yy_131_1 = ((yy)"void get_lexval() {");
+Put(yy_131_1);
+Nl();
+yy_133_1 = ((yy)"   yylval = lexelems[cur_lexelem].val;");
+Put(yy_133_1);
+Nl();
+PutSetPos();
+Nl();
+yy_137_1 = ((yy)"   cur_lexelem++;");
+Put(yy_137_1);
+Nl();
+yy_139_1 = ((yy)"}");
+Put(yy_139_1);
+Nl();
+yy_141_1 = ((yy)"");
+Put(yy_141_1);
+Nl();
+yy_143_1 = ((yy)"void skip_lexvals(long n) {");
+Put(yy_143_1);
+Nl();
+yy_145_1 = ((yy)"   cur_lexelem += n;");
+Put(yy_145_1);
+Nl();
+yy_147_1 = ((yy)"}");
+Put(yy_147_1);
+Nl();
+yy_149_1 = ((yy)"");
+Put(yy_149_1);
+Nl();
+yy_151_1 = ((yy)"long yytokenindex() {");
+Put(yy_151_1);
+Nl();
+yy_153_1 = ((yy)"   return cur_lexelem - 1;");
+Put(yy_153_1);
+Nl();
+yy_155_1 = ((yy)"}");
+Put(yy_155_1);
+Nl();
+yy_157_1 = ((yy)"");
+Put(yy_157_1);
+Nl();
+yy_159_1 = ((yy)"long yytokencount() {");
+Put(yy_159_1);
+Nl();
+yy_161_1 = ((yy)"   return lexelem_count;");
+Put(yy_161_1);
+Nl();
+yy_163_1 = ((yy)"}");
+Put(yy_163_1);
+Nl();
+yy_165_1 = ((yy)"");
+Put(yy_165_1);
+Nl();
+yy_167_1 = ((yy)"YYSTYPE *yylexval(long i) {");
+Put(yy_167_1);
+Nl();
+yy_169_1 = ((yy)"   return &lexelems[i].val;");
+Put(yy_169_1);
+Nl();
+yy_171_1 = ((yy)"}");
+Put(yy_171_1);
+Nl();
+yy_173_1 = ((yy)"");
+Put(yy_173_1);
+Nl();
+yy_175_1 = ((yy)"long yylexpos(long i) {");
+Put(yy_175_1);
+Nl();
+yy_177_1 = ((yy)"   return lexelems[i].pos;");
+Put(yy_177_1);
+Nl();
+yy_179_1 = ((yy)"}");
+Put(yy_179_1);
+Nl();
+yy_181_1 = ((yy)"");
+Put(yy_181_1);
+Nl();
+yy_183_1 = ((yy)"void free_lexelems() {");
+Put(yy_183_1);
+Nl();
+yy_185_1 = ((yy)"   lexelem_count = 0;");
+Put(yy_185_1);
+Nl();
+yy_187_1 = ((yy)"   cur_lexelem = 0;");
+Put(yy_187_1);
+Nl();
+yy_189_1 = ((yy)"}");
+Put(yy_189_1);
+Nl();
+yy_191_1 = ((yy)"");
+Put(yy_191_1);
+Nl();
+yy_193_1 = ((yy)"void release_lexelems() {");
+Put(yy_193_1);
+Nl();
+yy_195_1 = ((yy)"   free_lexelems();");
+Put(yy_195_1);
+Nl();
+yy_197_1 = ((yy)"   if (lexelems) yymemfree(lexelems);");
+Put(yy_197_1);
+Nl();
+yy_199_1 = ((yy)"   lexelems = 0;");
+Put(yy_199_1);
+Nl();
+yy_201_1 = ((yy)"   lexelem_room = 0;");
+Put(yy_201_1);
+Nl();
+yy_203_1 = ((yy)"}");
+Put(yy_203_1);
+Nl();
 Nl();
 return;
 }
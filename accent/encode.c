@@ -590,8 +590,10 @@ Nl();
 yy_83_1 = ((yy)"}");
 Put(yy_83_1);
 Nl();
+write_dirset2_table();
 write_transparent();
 write_printnames();
+WriteTables();
 return;
 }
 }
@@ -1562,6 +1564,8 @@ yy yy_6_1;
 yy yy_8;
 yy yy_8_1;
 yy yy_8_2;
+yy yy_9_1;
+yy yy_9_2;
 yy_0_1 = yyin_1;
 yyv_N = yy_0_1;
 yy_1 = yyglov_FieldIndex;
@@ -1582,6 +1586,9 @@ yy_8_1 = yyv_X;
 yy_8_2 = ((yy)1);
 yy_8 = (yy)(((long)yy_8_1)+((long)yy_8_2));
 yyglov_FieldIndex = yy_8;
+yy_9_1 = yyv_X;
+yy_9_2 = yyv_N;
+TableField(yy_9_1, yy_9_2);
 return;
 }
 }
@@ -2313,6 +2320,8 @@ yy yyv_Set;
 yy yy_3_2;
 yy yy_4_1;
 yy yy_4_2;
+yy yy_5_1;
+yy yy_5_2;
 yy_0_1 = yyin_1;
 yyv_Key = yy_0_1;
 yy_1 = (yy) yyv_Key[7];
@@ -2327,6 +2336,9 @@ yyv_Set = yy_3_2;
 yy_4_1 = yyv_K;
 yy_4_2 = yyv_Set;
 write_set(yy_4_1, yy_4_2);
+yy_5_1 = yyv_K;
+yy_5_2 = yyv_Handle;
+add_dirset2(yy_5_1, yy_5_2);
 return;
 }
 }
@@ -2935,11 +2947,15 @@ yy yy_6_1_2_1;
 yy yyv_Str;
 yy yy_6_1_2_2;
 yy yy_6_1_3_1;
+yy yy_6_1_4_1;
+yy yy_6_1_4_2;
 yy yy_6_2_1_1;
 yy yy_6_2_1_2;
 yy yyv_Sub;
 yy yy_6_2_1_2_1;
 yy yy_6_2_2_1;
+yy yy_6_2_3_1;
+yy yy_6_2_3_2;
 yy yy_7_1;
 yy_0_1 = yyin_1;
 yyv_Key = yy_0_1;
@@ -2967,6 +2983,9 @@ id_to_string(yy_6_1_2_1, &yy_6_1_2_2);
 yyv_Str = yy_6_1_2_2;
 yy_6_1_3_1 = yyv_Str;
 Put(yy_6_1_3_1);
+yy_6_1_4_1 = yyv_Pos;
+yy_6_1_4_2 = yyv_Str;
+TableName(yy_6_1_4_1, yy_6_1_4_2);
 goto yysl_81_1_6;
 yyfl_81_1_6_1 : ;
 yy_6_2_1_1 = yyv_Lhs;
@@ -2976,6 +2995,9 @@ yy_6_2_1_2_1 = ((yy)yy_6_2_1_2[1]);
 yyv_Sub = yy_6_2_1_2_1;
 yy_6_2_2_1 = ((yy)"Subphrase");
 Put(yy_6_2_2_1);
+yy_6_2_3_1 = yyv_Pos;
+yy_6_2_3_2 = ((yy)"Subphrase");
+TableName(yy_6_2_3_1, yy_6_2_3_2);
 goto yysl_81_1_6;
 yyfl_81_1_6_2 : ;
 goto yyfl_81_1;
@@ -26,17 +26,31 @@
  */
 
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #define PRIVATE static
 
 /*--------------------------------------------------------------------*/
 /* Source Positions                                                   */
 /*--------------------------------------------------------------------*/
 
-#define yyLCODE 1000L
+/*
+ * A source position is the byte offset of a character in the source
+ * file (the first character has offset 0).
+ * The scanner only advances yypos, newlines are not treated specially.
+ * Line and column are obtained from an index of line starts that is
+ * built when it is needed for the first time (by rereading the file).
+ * If the source cannot be reread (stdin), messages show the offset.
+ */
 
-long yypos = (yyLCODE+1);
+long yypos = 0;
 
-PRIVATE long yyLineCount = 1;
+PRIVATE long *yyLineStart = 0;  /* offsets of the first chars of lines */
+PRIVATE long yyLineCount = 0;
+PRIVATE long yyLineRoom = 0;
+PRIVATE int yyLinesKnown = 0;   /* 0 if the source could not be reread */
 
 /*--------------------------------------------------------------------*/
 void yyGetPos(ref_pos)
@@ -47,29 +61,98 @@ void yyGetPos(ref_pos)
 
 /*--------------------------------------------------------------------*/
 
-void yyPosToNextLine()
+PRIVATE yyAddLine(start)
+   long start;
+{
+   if (yyLineCount == yyLineRoom) {
+      yyLineRoom = yyLineRoom ? 2*yyLineRoom : 1024;
+      yyLineStart = (long *) realloc(yyLineStart, yyLineRoom*sizeof(long));
+      if (! yyLineStart) {
+         printf("running out of memory\n");
+         exit(1);
+      }
+   }
+   yyLineStart[yyLineCount++] = start;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* build the index of line starts, newlines are found with memchr */
+
+PRIVATE yyBuildLineIndex()
+{
+   char *name;
+   FILE *f;
+   static char buf[65536];
+   long offset, n;
+   char *p, *end;
+
+   yyAddLine(0);
+
+   GetSourceFileName(&name);
+   if (! name) return; /* stdin cannot be reread: a single line */
+   f = fopen(name, "rb");
+   if (! f) return;
+   yyLinesKnown = 1;
+
+   offset = 0;
+   while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+      p = buf;
+      end = buf + n;
+      while ((p = memchr(p, '\n', end - p)) != 0) {
+         p++;
+         yyAddLine(offset + (p - buf));
+      }
+      offset += n;
+   }
+   fclose(f);
+}
+
+/*--------------------------------------------------------------------*/
+
+/*
+ * line and column of the position following pos
+ * (yyGetPos yields the position of the last character read,
+ * the column is counted from 1)
+ */
+
+PRIVATE yyLineColAtPos(pos, ref_line, ref_col)
+   long pos;
+   long *ref_line;
+   long *ref_col;
 {
-   yyLineCount++;
-   yypos = yyLineCount*yyLCODE+1;
+   long lo, hi, mid;
+
+   if (! yyLineStart) yyBuildLineIndex();
+
+   pos++;
+   lo = 0; hi = yyLineCount - 1;
+   while (lo < hi) {
+      mid = (lo + hi + 1) / 2;
+      if (yyLineStart[mid] <= pos) lo = mid;
+      else hi = mid - 1;
+   }
+   *ref_line = lo + 1;
+   *ref_col = pos - yyLineStart[lo];
 }
 
 /*--------------------------------------------------------------------*/
 
-PRIVATE  yyLineAtPos(pos)
+long yyLineAtPos(pos)
    long pos;
 {
-   long l;
-   l = pos / yyLCODE;
+   long l, c;
+   yyLineColAtPos(pos, &l, &c);
    return l;
 }
 
 /*--------------------------------------------------------------------*/
 
-PRIVATE yyColAtPos(pos)
+long yyColAtPos(pos)
    long pos;
 {
-   long c;
-   c = pos % yyLCODE;
+   long l, c;
+   yyLineColAtPos(pos, &l, &c);
    return c;
 }
 
@@ -81,7 +164,12 @@ void Error(msg, pos)
    char *msg;
    long pos;
 {
-   printf("line %d, col %d: %s\n",
+   if (! yyLineStart) yyBuildLineIndex();
+   if (! yyLinesKnown) {
+      printf("offset %ld: %s\n", pos+1, msg);
+      exit(1);
+   }
+   printf("line %ld, col %ld: %s\n",
       yyLineAtPos(pos), yyColAtPos(pos), msg);
    exit(1);
 }
@@ -324,6 +324,11 @@ yy yy_16_5_1;
 yy yy_16_6_1;
 yy yy_16_8_1;
 yy yy_16_8_2;
+yy yy_10_2_1;
+yy yy_10_3_1;
+yy yy_10_4_1;
+yy yy_10_5_1;
+yy yy_8_3_1;
 yy_1_1 = ((yy)"yygrammar.h");
 OpenOutput(yy_1_1);
 yy_2_1 = ((yy)"#ifndef YYSTYPE");
@@ -335,12 +340,27 @@ Nl();
 yy_6_1 = ((yy)"#endif");
 Put(yy_6_1);
 Nl();
-yy_8_1 = ((yy)"extern YYSTYPE yylval;");
+yy_8_1 = ((yy)"extern ");
 Put(yy_8_1);
+PutThreadLocal();
+yy_8_3_1 = ((yy)"YYSTYPE yylval;");
+Put(yy_8_3_1);
 Nl();
 yy_10_1 = ((yy)"extern long yypos;");
 Put(yy_10_1);
 Nl();
+yy_10_2_1 = ((yy)"extern long yytokenindex();");
+Put(yy_10_2_1);
+Nl();
+yy_10_3_1 = ((yy)"extern long yytokencount();");
+Put(yy_10_3_1);
+Nl();
+yy_10_4_1 = ((yy)"extern YYSTYPE *yylexval();");
+Put(yy_10_4_1);
+Nl();
+yy_10_5_1 = ((yy)"extern long yylexpos();");
+Put(yy_10_5_1);
+Nl();
 Nl();
 yy_13 = yyglov_Tokens;
 if (yy_13 == (yy) yyu) yyErr(1,78);
@@ -439,6 +459,8 @@ yy yy_2_7_1;
 yy yy_2_8_1;
 yy yy_2_10_1;
 yy yy_2_10_2;
+yy yy_2_11_1;
+yy yy_2_11_2;
 yy yyv_LL;
 yy yy_3;
 yy yy_4_1_1;
@@ -456,6 +478,8 @@ yy yy_4_6_1;
 yy yy_4_7_1;
 yy yy_4_9_1;
 yy yy_4_9_2;
+yy yy_4_10_1;
+yy yy_4_10_2;
 yy_1 = yyglov_Tokens;
 if (yy_1 == (yy) yyu) yyErr(1,110);
 yyv_TL = yy_1;
@@ -488,8 +512,11 @@ Put(yy_2_7_1);
 yy_2_8_1 = ((yy)"\"; break;");
 Put(yy_2_8_1);
 Nl();
-yy_2_10_1 = yyv_Tail;
-yyv_TL = yy_2_10_1;
+yy_2_10_1 = yyv_N;
+yy_2_10_2 = yyv_Str;
+TableTokenName(yy_2_10_1, yy_2_10_2);
+yy_2_11_1 = yyv_Tail;
+yyv_TL = yy_2_11_1;
 goto yysl_11_1_2;
 yyfl_11_1_2 : ;
 yy_3 = yyglov_Literals;
@@ -521,8 +548,11 @@ Put(yy_4_6_1);
 yy_4_7_1 = ((yy)"\"; break;");
 Put(yy_4_7_1);
 Nl();
-yy_4_9_1 = yyv_Tail;
-yyv_LL = yy_4_9_1;
+yy_4_9_1 = yyv_N;
+yy_4_9_2 = yyv_Str;
+TableTokenName(yy_4_9_1, yy_4_9_2);
+yy_4_10_1 = yyv_Tail;
+yyv_LL = yy_4_10_1;
 goto yysl_11_1_4;
 yyfl_11_1_4 : ;
 return;
@@ -22,16 +22,67 @@
 
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
 
 extern FILE *yyin;
 
 char *SourceFileName;
 
+int LL2Flag = 0;
+
+char *ParallelName = 0;
+int ParallelFound = 0;
+
+int AstFlag = 0;
+
+int StackFlag = 0;
+
+int TablesFlag = 0;
+
 main (argc, argv)
    int argc;
    char **argv;
 
 {
+   while (argc > 1 && argv[1][0] == '-') {
+      if (strcmp(argv[1], "-ll2") == 0) {
+	 LL2Flag = 1;
+	 argc--;
+	 argv++;
+      }
+      else if (strcmp(argv[1], "-stackwalk") == 0) {
+	 StackFlag = 1;
+	 argc--;
+	 argv++;
+      }
+      else if (strcmp(argv[1], "-tables") == 0) {
+	 TablesFlag = 1;
+	 argc--;
+	 argv++;
+      }
+      else if (strcmp(argv[1], "-ast") == 0) {
+	 AstFlag = 1;
+	 argc--;
+	 argv++;
+      }
+      else if (strcmp(argv[1], "-parallel") == 0 && argc > 2) {
+	 ParallelName = argv[2];
+	 argc -= 2;
+	 argv += 2;
+      }
+      else {
+	 printf("unknown option '%s'\n", argv[1]);
+	 exit(1);
+      }
+   }
+
+   if (StackFlag && ParallelName) {
+      printf("options -stackwalk and -parallel cannot be combined\n");
+      exit(1);
+   }
+
    if (argc > 2) {
       printf("too many arguments\n");
       exit(1);
@@ -56,3 +107,1136 @@ GetSourceFileName(ref_string)
 {
    *ref_string = SourceFileName;
 }
+
+/*
+ * option -parallel:
+ * the elements of the nonterminal ParallelName are walked in parallel
+ * (see PARALLELWALK in entire.c)
+ */
+
+IsParallelNonterm(name)
+   char *name;
+{
+   if (ParallelName && strcmp(name, ParallelName) == 0) {
+      ParallelFound = 1;
+      return 1;
+   }
+   return 0;
+}
+
+/*
+ * yylval and the token cursor of the tree walker are thread local
+ * with -parallel, yypos is not (it is shared with the scanner and user code)
+ */
+PutThreadLocal()
+{
+   if (ParallelName) {
+      Put("__thread ");
+   }
+}
+
+/* get_lexval() of a worker thread leaves yypos alone */
+PutSetPos()
+{
+   if (ParallelName) {
+      Put("   if (! yyparallel_worker())");
+      Nl();
+      Put("   ");
+   }
+   Put("   yypos = lexelems[cur_lexelem].pos;");
+}
+
+/* definitions used by entire.c if no nonterminal is walked in parallel */
+PutParallelDefault()
+{
+   if (ParallelFound) {
+      return;
+   }
+   if (ParallelName) {
+      printf("no nonterminal '%s' (option -parallel)\n", ParallelName);
+      exit(1);
+   }
+   Nl();
+   Put("void yyparallel_walk (res)"); Nl();
+   Put("   void *res;"); Nl();
+   Put("{"); Nl();
+   Put("}"); Nl();
+   Nl();
+   Put("int yyparallel_width = 0;"); Nl();
+   Put("int yyparallel_rules[] = {"); Nl();
+   Put("0"); Nl();
+   Put("};"); Nl();
+}
+
+AstMode()
+{
+   return AstFlag;
+}
+
+PutAstStart()
+{
+   Nl();
+   Put("YYSTART ()"); Nl();
+   Put("{"); Nl();
+   Put("   yyast_build();"); Nl();
+   Put("}"); Nl();
+}
+
+/*
+ * accent -ast: yyast.h defines yymember_<nonterm>_<k>_<name>, the index
+ * of the member <name> in the member array of the k-th alternative
+ * (a name occurring again gets the suffix _2, _3, ...),
+ * the members after a subphrase have no fixed index
+ */
+
+static char *AstNonterm;
+static long AstAlternative;
+static long AstIndex;               /* -1: after a subphrase */
+static char **AstNames = 0;
+static int AstNameCount = 0;
+static int AstNameRoom = 0;
+
+StartAstMembers(nonterm, alternative)
+   char *nonterm;
+   long alternative;
+{
+   AstNonterm = nonterm;
+   AstAlternative = alternative;
+   AstIndex = 0;
+   AstNameCount = 0;
+}
+
+/* name "": a token */
+PutAstMember(name)
+   char *name;
+{
+   int i, n;
+
+   if (AstIndex < 0) return;
+   if (*name) {
+      n = 1;
+      for (i = 0; i < AstNameCount; i++) {
+	 if (strcmp(AstNames[i], name) == 0) n++;
+      }
+      if (AstNameCount == AstNameRoom) {
+	 AstNameRoom = AstNameRoom ? 2 * AstNameRoom : 64;
+	 AstNames = (char **) realloc(AstNames, AstNameRoom * sizeof(char *));
+	 if (! AstNames) {
+	    printf("running out of memory\n");
+	    exit(1);
+	 }
+      }
+      AstNames[AstNameCount++] = name;
+      Put("#define yymember_"); Put(AstNonterm);
+      Put("_"); PutI(AstAlternative);
+      Put("_"); Put(name);
+      if (n > 1) {
+	 Put("_"); PutI((long) n);
+      }
+      Put(" "); PutI(AstIndex); Nl();
+   }
+   AstIndex++;
+}
+
+PutAstSubphrase()
+{
+   AstIndex = -1;
+}
+
+/*
+ * option -stackwalk: the tree walker is a single function YYSTART
+ * that keeps the frames of the nonterminals in a stack of blocks
+ * obtained from yymemalloc (see put_stack_LHSKEY in actions.g),
+ * the parameters and locals of a nonterminal are fields yya_<name>
+ * of its frame, in its region they are accessed by macros
+ *
+ * an action block (or the rule prelude) sees the fields as local
+ * variables: the macros are undefined around the block and the fields
+ * are copied in and out, so names in the action (e.g. of struct members)
+ * are left alone
+ *
+ * the declarations at the outer level of an action or of the prelude
+ * become fields yyl<k>_<name> of the frame, visible in the following
+ * actions of the alternative like the locals of the recursive walker,
+ * a declaration is replaced by the assignments of its initializers;
+ * they are found by a first pass without output (StartDeclPass),
+ * declarations that cannot become fields (static, typedef, with a
+ * struct body or a type of the action, of a function, an initialized
+ * array) stay in the action, const is dropped from the fields
+ */
+
+struct framename {
+   char *type;
+   char *star;
+   char *name;
+};
+
+/* a declaration of an action that becomes a field */
+struct actiondecl {
+   char *frame;
+   char *type;                       /* specifiers and pointer part */
+   char *name;
+   char *dims;                       /* array dimensions or "" */
+   char *init;                       /* initializer, 0: none */
+   int field;                        /* yyl<field>_<name> */
+};
+
+/* a declaration statement that is removed from the action text */
+struct declstmt {
+   long start;
+   long end;
+   int first;                        /* its declarators in CurDecls */
+   int count;
+};
+
+/* a token of an action text */
+struct actiontoken {
+   int kind;                         /* 'a': identifier, 'o': other, or the character */
+   long start;
+   long end;
+};
+
+static int DeclMode = 0;
+static char *DeclFrame;
+static struct framename *FrameNames = 0;
+static int FrameCount = 0;
+static int FrameRoom = 0;
+static int ReturnLabelCount = 0;
+
+static int DeclPass = 0;
+static struct actiondecl *ActionDecls = 0;
+static int ActionDeclCount = 0;
+static int ActionDeclRoom = 0;
+static int DeclIndex = 0;            /* declarations of the region so far */
+
+static struct actiondecl **Visible = 0;   /* the declarations in scope */
+static int *VisibleDepth = 0;
+static int VisibleCount = 0;
+static int VisibleRoom = 0;
+static int ScopeDepth = 0;
+
+static struct actiondecl **Copied = 0;    /* 0 entries: FrameNames */
+static int *CopiedFrameName = 0;
+static int CopiedCount = 0;
+static int CopiedRoom = 0;
+
+static struct declstmt *CurStmts = 0;
+static int CurStmtCount = 0;
+static int CurStmtRoom = 0;
+static struct actiondecl *CurDecls = 0;
+static int CurDeclCount = 0;
+static int CurDeclRoom = 0;
+
+static int *LocalNames = 0;       /* tokens declaring names in the action */
+static int LocalNameCount = 0;
+static int LocalNameRoom = 0;
+
+static struct actiontoken *Tokens = 0;
+static int TokenCount = 0;
+static int TokenRoom = 0;
+static char *Text;
+
+static char *GrowArray(p, ref_room, size)
+   char *p;
+   int *ref_room;
+   int size;
+{
+   *ref_room = *ref_room ? 2 * *ref_room : 64;
+   p = (char *) realloc(p, *ref_room * size);
+   if (! p) {
+      printf("running out of memory\n");
+      exit(1);
+   }
+   return p;
+}
+
+StackMode()
+{
+   return StackFlag && ! AstFlag;
+}
+
+/* 0: local variables, 1: fields of the frame, 2: macros for the fields */
+SetDeclMode(mode, frame)
+   long mode;
+   char *frame;
+{
+   DeclMode = mode;
+   DeclFrame = frame;
+   if (mode == 2) {
+      DeclIndex = 0;
+      VisibleCount = 0;
+      ScopeDepth = 0;
+   }
+}
+
+StartDeclPass()
+{
+   DeclPass = 1;
+   MuteOutput(1L);
+}
+
+EndDeclPass()
+{
+   MuteOutput(0L);
+   DeclPass = 0;
+   ReturnLabelCount = 0;
+}
+
+static PutField(name)
+   char *name;
+{
+   Put("((struct yyframe_"); Put(DeclFrame); Put(" *) yyfp)->yya_");
+   Put(name);
+}
+
+static PutDeclField(d)
+   struct actiondecl *d;
+{
+   Put("((struct yyframe_"); Put(DeclFrame); Put(" *) yyfp)->yyl");
+   PutI((long) d->field); Put("_"); Put(d->name);
+}
+
+static PutFieldMacros()
+{
+   int i;
+
+   for (i = 0; i < FrameCount; i++) {
+      Put("#define "); Put(FrameNames[i].name);
+      Put(" ("); PutField(FrameNames[i].name); Put(")"); Nl();
+   }
+}
+
+static PutFieldUndefs()
+{
+   int i;
+
+   for (i = 0; i < FrameCount; i++) {
+      Put("#undef "); Put(FrameNames[i].name); Nl();
+   }
+}
+
+PutLocalDecl(type, star, name)
+   char *type;
+   char *star;
+   char *name;
+{
+   if (DeclMode == 2) {
+      Put("#define "); Put(name);
+      Put(" ("); PutField(name); Put(")"); Nl();
+      if (FrameCount == FrameRoom) {
+	 FrameNames = (struct framename *) GrowArray((char *) FrameNames,
+	    &FrameRoom, sizeof(struct framename));
+      }
+      FrameNames[FrameCount].type = type;
+      FrameNames[FrameCount].star = star;
+      FrameNames[FrameCount].name = name;
+      FrameCount++;
+      return;
+   }
+   Put("   "); Put(type); Put(" "); Put(star);
+   if (DeclMode == 1) {
+      Put("yya_");
+   }
+   Put(name); Put(";"); Nl();
+}
+
+/* the fields for the declarations of the actions of 'frame' */
+PutDeclFields(frame)
+   char *frame;
+{
+   int i;
+
+   for (i = 0; i < ActionDeclCount; i++) {
+      if (strcmp(ActionDecls[i].frame, frame) == 0) {
+	 Put("   "); Put(ActionDecls[i].type);
+	 Put(" yyl"); PutI((long) ActionDecls[i].field);
+	 Put("_"); Put(ActionDecls[i].name); Put(ActionDecls[i].dims);
+	 Put(";"); Nl();
+      }
+   }
+}
+
+OpenActionScope()
+{
+   ScopeDepth++;
+}
+
+CloseActionScope()
+{
+   while (VisibleCount > 0 && VisibleDepth[VisibleCount - 1] == ScopeDepth) {
+      VisibleCount--;
+   }
+   ScopeDepth--;
+}
+
+/*--------------------------------------------------------------------*/
+/* declarations in action texts */
+
+static char *Substring(start, end)
+   long start;
+   long end;
+{
+   char *s;
+
+   s = (char *) malloc(end - start + 1);
+   if (! s) {
+      printf("running out of memory\n");
+      exit(1);
+   }
+   strncpy(s, Text + start, end - start);
+   s[end - start] = 0;
+   return s;
+}
+
+/* the text of the tokens from..to-1 on one line */
+static char *Flatten(from, to)
+   int from;
+   int to;
+{
+   char *s;
+   char *p;
+
+   if (from >= to) return "";
+   s = Substring(Tokens[from].start, Tokens[to-1].end);
+   for (p = s; *p; p++) {
+      if (*p == '\n') *p = ' ';
+   }
+   return s;
+}
+
+/* 's' followed by the tokens from..to-1 separated by blanks */
+static char *Concat(s, from, to)
+   char *s;
+   int from;
+   int to;
+{
+   char *r;
+   long n;
+   int i;
+
+   n = strlen(s) + 1;
+   for (i = from; i < to; i++) {
+      n += Tokens[i].end - Tokens[i].start + 1;
+   }
+   r = (char *) malloc(n);
+   if (! r) {
+      printf("running out of memory\n");
+      exit(1);
+   }
+   strcpy(r, s);
+   for (i = from; i < to; i++) {
+      if (*r) strcat(r, " ");
+      strncat(r, Text + Tokens[i].start, Tokens[i].end - Tokens[i].start);
+   }
+   return r;
+}
+
+static ScanAction(text)
+   char *text;
+{
+   char *p = text;
+   char *q;
+   int c;
+
+   Text = text;
+   TokenCount = 0;
+   while (*p) {
+      if (isspace((unsigned char) *p)) {
+	 p++;
+	 continue;
+      }
+      if (p[0] == '/' && p[1] == '*') {
+	 q = strstr(p + 2, "*/");
+	 p = q ? q + 2 : p + strlen(p);
+	 continue;
+      }
+      if (p[0] == '/' && p[1] == '/') {
+	 while (*p && *p != '\n') p++;
+	 continue;
+      }
+      if (TokenCount == TokenRoom) {
+	 Tokens = (struct actiontoken *) GrowArray((char *) Tokens,
+	    &TokenRoom, sizeof(struct actiontoken));
+      }
+      Tokens[TokenCount].start = p - text;
+      c = *p;
+      if (isalpha(c) || c == '_') {
+	 while (isalnum((unsigned char) *p) || *p == '_') p++;
+	 Tokens[TokenCount].kind = 'a';
+      }
+      else if (isdigit(c)) {
+	 while (isalnum((unsigned char) *p) || *p == '_' || *p == '.') p++;
+	 Tokens[TokenCount].kind = 'o';
+      }
+      else if (c == '"' || c == '\'') {
+	 p++;
+	 while (*p && *p != c) {
+	    if (*p == '\\' && p[1]) p++;
+	    p++;
+	 }
+	 if (*p) p++;
+	 Tokens[TokenCount].kind = 'o';
+      }
+      else if (c == '-' && p[1] == '>') {
+	 p += 2;
+	 Tokens[TokenCount].kind = 'o';
+      }
+      else {
+	 p++;
+	 Tokens[TokenCount].kind = c;
+      }
+      Tokens[TokenCount].end = p - text;
+      TokenCount++;
+   }
+}
+
+static IsToken(i, word)
+   int i;
+   char *word;
+{
+   return i < TokenCount && Tokens[i].kind == 'a' &&
+      Tokens[i].end - Tokens[i].start == (long) strlen(word) &&
+      strncmp(Text + Tokens[i].start, word, strlen(word)) == 0;
+}
+
+static IsOneOf(i, words)
+   int i;
+   char **words;
+{
+   while (*words) {
+      if (IsToken(i, *words++)) return 1;
+   }
+   return 0;
+}
+
+static char *TypeWords[] = {
+   "void", "char", "short", "int", "long", "float", "double",
+   "signed", "unsigned", "_Bool", 0
+};
+
+static char *OtherWords[] = {
+   "struct", "union", "enum", "const", "volatile", "register", "auto",
+   "static", "extern", "typedef", "inline",
+   "return", "if", "else", "while", "do", "for", "switch", "case",
+   "default", "goto", "break", "continue", "sizeof", 0
+};
+
+static IsName(i)
+   int i;
+{
+   return i < TokenCount && Tokens[i].kind == 'a' &&
+      ! IsOneOf(i, TypeWords) && ! IsOneOf(i, OtherWords);
+}
+
+/* the token after the bracket at 'i' and its match */
+static SkipBrackets(i)
+   int i;
+{
+   int depth = 0;
+
+   do {
+      if (Tokens[i].kind == '(' || Tokens[i].kind == '[' ||
+	  Tokens[i].kind == '{') depth++;
+      if (Tokens[i].kind == ')' || Tokens[i].kind == ']' ||
+	  Tokens[i].kind == '}') depth--;
+      i++;
+   } while (i < TokenCount && depth > 0);
+   return i;
+}
+
+/* the end of the expression at 'i' (a comma or semicolon outside brackets) */
+static SkipExpression(i)
+   int i;
+{
+   while (i < TokenCount && Tokens[i].kind != ',' && Tokens[i].kind != ';') {
+      if (Tokens[i].kind == '(' || Tokens[i].kind == '[' ||
+	  Tokens[i].kind == '{') {
+	 i = SkipBrackets(i);
+      }
+      else {
+	 i++;
+      }
+   }
+   return i;
+}
+
+/* does a declaration start at token 'i' */
+static IsDeclaration(i)
+   int i;
+{
+   int j;
+
+   if (IsOneOf(i, TypeWords) ||
+       IsToken(i, "struct") || IsToken(i, "union") || IsToken(i, "enum") ||
+       IsToken(i, "const") || IsToken(i, "volatile") ||
+       IsToken(i, "register") || IsToken(i, "auto") ||
+       IsToken(i, "static") || IsToken(i, "extern") || IsToken(i, "typedef")) {
+      return 1;
+   }
+   if (! IsName(i)) return 0;
+   /* a type name: T x ... or T *x followed by ; , = [ */
+   if (IsName(i + 1)) return 1;
+   j = i + 1;
+   if (j >= TokenCount || Tokens[j].kind != '*') return 0;
+   while (j < TokenCount && Tokens[j].kind == '*') j++;
+   return IsName(j) && j + 1 < TokenCount &&
+      (Tokens[j+1].kind == ';' || Tokens[j+1].kind == ',' ||
+       Tokens[j+1].kind == '=' || Tokens[j+1].kind == '[');
+}
+
+static AddLocalName(i)
+   int i;
+{
+   if (LocalNameCount == LocalNameRoom) {
+      LocalNames = (int *) GrowArray((char *) LocalNames,
+	 &LocalNameRoom, sizeof(int));
+   }
+   LocalNames[LocalNameCount++] = i;
+}
+
+static IsNamed(i, name)
+   int i;
+   char *name;
+{
+   return Tokens[i].kind == 'a' &&
+      Tokens[i].end - Tokens[i].start == (long) strlen(name) &&
+      strncmp(Text + Tokens[i].start, name, strlen(name)) == 0;
+}
+
+/*
+ * is one of the tokens from..to-1 a type, a constant or a variable
+ * of the action (e.g. the size of an array that cannot become a field)
+ */
+static UsesLocalName(from, to)
+   int from;
+   int to;
+{
+   int i, j;
+   char *name;
+
+   for (i = from; i < to; i++) {
+      for (j = 0; j < LocalNameCount; j++) {
+	 name = Text + Tokens[LocalNames[j]].start;
+	 if (Tokens[i].kind == 'a' &&
+	     Tokens[i].end - Tokens[i].start ==
+	     Tokens[LocalNames[j]].end - Tokens[LocalNames[j]].start &&
+	     strncmp(Text + Tokens[i].start, name,
+		     Tokens[i].end - Tokens[i].start) == 0) {
+	    return 1;
+	 }
+      }
+      for (j = 0; j < VisibleCount; j++) {
+	 if (IsNamed(i, Visible[j]->name)) return 1;
+      }
+      for (j = 0; j < FrameCount; j++) {
+	 if (IsNamed(i, FrameNames[j].name)) return 1;
+      }
+   }
+   return 0;
+}
+
+/*
+ * the declaration at token 'i', returns the token after it,
+ * its declarators are appended to CurDecls if it can become fields
+ * (a field is not const, its type is not local to the action)
+ */
+static ParseDeclaration(i)
+   int i;
+{
+   char *spec;
+   char *plain;
+   int first = CurDeclCount;
+   int start = i;
+   int typeseen = 0;
+   int keep = 1;
+   int j, k, n;
+
+   /* specifiers, 'plain' without const */
+   spec = "";
+   plain = "";
+   while (i < TokenCount) {
+      if (IsToken(i, "static") || IsToken(i, "extern") ||
+	  IsToken(i, "typedef") || IsToken(i, "inline")) {
+	 keep = 0;
+	 i++;
+      }
+      else if (IsToken(i, "register") || IsToken(i, "auto")) {
+	 i++;
+      }
+      else if (IsToken(i, "const")) {
+	 spec = Concat(spec, i, i + 1);
+	 i++;
+      }
+      else if (IsToken(i, "volatile") || IsOneOf(i, TypeWords)) {
+	 typeseen |= ! IsToken(i, "volatile");
+	 spec = Concat(spec, i, i + 1);
+	 plain = Concat(plain, i, i + 1);
+	 i++;
+      }
+      else if (IsToken(i, "struct") || IsToken(i, "union") ||
+	       IsToken(i, "enum")) {
+	 typeseen = 1;
+	 j = i + 1;
+	 if (IsName(j)) j++;
+	 spec = Concat(spec, i, j);
+	 plain = Concat(plain, i, j);
+	 if (j < TokenCount && Tokens[j].kind == '{') {
+	    /* a new type (and constants), unknown outside the action */
+	    keep = 0;
+	    if (j > i + 1) AddLocalName(i + 1);
+	    k = SkipBrackets(j);
+	    if (IsToken(i, "enum")) {
+	       for (n = j + 1; n < k; n++) {
+		  if (IsName(n)) AddLocalName(n);
+	       }
+	    }
+	    j = k;
+	 }
+	 i = j;
+      }
+      else if (! typeseen && IsName(i)) {
+	 typeseen = 1;
+	 spec = Concat(spec, i, i + 1);
+	 plain = Concat(plain, i, i + 1);
+	 i++;
+      }
+      else {
+	 break;
+      }
+   }
+   if (! typeseen || UsesLocalName(start, i)) keep = 0;
+
+   /* declarators */
+   while (i < TokenCount && Tokens[i].kind != ';') {
+      j = i;
+      while (i < TokenCount && (Tokens[i].kind == '*' ||
+	     IsToken(i, "const") || IsToken(i, "volatile"))) {
+	 i++;
+      }
+      if (! IsName(i)) {
+	 keep = 0;
+	 i = SkipExpression(i);
+	 if (i < TokenCount && Tokens[i].kind == ',') i++;
+	 continue;
+      }
+      AddLocalName(i);
+      if (CurDeclCount == CurDeclRoom) {
+	 CurDecls = (struct actiondecl *) GrowArray((char *) CurDecls,
+	    &CurDeclRoom, sizeof(struct actiondecl));
+      }
+      /* a constant pointer or a constant: the field is not const */
+      k = i;
+      while (k > j && ! (Tokens[k-1].kind == '*')) k--;
+      CurDecls[CurDeclCount].type = k > j ? Concat(spec, j, k) : plain;
+      CurDecls[CurDeclCount].name = Substring(Tokens[i].start, Tokens[i].end);
+      CurDecls[CurDeclCount].init = 0;
+      k = ++i;
+      while (i < TokenCount && Tokens[i].kind == '[') {
+	 if (Tokens[i+1].kind == ']') keep = 0;
+	 i = SkipBrackets(i);
+      }
+      CurDecls[CurDeclCount].dims = Flatten(k, i);
+      if (UsesLocalName(k, i)) keep = 0;
+      if (i < TokenCount && Tokens[i].kind == '(') {
+	 keep = 0;
+      }
+      if (i < TokenCount && Tokens[i].kind == '=') {
+	 if (i > k) keep = 0;
+	 k = SkipExpression(i + 1);
+	 if (k == i + 1) keep = 0;
+	 CurDecls[CurDeclCount].init = Flatten(i + 1, k);
+	 if (strstr(CurDecls[CurDeclCount].init, "//")) keep = 0;
+	 i = k;
+      }
+      CurDeclCount++;
+      i = SkipExpression(i);
+      if (i < TokenCount && Tokens[i].kind == ',') i++;
+   }
+   if (i >= TokenCount) keep = 0;
+
+   if (keep) {
+      if (CurStmtCount == CurStmtRoom) {
+	 CurStmts = (struct declstmt *) GrowArray((char *) CurStmts,
+	    &CurStmtRoom, sizeof(struct declstmt));
+      }
+      CurStmts[CurStmtCount].start = Tokens[start].start;
+      CurStmts[CurStmtCount].end = Tokens[i].end;
+      CurStmts[CurStmtCount].first = first;
+      CurStmts[CurStmtCount].count = CurDeclCount - first;
+      CurStmtCount++;
+   }
+   else {
+      CurDeclCount = first;
+   }
+   return i + 1;
+}
+
+/* the declarations at the outer level of an action */
+static FindDeclarations(text)
+   char *text;
+{
+   int i = 0;
+   int depth = 0;
+   int start = 1;
+
+   CurStmtCount = 0;
+   CurDeclCount = 0;
+   LocalNameCount = 0;
+   ScanAction(text);
+   while (i < TokenCount) {
+      if (depth == 0 && start && IsDeclaration(i)) {
+	 i = ParseDeclaration(i);
+	 continue;
+      }
+      start = 0;
+      switch (Tokens[i].kind) {
+      case '(': case '[': case '{':
+	 depth++;
+	 break;
+      case ')': case ']':
+	 depth--;
+	 break;
+      case '}':
+	 depth--;
+	 start = depth == 0;
+	 break;
+      case ';':
+	 start = depth == 0;
+	 break;
+      }
+      i++;
+   }
+}
+
+static struct actiondecl *FindActionDecl(frame, field)
+   char *frame;
+   int field;
+{
+   int i;
+
+   for (i = 0; i < ActionDeclCount; i++) {
+      if (ActionDecls[i].field == field &&
+	  strcmp(ActionDecls[i].frame, frame) == 0) {
+	 return &ActionDecls[i];
+      }
+   }
+   printf("declarations of the actions have changed\n");
+   exit(1);
+}
+
+static CopiedName(name)
+   char *name;
+{
+   int i;
+
+   for (i = 0; i < CopiedCount; i++) {
+      if (strcmp(Copied[i] ? Copied[i]->name :
+		 FrameNames[CopiedFrameName[i]].name, name) == 0) {
+	 return 1;
+      }
+   }
+   return 0;
+}
+
+static AddCopied(d, framename)
+   struct actiondecl *d;
+   int framename;
+{
+   if (CopiedCount == CopiedRoom) {
+      Copied = (struct actiondecl **) GrowArray((char *) Copied,
+	 &CopiedRoom, sizeof(struct actiondecl *));
+      CopiedFrameName = (int *) realloc(CopiedFrameName, CopiedRoom * sizeof(int));
+      if (! CopiedFrameName) {
+	 printf("running out of memory\n");
+	 exit(1);
+      }
+   }
+   Copied[CopiedCount] = d;
+   CopiedFrameName[CopiedCount] = framename;
+   CopiedCount++;
+}
+
+/* before an action block of a region: copy the fields into locals */
+PutFrameIn(text)
+   char *text;
+{
+   struct actiondecl *d;
+   int i;
+
+   CopiedCount = 0;
+   if (DeclMode != 2) return;
+
+   FindDeclarations(text);
+   for (i = 0; i < CurDeclCount; i++) {
+      DeclIndex++;
+      if (DeclPass) {
+	 if (ActionDeclCount == ActionDeclRoom) {
+	    ActionDecls = (struct actiondecl *) GrowArray((char *) ActionDecls,
+	       &ActionDeclRoom, sizeof(struct actiondecl));
+	 }
+	 ActionDecls[ActionDeclCount] = CurDecls[i];
+	 ActionDecls[ActionDeclCount].frame = DeclFrame;
+	 ActionDecls[ActionDeclCount].field = DeclIndex;
+	 ActionDeclCount++;
+      }
+      d = FindActionDecl(DeclFrame, DeclIndex);
+      if (VisibleCount == VisibleRoom) {
+	 Visible = (struct actiondecl **) GrowArray((char *) Visible,
+	    &VisibleRoom, sizeof(struct actiondecl *));
+	 VisibleDepth = (int *) realloc(VisibleDepth, VisibleRoom * sizeof(int));
+	 if (! VisibleDepth) {
+	    printf("running out of memory\n");
+	    exit(1);
+	 }
+      }
+      Visible[VisibleCount] = d;
+      VisibleDepth[VisibleCount] = ScopeDepth;
+      VisibleCount++;
+   }
+
+   /* the innermost declaration of a name hides the others */
+   for (i = VisibleCount - 1; i >= 0; i--) {
+      if (! CopiedName(Visible[i]->name)) AddCopied(Visible[i], 0);
+   }
+   for (i = 0; i < FrameCount; i++) {
+      if (! CopiedName(FrameNames[i].name)) AddCopied(0, i);
+   }
+   if (CopiedCount == 0) return;
+
+   PutFieldUndefs();
+   Put("      {"); Nl();
+   for (i = 0; i < CopiedCount; i++) {
+      Put("      ");
+      if (Copied[i]) {
+	 d = Copied[i];
+	 Put(d->type); Put(" "); Put(d->name); Put(d->dims);
+	 if (*d->dims) {
+	    Put("; memcpy("); Put(d->name); Put(", ");
+	    PutDeclField(d); Put(", sizeof "); Put(d->name); Put(")");
+	 }
+	 else {
+	    Put(" = "); PutDeclField(d);
+	 }
+      }
+      else {
+	 Put(FrameNames[CopiedFrameName[i]].type); Put(" ");
+	 Put(FrameNames[CopiedFrameName[i]].star);
+	 Put(FrameNames[CopiedFrameName[i]].name);
+	 Put(" = "); PutField(FrameNames[CopiedFrameName[i]].name);
+      }
+      Put(";"); Nl();
+   }
+   Put("      {"); Nl();
+}
+
+/* the text from..to-1, only its line breaks if 'lines' is set */
+static PutTextRange(from, to, lines)
+   long from;
+   long to;
+   int lines;
+{
+   char buf[2];
+
+   buf[1] = 0;
+   for (; from < to; from++) {
+      if (Text[from] == '\n') {
+	 Nl();
+      }
+      else if (! lines) {
+	 buf[0] = Text[from];
+	 Put(buf);
+      }
+   }
+}
+
+/*
+ * the text of an action, its declarations replaced by assignments
+ * on the same line (so that the line numbers stay valid)
+ */
+PutActionText(text)
+   char *text;
+{
+   struct actiondecl *d;
+   long pos = 0;
+   int i, j;
+
+   if (DeclMode != 2 || CurStmtCount == 0) {
+      PutBlockText(text);
+      return;
+   }
+   Text = text;
+   for (i = 0; i < CurStmtCount; i++) {
+      PutTextRange(pos, CurStmts[i].start, 0);
+      for (j = 0; j < CurStmts[i].count; j++) {
+	 d = &CurDecls[CurStmts[i].first + j];
+	 if (d->init) {
+	    Put(d->name); Put(" = ");
+	    if (*d->init == '{') {
+	       Put("("); Put(d->type); Put(") ");
+	    }
+	    Put(d->init); Put("; ");
+	 }
+      }
+      PutTextRange(CurStmts[i].start, CurStmts[i].end, 1);
+      pos = CurStmts[i].end;
+   }
+   PutBlockText(text + pos);
+}
+
+/* after the block: copy the locals back and restore the macros */
+PutFrameOut()
+{
+   struct actiondecl *d;
+   int i;
+
+   if (CopiedCount == 0) return;
+   Put("      }"); Nl();
+   for (i = 0; i < CopiedCount; i++) {
+      Put("      ");
+      if (Copied[i]) {
+	 d = Copied[i];
+	 if (*d->dims) {
+	    Put("memcpy("); PutDeclField(d); Put(", "); Put(d->name);
+	    Put(", sizeof "); Put(d->name); Put(")");
+	 }
+	 else {
+	    PutDeclField(d); Put(" = "); Put(d->name);
+	 }
+      }
+      else {
+	 PutField(FrameNames[CopiedFrameName[i]].name);
+	 Put(" = "); Put(FrameNames[CopiedFrameName[i]].name);
+      }
+      Put(";"); Nl();
+   }
+   Put("      }"); Nl();
+   PutFieldMacros();
+   CopiedCount = 0;
+}
+
+PutUndefs()
+{
+   PutFieldUndefs();
+   FrameCount = 0;
+   VisibleCount = 0;
+   DeclMode = 0;
+}
+
+NextReturnLabel(ref_label)
+   long *ref_label;
+{
+   *ref_label = ++ReturnLabelCount;
+}
+
+PutStackWalkSupport()
+{
+   Nl();
+   Put("struct yystackblock {"); Nl();
+   Put("   struct yystackblock *yynext;"); Nl();
+   Put("   long yysize;"); Nl();
+   Put("};"); Nl();
+   Nl();
+   Put("struct yyframe {"); Nl();
+   Put("   struct yyframe *yyprev;"); Nl();
+   Put("   struct yystackblock *yyblock;"); Nl();
+   Put("   int yyret;"); Nl();
+   Put("};"); Nl();
+   Nl();
+   Put("extern void *yymemalloc();"); Nl();
+   Put("extern void yymemfree();"); Nl();
+   Nl();
+   Put("static struct yystackblock *yyfirstblock = 0;"); Nl();
+   Put("static struct yystackblock *yycurblock = 0;"); Nl();
+   Put("static char *yystacktop = 0;"); Nl();
+   Put("static char *yystackend = 0;"); Nl();
+   Nl();
+   Put("static struct yyframe *yypush_frame(n, prev, ret)"); Nl();
+   Put("   long n;"); Nl();
+   Put("   struct yyframe *prev;"); Nl();
+   Put("   int ret;"); Nl();
+   Put("{"); Nl();
+   Put("   struct yystackblock *b;"); Nl();
+   Put("   struct yyframe *f;"); Nl();
+   Nl();
+   Put("   n = (n + 15) & ~15L;"); Nl();
+   Put("   if (yystackend - yystacktop < n) {"); Nl();
+   Put("      b = yycurblock ? yycurblock->yynext : yyfirstblock;"); Nl();
+   Put("      if (b == 0 || b->yysize < n) {"); Nl();
+   Put("         b = (struct yystackblock *)"); Nl();
+   Put("             yymemalloc(sizeof(struct yystackblock) + n + 65536);"); Nl();
+   Put("         if (! b) yymallocerror();"); Nl();
+   Put("         b->yysize = n + 65536;"); Nl();
+   Put("         if (yycurblock) {"); Nl();
+   Put("            b->yynext = yycurblock->yynext;"); Nl();
+   Put("            yycurblock->yynext = b;"); Nl();
+   Put("         }"); Nl();
+   Put("         else {"); Nl();
+   Put("            b->yynext = yyfirstblock;"); Nl();
+   Put("            yyfirstblock = b;"); Nl();
+   Put("         }"); Nl();
+   Put("      }"); Nl();
+   Put("      yycurblock = b;"); Nl();
+   Put("      yystacktop = (char *) (b + 1);"); Nl();
+   Put("      yystackend = yystacktop + b->yysize;"); Nl();
+   Put("   }"); Nl();
+   Put("   f = (struct yyframe *) yystacktop;"); Nl();
+   Put("   yystacktop += n;"); Nl();
+   Put("   f->yyprev = prev;"); Nl();
+   Put("   f->yyblock = yycurblock;"); Nl();
+   Put("   f->yyret = ret;"); Nl();
+   Put("   return f;"); Nl();
+   Put("}"); Nl();
+   Nl();
+   Put("static void yypop_frame(f)"); Nl();
+   Put("   struct yyframe *f;"); Nl();
+   Put("{"); Nl();
+   Put("   yycurblock = f->yyblock;"); Nl();
+   Put("   yystacktop = (char *) f;"); Nl();
+   Put("   yystackend = (char *) (yycurblock + 1) + yycurblock->yysize;"); Nl();
+   Put("}"); Nl();
+   Nl();
+   Put("static void yyrelease_frames()"); Nl();
+   Put("{"); Nl();
+   Put("   struct yystackblock *b;"); Nl();
+   Nl();
+   Put("   while (yyfirstblock) {"); Nl();
+   Put("      b = yyfirstblock;"); Nl();
+   Put("      yyfirstblock = b->yynext;"); Nl();
+   Put("      yymemfree(b);"); Nl();
+   Put("   }"); Nl();
+   Put("   yycurblock = 0;"); Nl();
+   Put("   yystacktop = yystackend = 0;"); Nl();
+   Put("}"); Nl();
+}
+
+PutStackWalkStart()
+{
+   Nl();
+   Put("YYSTART ()"); Nl();
+   Put("{"); Nl();
+   Put("   struct yyframe *yyfp;"); Nl();
+   Put("   struct yyframe *yynew;"); Nl();
+   Put("   int yyret;"); Nl();
+   Nl();
+   Put("   yyfp = yypush_frame(sizeof(struct yyframe_YYSTART), (struct yyframe *) 0, 0);"); Nl();
+   Put("   goto yyenter_YYSTART;"); Nl();
+}
+
+PutStackWalkEnd()
+{
+   int i;
+
+   Nl();
+   Put("yyreturn:"); Nl();
+   Put("   yyret = yyfp->yyret;"); Nl();
+   Put("   yynew = yyfp;"); Nl();
+   Put("   yyfp = yyfp->yyprev;"); Nl();
+   Put("   yypop_frame(yynew);"); Nl();
+   Put("   switch (yyret) {"); Nl();
+   for (i = 1; i <= ReturnLabelCount; i++) {
+      Put("   case "); PutI((long) i); Put(": goto yyr"); PutI((long) i); Put(";"); Nl();
+   }
+   Put("   }"); Nl();
+   Put("   yyrelease_frames();"); Nl();
+   Put("}"); Nl();
+}
@@ -37,6 +37,7 @@ PRIVATE long OutputLineCount = 0;
 PRIVATE char OutBuf[OutBufSize];
 PRIVATE char *OutBufPtr;
 PRIVATE FILE *OutFile;
+PRIVATE char *MutedAt = 0;         /* output is discarded from here */
 
 /*--------------------------------------------------------------------*/
 
@@ -113,9 +114,26 @@ PutI (N)
    }
 }
 
+/*--------------------------------------------------------------------*/
+MuteOutput (On)
+   long On;
+{
+   if (On) {
+      MutedAt = OutBufPtr;
+   }
+   else {
+      OutBufPtr = MutedAt;
+      MutedAt = 0;
+   }
+}
+
 /*--------------------------------------------------------------------*/
 Nl ()
 {
+   if (MutedAt) {
+      OutBufPtr = MutedAt;
+      return;
+   }
    if (OutBufPtr > &OutBuf[FlushPos]) {
       fwrite(OutBuf, 1, OutBufPtr - &OutBuf[0], OutFile);
       OutBufPtr = &OutBuf[0];
@@ -137,3 +155,231 @@ GetOutputLineCount(ref_n)
 }
 
 /*--------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------*/
+/*
+ * option -tables:
+ * the tables written to yygrammar.c are collected here
+ * and written to the binary file yygrammar.tab,
+ * which ENTIRE can map into memory (option GRAMMARTABLES)
+ *
+ * the header must agree with struct tablehdr in entire.c,
+ * all numbers are in the byte order of the machine running accent
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+extern int TablesFlag;
+
+#define TABLEMAGIC "EGRT"
+#define TABLEVERSION 2
+#define TABLEBYTEORDER 0x01020304
+#define TABLEALIGN 8
+#define TABLETERMBASE 50000
+
+struct tablehdr {
+   char magic[4];
+   unsigned int version;
+   unsigned int byteorder;
+   int termbase;
+   int length;                       /* c_length */
+   int dirset_rows;                  /* rule numbers */
+   int dirset_columns;               /* token codes */
+   int name_count;
+   int reserved[2];
+   unsigned long long grammar;       /* offsets of the sections */
+   unsigned long long annotation;
+   unsigned long long coordinate;
+   unsigned long long dirsets;
+   unsigned long long names;
+   unsigned long long strings;
+   unsigned long long size;          /* of the file */
+};
+
+struct intvec {
+   int *elem;
+   long count;
+   long room;
+};
+
+PRIVATE struct intvec TableArray[3];
+/* yygrammar, yyannotation, yycoordinate */
+PRIVATE int CurTableArray = -1;
+
+PRIVATE struct intvec Dirsets;       /* pairs rule, token */
+PRIVATE struct intvec Names;         /* pairs code, offset in Strings */
+
+PRIVATE char *Strings = 0;
+PRIVATE long StringsLength = 0;
+PRIVATE long StringsRoom = 0;
+
+/*--------------------------------------------------------------------*/
+PRIVATE void AppendInt(v, n)
+   struct intvec *v;
+   long n;
+{
+   if (v->count == v->room) {
+      v->room = v->room ? 2 * v->room : 1024;
+      v->elem = (int *) realloc(v->elem, v->room * sizeof(int));
+      if (! v->elem) {
+	 printf("running out of memory\n"); exit(1);
+      }
+   }
+   v->elem[v->count++] = n;
+}
+
+/*--------------------------------------------------------------------*/
+TableField(Index, Value)
+   long Index, Value;
+{
+   if (! TablesFlag) return;
+
+   /* each array starts with field index 1, its element 0 is 0 */
+   if (Index == 1 && CurTableArray < 2) {
+      CurTableArray++;
+      AppendInt(&TableArray[CurTableArray], 0);
+   }
+   AppendInt(&TableArray[CurTableArray], Value);
+}
+
+/*--------------------------------------------------------------------*/
+TableDirset(Rule, Token)
+   long Rule, Token;
+{
+   if (! TablesFlag) return;
+
+   AppendInt(&Dirsets, Rule);
+   AppendInt(&Dirsets, Token);
+}
+
+/*--------------------------------------------------------------------*/
+TableName(Code, Name)
+   long Code;
+   char *Name;
+{
+   long n;
+
+   if (! TablesFlag) return;
+
+   n = strlen(Name) + 1;
+   if (StringsLength + n > StringsRoom) {
+      StringsRoom = StringsRoom ? 2 * StringsRoom : 4096;
+      if (StringsRoom < StringsLength + n) StringsRoom = StringsLength + n;
+      Strings = (char *) realloc(Strings, StringsRoom);
+      if (! Strings) {
+	 printf("running out of memory\n"); exit(1);
+      }
+   }
+   AppendInt(&Names, Code);
+   AppendInt(&Names, StringsLength);
+   strcpy(Strings + StringsLength, Name);
+   StringsLength += n;
+}
+
+/*--------------------------------------------------------------------*/
+TableTokenName(Code, Name)
+   long Code;
+   char *Name;
+{
+   TableName(Code + TABLETERMBASE, Name);
+}
+
+/*--------------------------------------------------------------------*/
+PRIVATE int CompareNames(p1, p2)
+   char *p1, *p2;
+{
+   int c1 = *(int *) p1;
+   int c2 = *(int *) p2;
+
+   return c1 < c2 ? -1 : c1 > c2;
+}
+
+/*--------------------------------------------------------------------*/
+PRIVATE unsigned long long TableSection(ref_offset, size)
+   unsigned long long *ref_offset;
+   long size;
+{
+   unsigned long long offset = *ref_offset;
+
+   *ref_offset = (offset + size + TABLEALIGN - 1) & ~(TABLEALIGN - 1ULL);
+   return offset;
+}
+
+/*--------------------------------------------------------------------*/
+PRIVATE void PutSection(f, offset, p, size)
+   FILE *f;
+   unsigned long long offset;
+   char *p;
+   long size;
+{
+   while (ftell(f) < (long) offset) putc(0, f);
+   fwrite(p, 1, size, f);
+}
+
+/*--------------------------------------------------------------------*/
+WriteTables()
+{
+   struct tablehdr h;
+   unsigned long long offset;
+   unsigned char *dirsets;
+   long i, rows, columns;
+   FILE *f;
+
+   if (! TablesFlag) return;
+
+   for (i = 0; i < 3; i++) {
+      AppendInt(&TableArray[i], 0);
+   }
+
+   rows = columns = 0;
+   for (i = 0; i < Dirsets.count; i += 2) {
+      if (Dirsets.elem[i] >= rows) rows = Dirsets.elem[i] + 1;
+      if (Dirsets.elem[i+1] >= columns) columns = Dirsets.elem[i+1] + 1;
+   }
+   dirsets = (unsigned char *) calloc(rows * columns + 1, 1);
+   if (! dirsets) {
+      printf("running out of memory\n"); exit(1);
+   }
+   for (i = 0; i < Dirsets.count; i += 2) {
+      dirsets[Dirsets.elem[i] * columns + Dirsets.elem[i+1]] = 1;
+   }
+
+   qsort(Names.elem, Names.count / 2, 2 * sizeof(int), CompareNames);
+
+   memset(&h, 0, sizeof(h));
+   memcpy(h.magic, TABLEMAGIC, 4);
+   h.version = TABLEVERSION;
+   h.byteorder = TABLEBYTEORDER;
+   h.termbase = TABLETERMBASE;
+   h.length = TableArray[0].count - 2;
+   h.dirset_rows = rows;
+   h.dirset_columns = columns;
+   h.name_count = Names.count / 2;
+
+   offset = sizeof(h);
+   h.grammar = TableSection(&offset, TableArray[0].count * sizeof(int));
+   h.annotation = TableSection(&offset, TableArray[1].count * sizeof(int));
+   h.coordinate = TableSection(&offset, TableArray[2].count * sizeof(int));
+   h.dirsets = TableSection(&offset, rows * columns);
+   h.names = TableSection(&offset, Names.count * sizeof(int));
+   h.strings = TableSection(&offset, StringsLength);
+   h.size = offset;
+
+   f = fopen("yygrammar.tab", "wb");
+   if (f == NULL) {
+      printf("cannot open yygrammar.tab\n"); exit(1);
+   }
+   fwrite(&h, sizeof(h), 1, f);
+   PutSection(f, h.grammar, TableArray[0].elem, TableArray[0].count * sizeof(int));
+   PutSection(f, h.annotation, TableArray[1].elem, TableArray[1].count * sizeof(int));
+   PutSection(f, h.coordinate, TableArray[2].elem, TableArray[2].count * sizeof(int));
+   PutSection(f, h.dirsets, dirsets, rows * columns);
+   PutSection(f, h.names, Names.elem, Names.count * sizeof(int));
+   PutSection(f, h.strings, Strings, StringsLength);
+   PutSection(f, h.size, 0, 0);
+   fclose(f);
+   free(dirsets);
+}
+
+/*--------------------------------------------------------------------*/
@@ -86,6 +86,7 @@ PUBLIC write_set(n, s)
       PutI(p->head);
       Put("] = 1;");
       Nl();
+      TableDirset(n, p->head);
       p = p->tail;
    }
 }
@@ -924,14 +924,12 @@ YY_RULE_SETUP
 	       }
 	       AppendToString('\\');
 	       AppendToString(ch);
-               if (ch == '\n') yyPosToNextLine();
 	    }
 	    else if (ch == this_terminator) {
 	       break;
 	    }
 	    else {
 	       AppendToString(ch);
-               if (ch == '\n') yyPosToNextLine();
             }
 	 }
 	 AppendToString(this_terminator);
@@ -947,7 +945,6 @@ YY_RULE_SETUP
 	 }
 	 AppendToString('\\');
 	 AppendToString(ch);
-         if (ch == '\n') yyPosToNextLine();
          ch = input(); yypos++;
       }
 
@@ -984,7 +981,6 @@ YY_RULE_SETUP
 	       AppendToString(ch);
 	       if (ch == '\n') {
 		  AppendToString(ch);
-		  yyPosToNextLine();
 	       }
 	       ch = input(); yypos++;
 	       if (ch == '*') {
@@ -1010,8 +1006,7 @@ YY_RULE_SETUP
 	       ch = input(); yypos++;
 	       if (ch == '\n') {
 		  AppendToString(ch);
-                  ch = input();
-		  yyPosToNextLine();
+                  ch = input(); yypos++;
 		  break;
 	       }
 	       else if (ch <= 0) {
@@ -1029,9 +1024,6 @@ YY_RULE_SETUP
       /* 7: else */
       else {
          AppendToString(ch);
-         if (ch == '\n') {
-            yyPosToNextLine();
-         }
          ch = input(); yypos++;
       }
    }
@@ -1045,7 +1037,6 @@ YY_RULE_SETUP
    for(;;) {
       int ch = input(); yypos++;
       if (ch == '\n') {
-	 yyPosToNextLine();
 	 break;
       }
       else if (ch <= 0) {
@@ -1068,7 +1059,6 @@ YY_RULE_SETUP
    yypos++;
    
    for (;;) {
-      if (ch == '\n') yyPosToNextLine();
       /* begin of comment ? */
       if (ch == '/') {
          ch = input();
@@ -1107,12 +1097,12 @@ YY_RULE_SETUP
 case 33:
 YY_RULE_SETUP
 #line 295 "gen.l"
-{ yyPosToNextLine(); }
+{ yypos += 1; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
 #line 296 "gen.l"
-{ }
+{ yypos += 1; }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
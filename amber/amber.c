@@ -440,13 +440,13 @@ static void table_full() {
 #if DYNAMICITEMS
     ITEMLIMIT += ITEMINCR;
 
-    dot = (long *) realloc(dot, ITEMLIMIT * sizeof(long));
+    dot = (long *) yymemrealloc(dot, ITEMLIMIT * sizeof(long));
     if (! dot) yymallocerror();
-    back = (long *) realloc(back, ITEMLIMIT * sizeof(long));
+    back = (long *) yymemrealloc(back, ITEMLIMIT * sizeof(long));
     if (! back) yymallocerror();
-    left = (long *) realloc(left, ITEMLIMIT * sizeof(long));
+    left = (long *) yymemrealloc(left, ITEMLIMIT * sizeof(long));
     if (! left) yymallocerror();
-    sub = (long *) realloc(sub, ITEMLIMIT * sizeof(long));
+    sub = (long *) yymemrealloc(sub, ITEMLIMIT * sizeof(long));
     if (! sub) yymallocerror();
 #else
     Abort("fatal error: item table overflow [increase ITEMLIMIT in art.c]\n");
@@ -460,6 +460,24 @@ void yymallocerror() {
     exit(1);
 }
 
+/*----------------------------------------------------------------------------*/
+
+/*
+ * memory for the item table, the stack
+ * and the lexical values in 'yygrammar.c'
+ */
+void *yymemalloc(size_t n) {
+    return malloc(n);
+}
+
+void *yymemrealloc(void *p, size_t n) {
+    return realloc(p, n);
+}
+
+void yymemfree(void *p) {
+    free(p);
+}
+
 /*============================================================================*/
 /* SEARCH OPTIMISATION                                                        */
 /*============================================================================*/
@@ -1158,13 +1176,13 @@ static void initial_itemlist() {
 #if DYNAMICITEMS
     ITEMLIMIT = ITEMINCR;
 
-    dot = (long *) malloc(ITEMLIMIT * sizeof(long));
+    dot = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
     if (! dot) yymallocerror();
-    back = (long *) malloc(ITEMLIMIT * sizeof(long));
+    back = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
     if (! back) yymallocerror();
-    left = (long *) malloc(ITEMLIMIT * sizeof(long));
+    left = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
     if (! left) yymallocerror();
-    sub = (long *) malloc(ITEMLIMIT * sizeof(long));
+    sub = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
     if (! sub) yymallocerror();
 #endif
 
@@ -1338,7 +1356,7 @@ int stptr = 0;
 static void push(int n) {
     if (stptr == STACKSIZE - 2) {
         STACKSIZE += STACKINCR;
-        stack = (int *) realloc(stack, sizeof(int) * STACKSIZE);
+        stack = (int *) yymemrealloc(stack, sizeof(int) * STACKSIZE);
         if (! stack) yymallocerror();
     }
     stack[stptr++] = n;
@@ -1362,7 +1380,7 @@ static int pop() {
  */
 static void init_stack() {
     STACKSIZE = STACKINCR;
-    stack = (int *) malloc (sizeof(int) * STACKSIZE);
+    stack = (int *) yymemalloc(sizeof(int) * STACKSIZE);
     if (! stack) yymallocerror();
 }
 
@@ -4,6 +4,9 @@
 extern int yydirset();
 
 void yymallocerror(void);
+void *yymemalloc(size_t n);
+void *yymemrealloc(void *p, size_t n);
+void yymemfree(void *p);
 int disfilter(int n1, int n2, int p1, int p2);
 int confilter(int n, int p1, int p2);
 int yyselect(void);
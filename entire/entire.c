@@ -30,6 +30,7 @@
 
 /*============================================================================*/
 #include <stdlib.h>
+#include "entire.h"
 
 #define PRIVATE static
 #define PUBLIC
@@ -42,16 +43,198 @@
 #define WALK 1
 #define CHECKVIABLE 1
 #define LOOKAHEAD 1
+#define LOOKAHEAD2 0
 #define ERRPOSCORRECTION 1
 #define DETECTAMBIGUITY 1
 #define DYNAMICCYCLECHECK 1
 #define HASHING 1
 #define DYNAMICITEMS 1
+#define SPPF 0
+#define STATISTICS 1
+#define TRACE 0
+#define PHASETIMING 0
+#define PERFCOUNTERS 0
+#define PROFILE 0
+#define TIMELINE 0
+#define LIMITS 0
+#define KEEPMEMORY 0
+#define ERRORRECOVERY 0
+#define LEXERTHREAD 0
+#define SOURCEBUFFER 0
+#define DERIVATIONLOG 0
+#define LINEARWALK 0
+#define SUBTREESKIP 0
+#define PARALLELWALK 0
+#define ASTBUILDER 0
+#define EVENTSTREAM 0
+#define PARSECACHE 0
+#define GRAMMARTABLES 0
+
+/* options that build on others */
+#if SUBTREESKIP && ! LINEARWALK
+#error "option SUBTREESKIP requires LINEARWALK"
+#endif
+#if PARALLELWALK && ! (LINEARWALK && SUBTREESKIP)
+#error "option PARALLELWALK requires LINEARWALK and SUBTREESKIP"
+#endif
+#if PARSECACHE && ! (SOURCEBUFFER && DERIVATIONLOG)
+#error "option PARSECACHE requires SOURCEBUFFER and DERIVATIONLOG"
+#endif
 
 
 /*============================================================================*/
 
 extern char *yyprintname();
+/*============================================================================*/
+/* ALLOCATION                                                                 */
+/*============================================================================*/
+
+/*
+ * All memory of the parser (and of the lexical values in 'yygrammar.c')
+ * is obtained by yymemalloc/yymemrealloc and released by yymemfree.
+ * These use the functions installed by yyset_allocator()
+ * or, if none have been installed, malloc/realloc/free.
+ */
+
+PRIVATE struct yyallocator allocator;
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * install the allocator a (0: malloc/realloc/free)
+ * this must not be done while memory of the parser is still in use
+ */
+PUBLIC void yyset_allocator(struct yyallocator *a) {
+  static struct yyallocator none;
+
+  allocator = a ? *a : none;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PUBLIC void *yymemalloc(size_t n) {
+  if (allocator.alloc) {
+    return allocator.alloc(n, allocator.data);
+  }
+  return malloc(n);
+}
+
+/*----------------------------------------------------------------------------*/
+
+PUBLIC void *yymemrealloc(void *p, size_t n) {
+  if (allocator.resize) {
+    return allocator.resize(p, n, allocator.data);
+  }
+  return realloc(p, n);
+}
+
+/*----------------------------------------------------------------------------*/
+
+PUBLIC void yymemfree(void *p) {
+  if (allocator.release) {
+    allocator.release(p, allocator.data);
+    return;
+  }
+  free(p);
+}
+
+/*----------------------------------------------------------------------------*/
+
+#if SPPF || PROFILE || DERIVATIONLOG
+/*
+ * allocate n bytes that are set to zero
+ */
+PRIVATE void *zalloc(size_t n) {
+  char *p;
+  size_t k;
+
+  p = (char *) yymemalloc(n);
+  if (p) {
+    for (k = 0; k < n; k++) {
+      p[k] = 0;
+    }
+  }
+  return p;
+}
+#endif
+
+/*============================================================================*/
+/* STATISTICS                                                                 */
+/*============================================================================*/
+
+#if STATISTICS
+
+/*
+ * counters describing the last call of yyparse()
+ * (see 'struct yystatistics' in entire.h)
+ */
+struct yystatistics yystats;
+
+#define COUNT(field) yystats.field++
+#define COUNTN(field, n) yystats.field += (n)
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * clear all counters (called at the beginning of yyparse)
+ */
+PRIVATE reset_statistics() {
+  static struct yystatistics initial;
+
+  yystats = initial;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the statistics of the last parse
+ */
+PUBLIC struct yystatistics *yyparse_statistics() {
+  return &yystats;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the statistics of the last parse as a JSON object to f
+ */
+PUBLIC void yyprint_statistics(FILE *f) {
+  int k;
+
+  fprintf(f, "{\n");
+  fprintf(f, "  \"lists\": %ld,\n", yystats.lists);
+  fprintf(f, "  \"items\": %ld,\n", yystats.items);
+  fprintf(f, "  \"peak_list_size\": %ld,\n", yystats.peak_list_size);
+  fprintf(f, "  \"average_list_size\": %.2f,\n",
+          yystats.lists ? (double) yystats.items / yystats.lists : 0.0);
+  fprintf(f, "  \"list_size_histogram\": [");
+  for (k = 0; k < YYSTATBUCKETS; k++) {
+    fprintf(f, k ? ", %ld" : "%ld", yystats.list_sizes[k]);
+  }
+  fprintf(f, "],\n");
+  fprintf(f, "  \"kernel_calls\": %ld,\n", yystats.kernel_calls);
+  fprintf(f, "  \"predictor_calls\": %ld,\n", yystats.predictor_calls);
+  fprintf(f, "  \"completer_calls\": %ld,\n", yystats.completer_calls);
+  fprintf(f, "  \"hash_hits\": %ld,\n", yystats.hash_hits);
+  fprintf(f, "  \"search_probes\": %ld,\n", yystats.search_probes);
+  fprintf(f, "  \"viable_rejections\": %ld,\n", yystats.viable_rejections);
+  fprintf(f, "  \"dirset_rejections\": %ld,\n", yystats.dirset_rejections);
+  fprintf(f, "  \"conjunctive_ambiguities\": %ld,\n",
+          yystats.conjunctive_ambiguities);
+  fprintf(f, "  \"disjunctive_ambiguities\": %ld,\n",
+          yystats.disjunctive_ambiguities);
+  fprintf(f, "  \"confilter_calls\": %ld,\n", yystats.confilter_calls);
+  fprintf(f, "  \"disfilter_calls\": %ld,\n", yystats.disfilter_calls);
+  fprintf(f, "  \"table_growths\": %ld,\n", yystats.table_growths);
+  fprintf(f, "  \"bytes_allocated\": %ld\n", yystats.bytes_allocated);
+  fprintf(f, "}\n");
+}
+
+#else
+#define COUNT(field)
+#define COUNTN(field, n)
+#endif
+
 /*============================================================================*/
 /* ITEMS                                                                      */
 /*============================================================================*/
@@ -63,12 +246,21 @@ int ITEMLIMIT;
 #endif
 
 #define ITEMINCR 285000
+#define ITEMMIN 4          /* smallest table: sentinel and terminator */
 
 # if DYNAMICITEMS
 long *dot, *back, *left, *sub;
 #else
 long dot[ITEMLIMIT], back[ITEMLIMIT], left[ITEMLIMIT], sub[ITEMLIMIT];
 #endif
+
+#if SPPF
+# if DYNAMICITEMS
+long *packed;
+#else
+long packed[ITEMLIMIT];
+#endif
+#endif
 /*
  * An "item" is a quadrupel < D, B, L, S > , where
  *
@@ -97,6 +289,9 @@ long dot[ITEMLIMIT], back[ITEMLIMIT], left[ITEMLIMIT], sub[ITEMLIMIT];
  *    back[I] = B
  *    left[I] = L
  *    sub[I]  = S
+ *
+ * If SPPF is set, packed[I] refers to further < L, S > pairs of the item
+ * (see PARSE FOREST)
  */
 
 long thislist;
@@ -122,6 +317,350 @@ long specialitemadded;
 
 long lookaheadswitchedoff = 0;
 
+/*============================================================================*/
+/* TRACE                                                                      */
+/*============================================================================*/
+
+#if TRACE || LEXERTHREAD || PARALLELWALK
+/* single producer / single consumer ring buffers (TRACE, LEXERTHREAD) */
+#ifdef __GNUC__
+#define LOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#else
+#define LOAD_ACQUIRE(x) (x)
+#define STORE_RELEASE(x, v) ((x) = (v))
+#endif
+#endif
+
+#if TRACE
+
+/*
+ * Recognizer events (see 'struct yytrace_event' in entire.h)
+ * are passed to a callback installed by yytrace_callback()
+ * and/or appended to a ring buffer installed by yytrace_ring().
+ *
+ * The ring buffer has a single producer (the parser)
+ * and a single consumer (yytrace_fetch, possibly in another thread).
+ * The producer only writes ring_head, the consumer only writes ring_tail,
+ * so no lock is needed. If the buffer is full, the event is dropped.
+ */
+
+PRIVATE yytrace_function trace_callback = 0;
+PRIVATE void *trace_data;
+
+PRIVATE struct yytrace_event *ring = 0;
+PRIVATE unsigned long ring_size;
+PRIVATE unsigned long ring_head;
+PRIVATE unsigned long ring_tail;
+PRIVATE unsigned long ring_dropped;
+
+#define TRACEEVENT(kind, reason, d, b, l, s) \
+  do { \
+    if (trace_callback || ring) trace_event(kind, reason, d, b, l, s); \
+  } while (0)
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * install f as callback for recognizer events (0: none)
+ * data is passed to f unchanged
+ */
+PUBLIC void yytrace_callback(yytrace_function f, void *data) {
+  trace_callback = f;
+  trace_data = data;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * install buf (with room for size events) as ring buffer
+ * for recognizer events (buf 0: none)
+ * size must be a power of two
+ */
+PUBLIC void yytrace_ring(struct yytrace_event *buf, unsigned long size) {
+  if (size & (size - 1)) {
+    printf("yytrace_ring: size must be a power of two\n");
+    exit(1);
+  }
+  ring = 0;
+  ring_size = size;
+  ring_head = 0;
+  ring_tail = 0;
+  ring_dropped = 0;
+  STORE_RELEASE(ring, buf);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * move up to max events from the ring buffer to dst
+ * return the number of events moved
+ */
+PUBLIC unsigned long yytrace_fetch(struct yytrace_event *dst,
+                                   unsigned long max) {
+  unsigned long head, tail, n;
+
+  tail = ring_tail;
+  head = LOAD_ACQUIRE(ring_head);
+  n = 0;
+  while (tail != head && n < max) {
+    dst[n++] = ring[tail & (ring_size - 1)];
+    tail++;
+  }
+  STORE_RELEASE(ring_tail, tail);
+  return n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the number of events dropped because the ring buffer was full
+ */
+PUBLIC unsigned long yytrace_dropped() {
+  return LOAD_ACQUIRE(ring_dropped);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * report an event concerning the item < d, b, l, s >
+ * of the current item list
+ */
+PRIVATE trace_event(int kind, int reason, long d, long b, long l, long s) {
+  struct yytrace_event e;
+  unsigned long head;
+
+  if (kind == YYTRACE_ADDED && d == 0) {
+    /* terminator of the list */
+    return;
+  }
+
+  e.kind = kind;
+  e.reason = reason;
+  e.list = thislist;
+  e.dot = d;
+  e.back = b;
+  e.left = l;
+  e.sub = s;
+
+  if (trace_callback) {
+    trace_callback(&e, trace_data);
+  }
+  if (ring) {
+    head = ring_head;
+    if (head - LOAD_ACQUIRE(ring_tail) == ring_size) {
+      STORE_RELEASE(ring_dropped, ring_dropped + 1);
+      return;
+    }
+    ring[head & (ring_size - 1)] = e;
+    STORE_RELEASE(ring_head, head + 1);
+  }
+}
+
+#else
+#define TRACEEVENT(kind, reason, d, b, l, s)
+#endif
+
+/*============================================================================*/
+/* PHASE TIMING                                                               */
+/*============================================================================*/
+
+#if PHASETIMING
+
+/*
+ * The time spent by yyparse() is attributed to three phases:
+ * YYPHASE_LEX (calls of yylex), YYPHASE_RECOGNIZE (item lists)
+ * and YYPHASE_WALK (the generated tree walker and the semantic actions).
+ * switch_phase() charges the time since the previous switch
+ * to the phase that was active.
+ *
+ * If PERFCOUNTERS is set (Linux only), the hardware counters
+ * cycles, instructions, cache misses and branch misses
+ * are opened as one perf_event group and are attributed in the same way.
+ * If the counters are not available (e.g. perf_event_paranoid),
+ * only the times are reported and yyphases.counters is 0.
+ * Note that each switch reads the clock (and the counters),
+ * this is done twice per token.
+ */
+
+#include <time.h>
+
+#if PERFCOUNTERS
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+struct yyphasetimes yyphases;
+
+PRIVATE int cur_phase = -1;
+PRIVATE struct timespec phase_start;
+
+#if PERFCOUNTERS
+#define NCOUNTERS 4
+
+PRIVATE int perf_fd[NCOUNTERS];
+PRIVATE int perf_state = 0; /* 0: not yet opened, 1: open, -1: failed */
+PRIVATE long long phase_counts[NCOUNTERS];
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * open the hardware counters as a group with leader perf_fd[0]
+ */
+PRIVATE open_counters() {
+  static int type[NCOUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+  };
+  struct perf_event_attr attr;
+  int k;
+
+  perf_state = 1;
+  for (k = 0; k < NCOUNTERS; k++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = type[k];
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    perf_fd[k] = syscall(__NR_perf_event_open, &attr, 0, -1,
+                         k ? perf_fd[0] : -1, 0);
+    if (perf_fd[k] < 0) {
+      while (k--) {
+        close(perf_fd[k]);
+      }
+      perf_state = -1;
+      return;
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * read the current values of the hardware counters into counts
+ */
+PRIVATE read_counters(long long *counts) {
+  long long buf[NCOUNTERS + 1];
+  int k;
+
+  if (read(perf_fd[0], buf, sizeof(buf)) != sizeof(buf)) {
+    return;
+  }
+  for (k = 0; k < NCOUNTERS; k++) {
+    counts[k] = buf[k + 1];
+  }
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * make p the active phase (-1: none)
+ * return the phase that was active before
+ */
+PRIVATE int switch_phase(int p) {
+  struct timespec now;
+  struct yyphase *ph;
+  int old;
+#if PERFCOUNTERS
+  long long counts[NCOUNTERS];
+#endif
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+#if PERFCOUNTERS
+  if (perf_state == 1) {
+    read_counters(counts);
+  }
+#endif
+
+  if (cur_phase >= 0) {
+    ph = &yyphases.phase[cur_phase];
+    ph->seconds += (now.tv_sec - phase_start.tv_sec)
+                   + (now.tv_nsec - phase_start.tv_nsec) * 1e-9;
+#if PERFCOUNTERS
+    if (perf_state == 1) {
+      ph->cycles += counts[0] - phase_counts[0];
+      ph->instructions += counts[1] - phase_counts[1];
+      ph->cache_misses += counts[2] - phase_counts[2];
+      ph->branch_misses += counts[3] - phase_counts[3];
+    }
+#endif
+  }
+
+  phase_start = now;
+#if PERFCOUNTERS
+  if (perf_state == 1) {
+    memcpy(phase_counts, counts, sizeof(counts));
+  }
+#endif
+  old = cur_phase;
+  cur_phase = p;
+  return old;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * clear the phase times and start the first phase
+ * (called at the beginning of yyparse)
+ */
+PRIVATE start_phases() {
+  static struct yyphasetimes initial;
+
+  yyphases = initial;
+#if PERFCOUNTERS
+  if (perf_state == 0) {
+    open_counters();
+  }
+  yyphases.counters = (perf_state == 1);
+#endif
+  cur_phase = -1;
+  switch_phase(YYPHASE_RECOGNIZE);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the phase times of the last parse
+ */
+PUBLIC struct yyphasetimes *yyparse_phases() {
+  return &yyphases;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the phase times of the last parse as a JSON object to f
+ */
+PUBLIC void yyprint_phases(FILE *f) {
+  static char *name[YYPHASES] = { "lex", "recognize", "walk" };
+  struct yyphase *ph;
+  int k;
+
+  fprintf(f, "{\n");
+  for (k = 0; k < YYPHASES; k++) {
+    ph = &yyphases.phase[k];
+    fprintf(f, "  \"%s\": { \"seconds\": %.6f", name[k], ph->seconds);
+    if (yyphases.counters) {
+      fprintf(f, ", \"cycles\": %lld, \"instructions\": %lld",
+              ph->cycles, ph->instructions);
+      fprintf(f, ", \"cache_misses\": %lld, \"branch_misses\": %lld",
+              ph->cache_misses, ph->branch_misses);
+    }
+    fprintf(f, " }%s\n", k < YYPHASES - 1 ? "," : "");
+  }
+  fprintf(f, "}\n");
+}
+
+#define PHASE(p) switch_phase(p)
+#else
+#define PHASE(p)
+#endif
+
 /*============================================================================*/
 /* GRAMMAR ENCODING                                                           */
 /*============================================================================*/
@@ -199,36 +738,350 @@ extern int c_length;
  * that must be incremented by term_base
  */
 
+#if GRAMMARTABLES
+
 /*============================================================================*/
-/* DIRECTOR SETS                                                              */
+/* GRAMMAR TABLES                                                             */
 /*============================================================================*/
 
-long sym;
-/* current input token */
+/*
+ * With option GRAMMARTABLES, the parser reads the grammar through a handle
+ * instead of using the arrays of 'yygrammar.c' directly.
+ * yytables_load() maps a file written by 'accent -tables' (yygrammar.tab)
+ * read-only into memory, so processes using the same grammar share its
+ * pages. yytables_use() selects the tables of the following parses
+ * (0: the tables compiled into the program).
+ *
+ * The generated tree walker belongs to the compiled grammar: the derivation
+ * of a grammar loaded from a file can only be consumed with the event
+ * stream (option EVENTSTREAM), otherwise yyparse() only recognizes.
+ * LL(2) director sets (accent -ll2) are not contained in the file.
+ *
+ * Format (native byte order, see the byte order mark):
+ *    struct tablehdr
+ *    yygrammar, yyannotation, yycoordinate: length+2 ints each
+ *    director sets: dirset_rows * dirset_columns bytes
+ *    printnames: pairs (code, offset in strings), sorted by code
+ *    strings
+ * each section starts at a multiple of 8
+ * (the header is also defined in accent's output.c)
+ */
 
-long lookaheadsym;
-/* next input token */
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define TABLEMAGIC "EGRT"
+#define TABLEVERSION 2
+#define TABLEBYTEORDER 0x01020304
+
+struct tablehdr {
+  char magic[4];
+  unsigned int version;
+  unsigned int byteorder;
+  int termbase;
+  int length;                      /* c_length */
+  int dirset_rows;                 /* rule numbers */
+  int dirset_columns;              /* token codes */
+  int name_count;
+  int reserved[2];
+  unsigned long long grammar;      /* offsets of the sections */
+  unsigned long long annotation;
+  unsigned long long coordinate;
+  unsigned long long dirsets;
+  unsigned long long names;
+  unsigned long long strings;
+  unsigned long long size;         /* of the file */
+};
+
+struct yytables {
+  int *grammar;
+  int *annotation;
+  int *coordinate;
+  int *length;
+  const unsigned char *dirsets;    /* 0: yydirset() of yygrammar.c */
+  int dirset_rows;
+  int dirset_columns;
+  const int *names;                /* 0: yyprintname() of yygrammar.c */
+  int name_count;
+  const char *strings;
+  void *map;                       /* the mapped file */
+  long map_size;
+  int length_value;
+};
+
+extern int yydirset();
+extern int yydirset2();
+extern int init_dirsets();
+
+PRIVATE struct yytables builtin_tables = {
+  yygrammar, yyannotation, yycoordinate, &c_length
+};
+
+PRIVATE struct yytables *current_tables = &builtin_tables;
+
+PRIVATE void release_grammar_tables();
+#if PROFILE
+PRIVATE void release_profile();
+#endif
 
-extern long yypos;
-/* this variable must be set by the scanner */
+/*----------------------------------------------------------------------------*/
 
-PRIVATE long lookaheadpos;
-PRIVATE char * lookaheadtokenname;
+/*
+ * returns 0 if the section does not lie within the file
+ */
+PRIVATE int valid_section(struct tablehdr *h, unsigned long long offset,
+                          unsigned long long size) {
+  return offset % 8 == 0 && offset >= sizeof(struct tablehdr) &&
+         offset <= h->size && size <= h->size - offset;
+}
 
-/*============================================================================*/
-/* PRINT ROUTINES                                                             */
-/*============================================================================*/
+/*----------------------------------------------------------------------------*/
 
 /*
- * print the item with index p
+ * map the tables in file 'path'
+ * returns 0 if the file cannot be mapped or has not been written
+ * by 'accent -tables' (for this version and byte order)
  */
-PRIVATE print_item(int p) {
-  int i, b, e, l, k;
-  i = dot[p];
-
-  printf(" %d: ", p);
-  if (dot[p] == 0 && sub[p] == 0) {
-    printf("[ separator-item ]\n");
+PUBLIC struct yytables *yytables_load(const char *path) {
+  struct yytables *t;
+  struct tablehdr *h;
+  struct stat st;
+  char *p;
+  long arraysize, i;
+  int fd, ok, v;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  if (fstat(fd, &st) != 0 || st.st_size < (long) sizeof(struct tablehdr)) {
+    close(fd);
+    return 0;
+  }
+  p = (char *) mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    return 0;
+  }
+
+  h = (struct tablehdr *) p;
+  arraysize = ((long) h->length + 2) * sizeof(int);
+  ok = memcmp(h->magic, TABLEMAGIC, 4) == 0 &&
+       h->version == TABLEVERSION && h->byteorder == TABLEBYTEORDER &&
+       h->termbase == term_base && h->size == st.st_size &&
+       h->length > 0 && h->dirset_rows >= 0 && h->dirset_columns >= 0 &&
+       h->name_count >= 0 &&
+       valid_section(h, h->grammar, arraysize) &&
+       valid_section(h, h->annotation, arraysize) &&
+       valid_section(h, h->coordinate, arraysize) &&
+       valid_section(h, h->dirsets,
+                     (long) h->dirset_rows * h->dirset_columns) &&
+       valid_section(h, h->names, 2L * h->name_count * sizeof(int)) &&
+       valid_section(h, h->strings, h->size - h->strings) &&
+       (h->name_count == 0 || p[h->size - 1] == 0);
+  for (i = 0; ok && i < h->length + 2; i++) {
+    /* references to the grammar, rule numbers and tokens */
+    v = ((int *) (p + h->grammar))[i];
+    ok = (v >= -h->length - 1 && v <= h->length + 1) ||
+         (v >= term_base && v < 2 * term_base);
+  }
+  for (i = 0; ok && i < h->name_count; i++) {
+    ok = ((int *) (p + h->names))[2 * i + 1] >= 0 &&
+         ((int *) (p + h->names))[2 * i + 1] < h->size - h->strings;
+  }
+  if (! ok) {
+    munmap(p, st.st_size);
+    return 0;
+  }
+
+  t = (struct yytables *) yymemalloc(sizeof(struct yytables));
+  if (! t) {
+    yymallocerror();
+  }
+  t->grammar = (int *) (p + h->grammar);
+  t->annotation = (int *) (p + h->annotation);
+  t->coordinate = (int *) (p + h->coordinate);
+  t->length_value = h->length;
+  t->length = &t->length_value;
+  t->dirsets = (const unsigned char *) (p + h->dirsets);
+  t->dirset_rows = h->dirset_rows;
+  t->dirset_columns = h->dirset_columns;
+  t->names = (const int *) (p + h->names);
+  t->name_count = h->name_count;
+  t->strings = p + h->strings;
+  t->map = p;
+  t->map_size = st.st_size;
+  return t;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * parse with the tables 't' from now on (0: the compiled tables)
+ */
+PUBLIC void yytables_use(struct yytables *t) {
+  if (! t) {
+    t = &builtin_tables;
+  }
+  if (t != current_tables) {
+    /* tables computed from the previous grammar */
+    release_grammar_tables();
+#if PROFILE
+    release_profile();
+#endif
+    current_tables = t;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * unmap the tables 't'
+ */
+PUBLIC void yytables_unload(struct yytables *t) {
+  if (! t) {
+    return;
+  }
+  if (t == current_tables) {
+    yytables_use(0);
+  }
+  munmap(t->map, t->map_size);
+  yymemfree(t);
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE int table_dirset(int rule, int token) {
+  struct yytables *t = current_tables;
+
+  if (! t->dirsets) {
+    return yydirset(rule, token);
+  }
+  if ((unsigned) rule >= (unsigned) t->dirset_rows ||
+      (unsigned) token >= (unsigned) t->dirset_columns) {
+    return 0;
+  }
+  return t->dirsets[rule * t->dirset_columns + token];
+}
+
+/*----------------------------------------------------------------------------*/
+
+#if LOOKAHEAD2
+PRIVATE int table_dirset2(int rule, int a, int b) {
+  if (! current_tables->dirsets) {
+    return yydirset2(rule, a, b);
+  }
+  return 1;
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void table_init_dirsets() {
+  if (! current_tables->dirsets) {
+    init_dirsets();
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * the printname of grammar symbol 'n' in the tables 't'
+ * (0: the compiled tables), e.g. of the nonterminal of an event
+ */
+PUBLIC char *yytables_printname(struct yytables *t, int n) {
+  int lo, hi, mid;
+
+  if (! t) {
+    t = &builtin_tables;
+  }
+  if (! t->names) {
+    return yyprintname(n);
+  }
+  lo = 0;
+  hi = t->name_count - 1;
+  while (lo <= hi) {
+    mid = (lo + hi) / 2;
+    if (t->names[2 * mid] == n) {
+      return (char *) t->strings + t->names[2 * mid + 1];
+    }
+    if (t->names[2 * mid] < n) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return "special_character";
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE char *table_printname(int n) {
+  return yytables_printname(current_tables, n);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* from here on, the grammar is accessed through the current tables */
+
+#define yygrammar (current_tables->grammar)
+#define yyannotation (current_tables->annotation)
+#define yycoordinate (current_tables->coordinate)
+#define c_length (*current_tables->length)
+#define yydirset(rule, token) table_dirset(rule, token)
+#define yydirset2(rule, a, b) table_dirset2(rule, a, b)
+#define init_dirsets() table_init_dirsets()
+#define yyprintname(n) table_printname(n)
+
+#endif
+
+/*============================================================================*/
+/* DIRECTOR SETS                                                              */
+/*============================================================================*/
+
+long sym;
+/* current input token */
+
+long lookaheadsym;
+/* next input token */
+
+#if PARALLELWALK
+/* each thread of the parallel walk has its own cursors */
+#define THREADLOCAL __thread
+#else
+#define THREADLOCAL
+#endif
+
+extern long yypos;
+/* this variable must be set by the scanner */
+
+PRIVATE long lookaheadpos;
+PRIVATE char * lookaheadtokenname;
+
+#if LOOKAHEAD2
+PRIVATE long lookaheadsym2;
+/* token after 'lookaheadsym' (EOF if 'lookaheadsym' is EOF) */
+
+PRIVATE long lookaheadpos2;
+#endif
+
+/*============================================================================*/
+/* PRINT ROUTINES                                                             */
+/*============================================================================*/
+
+/*
+ * print the item with index p
+ */
+PRIVATE print_item(int p) {
+  int i, b, e, l, k;
+  i = dot[p];
+
+  printf(" %d: ", p);
+  if (dot[p] == 0 && sub[p] == 0) {
+    printf("[ separator-item ]\n");
     return;
   }
   if (i <= 5) {
@@ -295,1173 +1148,5177 @@ PRIVATE print_coordinate(int i) {
 /*----------------------------------------------------------------------------*/
 
 /*
- * print tree for item with index i
+ * stack for the non-recursive traversals of item trees
+ * (print_tree, test_for_cycle)
  */
-PRIVATE print_tree(int i) {
-  static int indent = 0;
-  int k;
+PRIVATE long *trav_stack = 0;
+PRIVATE long trav_limit = 0;
 
-  /* rule number if item at end of rule */
-  if (yygrammar[dot[i]] < 0) {
-    /* end of rule */
-    for (k = 1; k <= indent; k++) {
-      printf("  ");
+#define TRAVINCR 1000
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * push n onto the traversal stack
+ * *ref_sp is the number of entries
+ */
+PRIVATE trav_push(long *ref_sp, long n) {
+  if (*ref_sp == trav_limit) {
+    trav_limit += TRAVINCR;
+    trav_stack = (long *) yymemrealloc(trav_stack, trav_limit * sizeof(long));
+    if (! trav_stack) {
+      yymallocerror();
     }
-    printf("%s alternative at ", yyprintname(-yygrammar[dot[i]]));
-    print_coordinate(dot[i] + 1);
-    printf(" {\n");
-    indent++;
   }
+  trav_stack[(*ref_sp)++] = n;
+}
 
-  /* left brothers */
+/*----------------------------------------------------------------------------*/
 
-  if (left[i]) {
-    print_tree(left[i]);
-  }
+/*
+ * print tree for item with index i
+ *
+ * the traversal stack holds pairs < item, state >, where state is
+ * 0: item not yet visited, 1: left brothers printed, 2: subtree printed
+ */
+PRIVATE print_tree(int root) {
+  int indent = 0;
+  long sp = 0;
+  long i, state;
+  int k;
+
+  trav_push(&sp, root);
+  trav_push(&sp, 0);
+  while (sp) {
+    state = trav_stack[--sp];
+    i = trav_stack[--sp];
 
-  /* this son */
+    if (state == 0) {
+      /* rule number if item at end of rule */
+      if (yygrammar[dot[i]] < 0) {
+        /* end of rule */
+        for (k = 1; k <= indent; k++) {
+          printf("  ");
+        }
+        printf("%s alternative at ", yyprintname(-yygrammar[dot[i]]));
+        print_coordinate(dot[i] + 1);
+        printf(" {\n");
+        indent++;
+      }
 
-  if (left[i]) {
-    int sym = yygrammar[dot[i] - 1];
+      /* left brothers */
 
-    if (sym > term_base) {
-      for (k = 1; k <= indent; k++) {
-        printf("  ");
+      trav_push(&sp, i);
+      trav_push(&sp, 1);
+      if (left[i]) {
+        trav_push(&sp, left[i]);
+        trav_push(&sp, 0);
       }
-      if (sym < term_base + max_char + 1) {
-        printf("'%c'\n", yygrammar[dot[i] - 1] - term_base);
-      } else {
-        printf("%s\n", yyprintname(sym));
+
+    } else if (state == 1) {
+      /* this son */
+
+      if (left[i]) {
+        int sym = yygrammar[dot[i] - 1];
+
+        if (sym > term_base) {
+          for (k = 1; k <= indent; k++) {
+            printf("  ");
+          }
+          if (sym < term_base + max_char + 1) {
+            printf("'%c'\n", yygrammar[dot[i] - 1] - term_base);
+          } else {
+            printf("%s\n", yyprintname(sym));
+          }
+        }
       }
-    }
-  }
 
-  /* subtree for this son */
+      /* subtree for this son */
 
-  if (sub[i]) {
-    print_tree(sub[i]);
-  }
+      trav_push(&sp, i);
+      trav_push(&sp, 2);
+      if (sub[i]) {
+        trav_push(&sp, sub[i]);
+        trav_push(&sp, 0);
+      }
 
-  if (yygrammar[dot[i]] < 0) {
-    /* end of rule */
-    indent--;
-    for (k = 1; k <= indent; k++) {
-      printf("  ");
+    } else {
+      if (yygrammar[dot[i]] < 0) {
+        /* end of rule */
+        indent--;
+        for (k = 1; k <= indent; k++) {
+          printf("  ");
+        }
+        printf("}\n");
+      }
     }
-    printf("}\n");
   }
 }
 
 /*============================================================================*/
-/* DIRECTOR SETS                                                              */
+/* GRAMMAR PROFILE                                                            */
 /*============================================================================*/
 
+#if PROFILE
+
 /*
- * Let 'rule' be the rule be the rule into which 'ruleptr' points.
- * Let 'tkn' be the code of the next token.
- * Return ('tkn' is in the director set of 'rule').
+ * If PROFILE is set, the work of the recognizer is attributed
+ * to the grammar positions (dots) that cause it:
+ *
+ * prof_items[D]        items with dot D added to an item list
+ * prof_completions[D]  completer calls for items with dot D (end of rule)
+ * prof_scans[D]        items of earlier lists inspected by these calls
+ * prof_ambiguities[D]  ambiguities detected for items with dot D
+ *
+ * The counters are accumulated over all calls of yyparse()
+ * until yyprofile_reset() is called.
+ * yyprint_profile() reports them per rule, sorted by cost
+ * (items + scans), with the coordinates from 'yycoordinate'.
  */
-PRIVATE int lookup_dirset(long ruleptr) {
-  int p;
-  int rule;
-  int tkn;
-
-  /* find rule number */
-  p = ruleptr;
-  while (yygrammar[p] >= 0) {
-    p++;
-  }
-  p++;
-  rule = yygrammar[p];
 
-  tkn = lookaheadsym - term_base;
+PRIVATE long *prof_items = 0;
+PRIVATE long *prof_completions;
+PRIVATE long *prof_scans;
+PRIVATE long *prof_ambiguities;
 
-  return yydirset(rule, tkn);
-}
+#define PROFILECOUNT(table, d) prof_##table[d]++
+#define PROFILECOUNTN(table, d, n) prof_##table[d] += (n)
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * d is a pointer into the encoded grammar
- * Returns true if the the symbol yygrammar[d] (token or nonterminal)
- * is a valid continuation of the parse:
- * can it start with the current lookahead token?
- * If the symbol is a token it is compared with the lookahead token
- * If symbol is a nonterminal it is checked whether the lookahead token
- * appears in the director sets of the rules for the nonterm of the symbol
- *
- * NOTE: the union of the director sets should be computed statically
+ * allocate the counters (if not yet done)
  */
-PRIVATE int is_viable(int d) {
-  if (yygrammar[d] >= term_base) {
-    /* token */
-    if (yygrammar[d] == lookaheadsym) {
-      return 1;
-    } else {
-      return 0;
-    }
-  } else if (yygrammar[d] > 0) {
-    /* nonterm */
-
-    int start;
+PRIVATE init_profile() {
+  if (prof_items) {
+    return;
+  }
+  prof_items = (long *) zalloc((c_length + 2) * sizeof(long));
+  prof_completions = (long *) zalloc((c_length + 2) * sizeof(long));
+  prof_scans = (long *) zalloc((c_length + 2) * sizeof(long));
+  prof_ambiguities = (long *) zalloc((c_length + 2) * sizeof(long));
+  if (! prof_items || ! prof_completions || ! prof_scans ||
+      ! prof_ambiguities) {
+    yymallocerror();
+  }
+}
 
-    start = yygrammar[d];
-    /* start points to the first rule for the nonterm */
-    do {
-      int p;
-      int rule;
+/*----------------------------------------------------------------------------*/
 
-      p = start + 1;
-      while (yygrammar[p] >= 0) {
-        p++;
-      }
-      /* p now points to negative lhs encoding */
-      rule = yygrammar[p + 1];
-      if (yydirset(rule, lookaheadsym - term_base)) {
-        return 1;
-      }
-      start = yygrammar[start];
-    } while (start);
+/*
+ * clear all counters
+ */
+PUBLIC void yyprofile_reset() {
+  int d;
 
-    return 0;
-  } else {
-    /* end of rule */
-    return 1;
+  if (! prof_items) {
+    return;
+  }
+  for (d = 0; d < c_length + 2; d++) {
+    prof_items[d] = 0;
+    prof_completions[d] = 0;
+    prof_scans[d] = 0;
+    prof_ambiguities[d] = 0;
   }
 }
 
-/*============================================================================*/
-/* ERROR MESSAGES                                                             */
-/*============================================================================*/
+#if GRAMMARTABLES
+/*----------------------------------------------------------------------------*/
 
-int posforerrormsg = 0;
 /*
- * Report syntax error and terminate
+ * drop the counters (their size depends on the grammar)
  */
-PRIVATE syntaxerror() {
-  yypos = posforerrormsg;
-  yyerror("syntax error");
-  exit(1);
+PRIVATE void release_profile() {
+  if (! prof_items) {
+    return;
+  }
+  yymemfree(prof_items);
+  yymemfree(prof_completions);
+  yymemfree(prof_scans);
+  yymemfree(prof_ambiguities);
+  prof_items = prof_completions = prof_scans = prof_ambiguities = 0;
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+struct rule_profile {
+  int start;   /* index of the first member */
+  int end;     /* index of the negative lhs encoding */
+  long items, scans, ambiguities;
+};
+
+PRIVATE int by_cost(const void *p1, const void *p2) {
+  const struct rule_profile *r1 = p1, *r2 = p2;
+  long c1 = r1->items + r1->scans, c2 = r2->items + r2->scans;
+
+  return c1 < c2 ? 1 : c1 > c2 ? -1 : r1->start - r2->start;
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * emit msg and terminate
+ * print the coordinate of grammar position i to f
  */
-PRIVATE Abort(char *msg) {
-  printf("%s\n", msg);
-  exit(1);
+PRIVATE fprint_coordinate(FILE *f, int i) {
+  fprintf(f, "line %d, col %d of grammar",
+          yycoordinate[i] / 1000, yycoordinate[i] % 1000);
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * item table full
+ * write the profile to f:
+ * one entry per rule (with its cost) sorted by cost,
+ * followed by the dot positions of the rule that have been used
  */
-PRIVATE table_full() {
-#if DYNAMICITEMS
-  ITEMLIMIT += ITEMINCR;
+PUBLIC void yyprint_profile(FILE *f) {
+  struct rule_profile *rules;
+  long total;
+  int n, p, q, d, k;
 
-  dot = (long *) realloc(dot, ITEMLIMIT * sizeof(long));
-  if (! dot) {
-    yymallocerror();
+  if (! prof_items) {
+    fprintf(f, "no profile\n");
+    return;
   }
-  back = (long *) realloc(back, ITEMLIMIT * sizeof(long));
-  if (! back) {
+
+  /* rule i occupies: chain, members, negative lhs, rule number */
+  rules = (struct rule_profile *)
+          yymemalloc((c_length / 3 + 1) * sizeof(struct rule_profile));
+  if (! rules) {
     yymallocerror();
   }
-  left = (long *) realloc(left, ITEMLIMIT * sizeof(long));
-  if (! left) {
-    yymallocerror();
+  n = 0;
+  total = 0;
+  p = 1;
+  while (p <= c_length) {
+    q = p + 1;
+    while (yygrammar[q] > 0) {
+      q++;
+    }
+    rules[n].start = p + 1;
+    rules[n].end = q;
+    rules[n].items = 0;
+    rules[n].ambiguities = 0;
+    for (d = p + 1; d <= q; d++) {
+      rules[n].items += prof_items[d];
+      rules[n].ambiguities += prof_ambiguities[d];
+    }
+    rules[n].scans = prof_scans[q];
+    total += rules[n].items + rules[n].scans;
+    n++;
+    p = q + 2;
   }
-  sub = (long *) realloc(sub, ITEMLIMIT * sizeof(long));
-  if (! sub) {
-    yymallocerror();
-  }
-#else
-  Abort("fatal error: item table overflow [increase ITEMLIMIT in art.c]\n");
-#endif
-}
+  qsort(rules, n, sizeof(struct rule_profile), by_cost);
 
-/*----------------------------------------------------------------------------*/
+  fprintf(f, "GRAMMAR PROFILE (cost = items + completer scans)\n\n");
+  for (k = 0; k < n; k++) {
+    struct rule_profile *r = &rules[k];
+    long cost = r->items + r->scans;
 
-PUBLIC yymallocerror() {
-  printf("running out of memory\n");
-  exit(1);
+    if (cost == 0) {
+      break;
+    }
+    fprintf(f, "%5.1f%%  %s alternative at ",
+            total ? 100.0 * cost / total : 0.0,
+            yyprintname(-yygrammar[r->end]));
+    fprint_coordinate(f, r->end + 1);
+    fprintf(f, "\n");
+    fprintf(f, "        items %ld, completions %ld, scans %ld, "
+            "ambiguities %ld\n",
+            r->items, prof_completions[r->end], r->scans, r->ambiguities);
+
+    for (d = r->start; d <= r->end; d++) {
+      if (prof_items[d] == 0 && prof_ambiguities[d] == 0) {
+        continue;
+      }
+      if (d == r->end) {
+        fprintf(f, "        at end");
+      } else if (yygrammar[d] == eofsym) {
+        fprintf(f, "        before EOF");
+      } else if (yygrammar[d] > term_base + max_char) {
+        fprintf(f, "        before %s", yyprintname(yygrammar[d]));
+      } else if (yygrammar[d] > term_base) {
+        fprintf(f, "        before '%c'", yygrammar[d] - term_base);
+      } else {
+        fprintf(f, "        before %s at ", yyprintname(yygrammar[d]));
+        fprint_coordinate(f, d);
+      }
+      fprintf(f, ": items %ld", prof_items[d]);
+      if (prof_ambiguities[d]) {
+        fprintf(f, ", ambiguities %ld", prof_ambiguities[d]);
+      }
+      fprintf(f, "\n");
+    }
+    fprintf(f, "\n");
+  }
+  yymemfree(rules);
 }
 
+#else
+#define PROFILECOUNT(table, d)
+#define PROFILECOUNTN(table, d, n)
+#endif
+
 /*============================================================================*/
-/* SEARCH OPTIMISATION                                                        */
+/* TIMELINE                                                                   */
 /*============================================================================*/
 
-#define HSIZE 1024
+#if TIMELINE
 
-#define HASHCODE (b%8+d)%HSIZE
+/*
+ * If TIMELINE is set, an entry is recorded for each item list
+ * (i.e. for each token of the input):
+ * the position of the token (yypos as set by the scanner),
+ * the number of items and completer calls
+ * and the time needed to read the token and compute the list.
+ * The timeline of the last parse can be written as CSV or in binary form
+ * to find the regions of the input for which the item lists grow.
+ */
 
-#if HASHING
+#include <time.h>
+
+#define TIMELINEINCR 10000
+
+PRIVATE struct yytimeline_entry *timeline = 0;
+PRIVATE long timeline_length;
+PRIVATE long timeline_limit = 0;
+PRIVATE long tl_completions;
+PRIVATE struct timespec tl_last;
+
+/*----------------------------------------------------------------------------*/
 
 /*
- * hash table to speed up lookup-function
- * if an item with back pointer b and dot d is entered
- * into the current item list
- * an entry with a corresponding hash code is set
+ * start a new timeline (called at the beginning of yyparse)
  */
-int hash[HSIZE];
+PRIVATE start_timeline() {
+  timeline_length = 0;
+  tl_completions = 0;
+  clock_gettime(CLOCK_MONOTONIC, &tl_last);
+}
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * clear hash table
+ * the closure of the current item list has been computed:
+ * append an entry for it
  */
-PRIVATE int clearhash() {
-  int i;
-
-  for (i = 0; i < HSIZE; i++) {
-    hash[i] = 0;
+PRIVATE record_itemlist(long token, long pos) {
+  struct yytimeline_entry *e;
+  struct timespec now;
+
+  if (timeline_length == timeline_limit) {
+    timeline_limit += TIMELINEINCR;
+    timeline = (struct yytimeline_entry *)
+               yymemrealloc(timeline,
+                       timeline_limit * sizeof(struct yytimeline_entry));
+    if (! timeline) {
+      yymallocerror();
+    }
   }
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  e = &timeline[timeline_length];
+  e->list = timeline_length;
+  e->token = token;
+  e->pos = pos;
+  e->items = last_item - thislist + 1;
+  e->completions = tl_completions;
+  e->nanoseconds = (now.tv_sec - tl_last.tv_sec) * 1000000000LL
+                   + (now.tv_nsec - tl_last.tv_nsec);
+  timeline_length++;
+
+  tl_completions = 0;
+  tl_last = now;
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * true if there is an entry entry for item with dot d and backpointer b
+ * return the timeline of the last parse,
+ * *ref_length is set to the number of entries
  */
-PRIVATE int hashed(int d, int b) {
-  return hash[HASHCODE];
+PUBLIC struct yytimeline_entry *yyparse_timeline(long *ref_length) {
+  *ref_length = timeline_length;
+  return timeline;
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * set entry for item with dot d and backpointer b
+ * write the timeline of the last parse as CSV to f
  */
-PRIVATE sethash(int d, int b) {
-  hash[HASHCODE] = 1;
+PUBLIC void yywrite_timeline_csv(FILE *f) {
+  struct yytimeline_entry *e;
+  long k;
+
+  fprintf(f, "list,token,pos,items,completions,nanoseconds\n");
+  for (k = 0; k < timeline_length; k++) {
+    e = &timeline[k];
+    fprintf(f, "%ld,%ld,%ld,%ld,%ld,%lld\n",
+            e->list, e->token, e->pos, e->items, e->completions,
+            e->nanoseconds);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the timeline of the last parse in binary form to f:
+ * the 4 bytes "YYTL", the entry size and the number of entries (as long),
+ * followed by the entries (struct yytimeline_entry, native byte order)
+ */
+PUBLIC void yywrite_timeline_binary(FILE *f) {
+  long header[2];
+
+  header[0] = sizeof(struct yytimeline_entry);
+  header[1] = timeline_length;
+  fwrite("YYTL", 1, 4, f);
+  fwrite(header, sizeof(long), 2, f);
+  fwrite(timeline, sizeof(struct yytimeline_entry), timeline_length, f);
 }
+
 #endif
 
 /*============================================================================*/
-/* TOKENS                                                                     */
+/* LIMITS                                                                     */
 /*============================================================================*/
 
+#if LIMITS
+
 /*
- * read next token
- * current token: 'sym'
- * following token: 'lookaheadsym'
- * extend the list of lexical values by calling
- * next_lexval() provided by 'yygrammar.c'
+ * If LIMITS is set, the resources used by the recognizer can be limited
+ * (see yyset_limits):
+ * the number of items, the size of the item table,
+ * the elapsed time, and a cancellation flag set by another thread.
+ *
+ * additem() compares last_item with 'next_check'. When it is reached,
+ * check_limits() tests the item budget, the deadline and the flag,
+ * and sets the next checkpoint CHECKINTERVAL items ahead
+ * (or at the item budget, if that is closer).
+ * The deadline and the flag are also tested after each item list.
+ * The item table is allocated and extended up to 'max_bytes'
+ * (the first table is smaller than usual if needed),
+ * the limit is exceeded if the full table cannot be extended.
+ *
+ * If a limit is exceeded, the parse is abandoned with longjmp,
+ * the memory of the parser is released and yyparse() returns YYPARSE_LIMIT.
  */
-PRIVATE readsym() {
-  long oldpos;
 
-  sym = lookaheadsym;
-  oldpos = lookaheadpos;
-  posforerrormsg = lookaheadpos;
+#include <setjmp.h>
+#include <time.h>
 
-  if (lookaheadsym != 50000 /*EOF*/) {
-    lookaheadsym = yylex() + term_base;
-    lookaheadpos = yypos;
-  }
-  next_lexval();
-  /*
-  yypos = oldpos;
-  */
-}
+#define CHECKINTERVAL 4096
 
-/*============================================================================*/
-/* GRAMMAR                                                                    */
-/*============================================================================*/
+PRIVATE struct yylimits limits;
+PRIVATE long next_check;
+PRIVATE struct timespec deadline;
+PRIVATE int limit_exceeded;
+PRIVATE jmp_buf limit_env;
 
+/*----------------------------------------------------------------------------*/
 
+/*
+ * set the limits for the following parses (0: no limits)
+ */
+PUBLIC void yyset_limits(struct yylimits *l) {
+  static struct yylimits none;
 
-/* subptr points to an item */
-/* return the prio of corresponding rule */
-PRIVATE int getprio(int subptr) {
-  int i;
+  limits = l ? *l : none;
+}
 
-  /* find end of rule */
-  i = dot[subptr];
-  while (yygrammar[i] > 0) {
-    i++;
-  }
-  /* i points to the negative lhs encoding */
-  i++;
-  /* i now points to the rule number, this is also the index of the prio */
+/*----------------------------------------------------------------------------*/
 
-  return yyannotation[i];
+/*
+ * return the limit that caused the last parse to be abandoned
+ * (YYLIMIT_...) or 0
+ */
+PUBLIC int yyparse_limit() {
+  return limit_exceeded;
 }
 
 /*----------------------------------------------------------------------------*/
 
-/* i is the index of a member */
-/* return the annotation of the member before the dot */
-PRIVATE int getmemberannotation(int i) {
-  int grammarindex, annotation;
-
-  grammarindex = dot[i] - 1;
-  annotation = yyannotation[grammarindex];
-  return annotation;
+/*
+ * abandon the parse
+ */
+PRIVATE exceed_limit(int reason) {
+  limit_exceeded = reason;
+  longjmp(limit_env, 1);
 }
 
-/*============================================================================*/
-/* AMBIGUITY RESOLUTION                                                       */
-/*============================================================================*/
+/*----------------------------------------------------------------------------*/
 
 /*
- * return true if
- * the tree to which 'container' (a "subpointer" of an item) points
- * contains the tree to which 'subtree' (also a "subpointer") points
+ * compute the deadline and the first checkpoint
+ * (called at the beginning of yyparse)
  */
-PRIVATE int test_for_cycle(int subtree, int container) {
-  if (container < subtree) {
-    /* an earlier item cannot refer a later one */
-    return 0;
+PRIVATE start_limits() {
+  limit_exceeded = 0;
+  if (limits.max_seconds > 0) {
+    long ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    ns = (long) ((limits.max_seconds - (long) limits.max_seconds) * 1e9);
+    deadline.tv_sec += (long) limits.max_seconds;
+    deadline.tv_nsec += ns;
+    if (deadline.tv_nsec >= 1000000000) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000;
+    }
   }
-  if (container == subtree) {
-    return 1;
+  next_check = CHECKINTERVAL;
+  if (limits.max_items > 0 && limits.max_items < next_check) {
+    next_check = limits.max_items;
   }
-  if (sub[container]) {
-    if (test_for_cycle(subtree, sub[container])) {
-      return 1;
-    }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * test the deadline and the cancellation flag
+ */
+PRIVATE check_time() {
+  struct timespec now;
+
+  if (limits.cancel && *limits.cancel) {
+    exceed_limit(YYLIMIT_CANCELLED);
   }
-  if (left[container]) {
-    if (test_for_cycle(subtree, left[container])) {
-      return 1;
+  if (limits.max_seconds > 0) {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec > deadline.tv_sec ||
+        (now.tv_sec == deadline.tv_sec && now.tv_nsec >= deadline.tv_nsec)) {
+      exceed_limit(YYLIMIT_DEADLINE);
     }
   }
-  return 0;
 }
 
 /*----------------------------------------------------------------------------*/
 
-
 /*
- * The item with index i
- * and an item with dot d, leftpointer l, and subpointer s
- * introduce a conjunctive ambiguity
+ * the checkpoint 'next_check' has been reached
  */
-PRIVATE conjunctive_ambiguity(int i, int d, int l, int s) {
-  if (left[i] != l) {
+PRIVATE check_limits() {
+  if (limits.max_items > 0 && last_item >= limits.max_items) {
+    exceed_limit(YYLIMIT_ITEMS);
+  }
+  check_time();
 
-    /* Conjunctive Ambiguity */
+  next_check = last_item + CHECKINTERVAL;
+  if (limits.max_items > 0 && limits.max_items < next_check) {
+    next_check = limits.max_items;
+  }
+}
 
-    int left1, left2, sub1, sub2, annotation;
-    int selected_left, selected_sub;
+/*----------------------------------------------------------------------------*/
 
-    left1 = left[i];
-    sub1 = sub[i];
+/*
+ * the item table is to be allocated or extended to n items,
+ * return n or the smaller size allowed by 'max_bytes',
+ * the table must hold at least 'min' items
+ */
+PRIVATE long check_table(long n, long min) {
+  long columns = 4;
+  long max;
 
-    left2 = l;
-    sub2 = s;
+#if SPPF
+  columns = 5;
+#endif
+  if (limits.max_bytes > 0) {
+    max = limits.max_bytes / (columns * sizeof(long));
+    if (max < min) {
+      exceed_limit(YYLIMIT_BYTES);
+    }
+    if (n > max) {
+      n = max;
+    }
+  }
+  return n;
+}
 
-    annotation = getmemberannotation(i);
+#endif
 
-    if (annotation == 1) {
-      /* %short */
+/*============================================================================*/
+/* DIRECTOR SETS                                                              */
+/*============================================================================*/
 
-      if (left1 > left2) {
-        selected_left = left1;
-        selected_sub = sub1;
-      } else {
-        selected_left = left2;
-        selected_sub = sub2;
-      }
-    } else if (annotation == 2) {
-      /* %long */
+/*
+ * Let 'rule' be the rule be the rule into which 'ruleptr' points.
+ * Let 'tkn' be the code of the next token.
+ * Return ('tkn' is in the director set of 'rule').
+ * If LOOKAHEAD2 is set, the token following 'tkn' must also match
+ * the LL(2) director set of 'rule' (grammar processed with accent -ll2).
+ */
+PRIVATE int lookup_dirset(long ruleptr) {
+  int p;
+  int rule;
+  int tkn;
 
-      if (left2 > left1) {
-        selected_left = left1;
-        selected_sub = sub1;
-      } else {
-        selected_left = left2;
-        selected_sub = sub2;
-      }
-    } else if (annotation == 0) {
-      /* annotation == undef */
+  /* find rule number */
+  p = ruleptr;
+  while (yygrammar[p] >= 0) {
+    p++;
+  }
+  p++;
+  rule = yygrammar[p];
 
-      int old_sub, old_left;
+  tkn = lookaheadsym - term_base;
 
-      printf("\n");
-      printf("GRAMMAR DEBUG INFORMATION\n");
-      printf("\n");
-      printf("Grammar ambiguity detected.\n");
+#if LOOKAHEAD2
+  return yydirset(rule, tkn) &&
+         yydirset2(rule, tkn, lookaheadsym2 - term_base);
+#else
+  return yydirset(rule, tkn);
+#endif
+}
 
-      {
-        int k;
-        k = dot[i];
-        while (yygrammar[k] > 0) {
-          k++;
-        }
-        printf("There are two different parses\n");
-        printf("for the beginning of ``%s'', alternative at ",
-               yyprintname(-yygrammar[k]));
-        print_coordinate(k + 1);
-        printf(",\n");
-      }
-      printf("upto and containing ``%s'' at ", yyprintname(yygrammar[d - 1]));
-      print_coordinate(d - 1);
-      printf(".\n");
+/*----------------------------------------------------------------------------*/
 
-      printf("\n");
-      printf("PARSE 1\n");
-      printf("-------\n");
-      printf("\n");
-      print_tree(i);
+/*
+ * d is a pointer into the encoded grammar
+ * Returns true if the the symbol yygrammar[d] (token or nonterminal)
+ * is a valid continuation of the parse:
+ * can it start with the current lookahead token?
+ * If the symbol is a token it is compared with the lookahead token
+ * If symbol is a nonterminal it is checked whether the lookahead token
+ * appears in the director sets of the rules for the nonterm of the symbol
+ *
+ * NOTE: the union of the director sets should be computed statically
+ */
+PRIVATE int is_viable(int d) {
+  if (yygrammar[d] >= term_base) {
+    /* token */
+    if (yygrammar[d] == lookaheadsym) {
+      return 1;
+    } else {
+      return 0;
+    }
+  } else if (yygrammar[d] > 0) {
+    /* nonterm */
 
-      printf("\n");
-      printf("PARSE 2\n");
-      printf("-------\n");
-      printf("\n");
-      print_tree(last_item + 1);
+    int start;
 
-      printf("\n");
-      printf("For ``%s'' at ", yyprintname(yygrammar[d - 1]));
-      print_coordinate(d - 1);
-      printf(",\n");
-      if (left1 > left2) {
-        printf("use %%short annotation to select first parse,\n");
-        printf("use %%long annotation to select second parse.\n");
-      } else {
-        printf("use %%long annotation to select first parse,\n");
-        printf("use %%short annotation to select second parse.\n");
+    start = yygrammar[d];
+    /* start points to the first rule for the nonterm */
+    do {
+      int p;
+      int rule;
+
+      p = start + 1;
+      while (yygrammar[p] >= 0) {
+        p++;
+      }
+      /* p now points to negative lhs encoding */
+      rule = yygrammar[p + 1];
+#if LOOKAHEAD2
+      if (yydirset(rule, lookaheadsym - term_base) &&
+          yydirset2(rule, lookaheadsym - term_base,
+                    lookaheadsym2 - term_base)) {
+        return 1;
+      }
+#else
+      if (yydirset(rule, lookaheadsym - term_base)) {
+        return 1;
       }
+#endif
+      start = yygrammar[start];
+    } while (start);
 
-      printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
-      yypos = posforerrormsg;
-      yyerror("source text uncovers unhandled grammar ambiguity");
-      exit(1);
+    return 0;
+  } else {
+    /* end of rule */
+    return 1;
+  }
+}
 
-      selected_left = l;
-      selected_sub = s;
-    } else {
-      /* user -N */
-      int r;
+/*============================================================================*/
+/* ERROR MESSAGES                                                             */
+/*============================================================================*/
 
-      if (left1 > left2) {
-        r = confilter(-annotation, i, last_item + 1);
+int posforerrormsg = 0;
+/*
+ * Report syntax error and terminate
+ */
+PRIVATE syntaxerror() {
+  yypos = posforerrormsg;
+  yyerror("syntax error");
+  exit(1);
+}
 
-        if (r == 1) {
-          /* %short */
-          selected_left = left1;
-          selected_sub = sub1;
-        } else if (r == 2) {
-          /* %long */
-          selected_left = left2;
-          selected_sub = sub2;
-        } else {
-          printf("user function `confilter' returns invalid value\n");
-          exit(1);
-        }
-      } else {
-        r = confilter(-annotation, last_item + 1, i);
+/*----------------------------------------------------------------------------*/
 
-        if (r == 2) {
-          /* %long */
-          selected_left = left1;
-          selected_sub = sub1;
-        } else if (r == 1) {
-          /* %short */
-          selected_left = left2;
-          selected_sub = sub2;
-        } else {
-          printf("user function `confilter' returns invalid value\n");
-          exit(1);
-        }
-      }
+/*
+ * emit msg and terminate
+ */
+PRIVATE Abort(char *msg) {
+  printf("%s\n", msg);
+  exit(1);
+}
 
-    }
+/*----------------------------------------------------------------------------*/
 
-    left[i] = selected_left;
-    sub[i] = selected_sub;
+/*
+ * item table full
+ */
+PRIVATE table_full() {
+#if DYNAMICITEMS
+  long incr = ITEMINCR;
+
+#if LIMITS
+  incr = check_table(ITEMLIMIT + ITEMINCR, ITEMLIMIT + 1) - ITEMLIMIT;
+#endif
+  ITEMLIMIT += incr;
+  COUNT(table_growths);
+  COUNTN(bytes_allocated, 4 * incr * sizeof(long));
+
+  dot = (long *) yymemrealloc(dot, ITEMLIMIT * sizeof(long));
+  if (! dot) {
+    yymallocerror();
+  }
+  back = (long *) yymemrealloc(back, ITEMLIMIT * sizeof(long));
+  if (! back) {
+    yymallocerror();
+  }
+  left = (long *) yymemrealloc(left, ITEMLIMIT * sizeof(long));
+  if (! left) {
+    yymallocerror();
+  }
+  sub = (long *) yymemrealloc(sub, ITEMLIMIT * sizeof(long));
+  if (! sub) {
+    yymallocerror();
   }
+#if SPPF
+  packed = (long *) yymemrealloc(packed, ITEMLIMIT * sizeof(long));
+  if (! packed) {
+    yymallocerror();
+  }
+  COUNTN(bytes_allocated, incr * sizeof(long));
+#endif
+#else
+  Abort("fatal error: item table overflow [increase ITEMLIMIT in art.c]\n");
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+
+PUBLIC yymallocerror() {
+  printf("running out of memory\n");
+  exit(1);
 }
 
+/*============================================================================*/
+/* SEARCH OPTIMISATION                                                        */
+/*============================================================================*/
+
+#define HSIZE 1024
+
+#define HASHCODE (b%8+d)%HSIZE
+
+#if HASHING
+
+/*
+ * hash table to speed up lookup-function
+ * if an item with back pointer b and dot d is entered
+ * into the current item list
+ * the entry with the corresponding hash code is set to 'hash_epoch'
+ *
+ * hash_epoch is incremented for each item list (and is never reset),
+ * hence entries of earlier lists (and earlier parses) are invalid
+ * without clearing the table
+ */
+long hash[HSIZE];
+long hash_epoch = 0;
+
 /*----------------------------------------------------------------------------*/
+
 /*
- * Called when a disjunctive ambiguity is detected and there are
- * "%disfilter n" annotations instead of "%prio n".
- * p1 and p2 are conflicting items
- * The rule of p1 is labeled with %disfilter n1,
- * the rule of p2 is labeled with %disfilter n2.
- * If the function returns 1, p1 will be selected,
- * if the function returns 2, p2 will be selected,
+ * clear hash table
  */
-int disfilter(int n1, int n2, int p1, int p2) {
-  /* dummy implementation for testing purposes */
-  /* should be replaced by user code */
-  if (n1 > n2) {
-    return 1;
-  }
-  if (n1 < n2) {
-    return 2;
-  }
-  return 3;
+PRIVATE int clearhash() {
+  hash_epoch++;
 }
 
+/*----------------------------------------------------------------------------*/
 
-int confilter(int n, int p1, int p2) {
-  /* dummy implementation for testing purposes */
-  /* should be replaced by user code */
-  return n;
+/*
+ * true if there is an entry entry for item with dot d and backpointer b
+ */
+PRIVATE int hashed(int d, int b) {
+  return hash[HASHCODE] == hash_epoch;
 }
+
 /*----------------------------------------------------------------------------*/
 
 /*
- * The item with index i
- * and an item with dot d, leftpointer l, and subpointer s
- * introduce a disjunctive ambiguity
+ * set entry for item with dot d and backpointer b
  */
-PRIVATE disjunctive_ambiguity(int i, int d, int l, int s) {
-  /* Disjunctive Ambiguity */
+PRIVATE sethash(int d, int b) {
+  hash[HASHCODE] = hash_epoch;
+}
+#endif
 
-  int sub1, sub2, rule1, rule2, prio1, prio2;
+/*============================================================================*/
+/* SOURCE BUFFER                                                              */
+/*============================================================================*/
 
-  sub1 = sub[i];
-  sub2 = s;
+#if SOURCEBUFFER
 
-  prio1 = getprio(sub1);
-  prio2 = getprio(sub2);
+/*
+ * If SOURCEBUFFER is set, the source text is a memory mapped file
+ * (yysource_map) or a buffer owned by the caller (yysource_buffer).
+ * The scanner reads it through yysource_read (see entire.h) and
+ * represents the text of a token as a slice (offset, length) of the source,
+ * so no token text is copied.
+ * The source is kept until yysource_release() or yyparse_release()
+ * is called, so slices can be used in the semantic actions.
+ */
 
-  if (prio1 == -1 || prio2 == -1) {
-    /* undefined prio */
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-    printf("\n");
-    printf("GRAMMAR DEBUG INFORMATION\n");
-    printf("\n");
-    printf("Grammar ambiguity detected.\n");
-    printf
-    ("Two different ``%s'' derivation trees for the same phrase.\n",
-     yyprintname(yygrammar[d - 1]));
+PRIVATE const char *source = 0;
+PRIVATE long source_length = 0;
+PRIVATE long source_mapped = 0;
+/* length of the mapping, 0 if the source is owned by the caller */
 
-    printf("\n");
-    printf("TREE 1\n");
-    printf("------\n");
-    printf("\n");
-    print_tree(sub[i]);
-    printf("\n");
-    printf("TREE 2\n");
-    printf("------\n");
-    printf("\n");
-    print_tree(s);
-    printf("\n");
+PRIVATE long source_readpos = 0;
+/* next character passed to the scanner */
 
-    if (test_for_cycle(s, sub[i])) {
-      /* not possible */
-      printf("Tree 1 contains tree 2 as subtree.\n");
-      printf
-      ("Use %%prio annotation to select the second tree.\n");
-      printf("An annotation selecting the first tree\n");
-      printf("would not resolve the ambiguity.\n");
-    } else if (test_for_cycle(sub[i], s)) {
-      printf("Tree 2 contains tree 1 as subtree.\n");
-      printf
-      ("Use %%prio annotation to select the first tree.\n");
-      printf("An annotation selecting the second tree\n");
-      printf("would not resolve the ambiguity.\n");
-    } else {
-      printf("Use %%prio annotation to select an alternative.\n");
+PRIVATE long *line_start = 0;
+PRIVATE long line_count = 0;
+/* offsets of the first characters of the lines,
+ * computed by yysource_position when it is called for the first time
+ */
+
+long yyoffset = 0;
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * map the file 'path' as source text
+ * returns 0, or -1 if the file cannot be mapped
+ */
+PUBLIC int yysource_map(const char *path) {
+  int fd;
+  struct stat st;
+  void *p;
+
+  yysource_release();
+  fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return -1;
+  }
+  if (st.st_size > 0) {
+    p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      return -1;
     }
+#ifdef MADV_SEQUENTIAL
+    madvise(p, st.st_size, MADV_SEQUENTIAL);
+#endif
+    source = (const char *) p;
+    source_mapped = st.st_size;
+  } else {
+    source = "";
+  }
+  close(fd);
+  source_length = st.st_size;
+  source_readpos = 0;
+  yyoffset = 0;
+  return 0;
+}
 
-    printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
+/*----------------------------------------------------------------------------*/
 
-    yypos = posforerrormsg;
-    yyerror("source text uncovers unhandled grammar ambiguity");
-    exit(1);
+/*
+ * use 'text' as source text,
+ * it must not be changed or freed before yysource_release()
+ */
+PUBLIC void yysource_buffer(const char *text, long length) {
+  yysource_release();
+  source = text;
+  source_length = length;
+  source_readpos = 0;
+  yyoffset = 0;
+}
 
-  } else if ((prio1 < 0) || (prio2 < 0)) {
-    int r;
+/*----------------------------------------------------------------------------*/
 
-    r = disfilter(-prio1 - 1, -prio2 - 1, sub[i], s);
-    if (r == 1) {
-      /* use old value */
-    } else if (r == 2) {
-#if DYNAMICCYCLECHECK
-      if (s >= i) {
-        if (test_for_cycle(i, s)) {
-          printf("\n");
-          printf("GRAMMAR DEBUG INFORMATION\n");
-          printf("\n");
-          printf("Annotation for ``%s'' allows cyclic derivation.\n",
-                 yyprintname(yygrammar[d - 1]));
-          printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
-          printf("-b-\n");
-          yyerror("source text uncovers unhandled grammar ambiguity");
-          exit(1);
-        }
+PUBLIC void yysource_release() {
+  if (source_mapped) {
+    munmap((void *) source, source_mapped);
+  }
+  if (line_start) {
+    yymemfree(line_start);
+  }
+  line_start = 0;
+  line_count = 0;
+  source = 0;
+  source_length = 0;
+  source_mapped = 0;
+  source_readpos = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * copy the next at most 'max' characters of the source to 'buf'
+ * (for YY_INPUT of a flex scanner)
+ * returns the number of characters, 0 at the end of the source
+ */
+PUBLIC int yysource_read(char *buf, int max) {
+  long n = source_length - source_readpos;
+
+  if (n > max) {
+    n = max;
+  }
+  if (n > 0) {
+    memcpy(buf, source + source_readpos, n);
+    source_readpos += n;
+  } else {
+    n = 0;
+  }
+  return n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PUBLIC const char *yysource_text() {
+  return source;
+}
+
+PUBLIC long yysource_length() {
+  return source_length;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void build_line_index() {
+  const char *p = source;
+  const char *end = source + source_length;
+  long room = 1024;
+
+  line_start = (long *) yymemalloc(room * sizeof(long));
+  if (! line_start) {
+    yymallocerror();
+  }
+  line_start[0] = 0;
+  line_count = 1;
+  while ((p = memchr(p, '\n', end - p)) != 0) {
+    p++;
+    if (line_count == room) {
+      room *= 2;
+      line_start = (long *) yymemrealloc(line_start, room * sizeof(long));
+      if (! line_start) {
+        yymallocerror();
       }
-#endif
-      sub[i] = s;
+    }
+    line_start[line_count++] = p - source;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * line and column (both counted from 1) of the character at 'offset'
+ * the index of lines is built on the first call,
+ * so the scanner need not track lines
+ */
+PUBLIC void yysource_position(long offset, long *ref_line, long *ref_col) {
+  long lo, hi, mid;
+
+  if (! line_start) {
+    build_line_index();
+  }
+  lo = 0;
+  hi = line_count - 1;
+  while (lo < hi) {
+    mid = (lo + hi + 1) / 2;
+    if (line_start[mid] <= offset) {
+      lo = mid;
     } else {
-      printf("user function `disfilter' returns invalid value\n");
-      exit(1);
+      hi = mid - 1;
     }
-  } else if (prio1 > prio2) {
-  } else {
-#if DYNAMICCYCLECHECK
-    if (s >= i) {
-      if (test_for_cycle(i, s)) {
-        printf("\n");
-        printf("GRAMMAR DEBUG INFORMATION\n");
-        printf("\n");
-        printf("Annotation for ``%s'' allows cyclic derivation.\n",
-               yyprintname(yygrammar[d - 1]));
-        printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
-        yypos = posforerrormsg;
-        yyerror("source text uncovers unhandled grammar ambiguity");
-        exit(1);
+  }
+  *ref_line = lo + 1;
+  *ref_col = offset - line_start[lo] + 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * slice of the token just recognized by the scanner
+ * (yyoffset is the end of the token)
+ */
+PUBLIC struct yyslice yytokenslice(long length) {
+  struct yyslice s;
+
+  s.offset = yyoffset - length;
+  s.length = length;
+  return s;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * the characters of a slice (not terminated by '\0')
+ */
+PUBLIC const char *yyslice_text(struct yyslice s) {
+  return source + s.offset;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * copy a slice to 'buf' as a '\0' terminated string
+ * (truncated to size-1 characters)
+ */
+PUBLIC char *yyslice_copy(struct yyslice s, char *buf, long size) {
+  long n = s.length;
+
+  if (n > size - 1) {
+    n = size - 1;
+  }
+  memcpy(buf, source + s.offset, n);
+  buf[n] = '\0';
+  return buf;
+}
+
+#endif
+
+/*============================================================================*/
+/* LEXER THREAD                                                               */
+/*============================================================================*/
+
+#if LEXERTHREAD
+
+/*
+ * If LEXERTHREAD is set, the scanner runs on a thread of its own
+ * (link with -lpthread) while the recognizer computes the item lists.
+ * The scanner thread passes (token, yylval, yypos) records to the
+ * recognizer through a bounded ring buffer. The scanner thread only
+ * writes lexring_head, the recognizer only writes lexring_tail,
+ * so no lock is needed.
+ *
+ * During recognition only the scanner thread touches yylval and yypos;
+ * the recognizer takes the value and position of a token from the ring
+ * and stores them with first_lexval_at()/next_lexval_at().
+ * The scanner thread terminates after it has delivered EOF,
+ * which happens before the tree walker starts.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+#define LEXRINGSIZE 1024
+/* must be a power of two */
+
+struct lexrecord {
+  long token;
+  long pos;
+};
+
+PRIVATE struct lexrecord *lexring = 0;
+PRIVATE char *lexring_values;
+/* yylval of the token in slot i is stored at lexring_values + i*lexvalue_size */
+
+PRIVATE long lexvalue_size;
+PRIVATE unsigned long lexring_head;
+PRIVATE unsigned long lexring_tail;
+PRIVATE int lexring_stop;
+PRIVATE pthread_t lexer_thread;
+PRIVATE int lexer_running = 0;
+
+PRIVATE char *lexvalue;
+/* yylval of the token last taken from the ring */
+
+PRIVATE long lexpos;
+/* yypos of the token last taken from the ring */
+
+extern void *yylval_address();
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * body of the scanner thread
+ */
+PRIVATE void *lexer_main(void *arg) {
+  unsigned long head = 0;
+  unsigned long i;
+  long token;
+
+  do {
+    while (head - LOAD_ACQUIRE(lexring_tail) == LEXRINGSIZE) {
+      /* ring full */
+      if (LOAD_ACQUIRE(lexring_stop)) {
+        return 0;
       }
+      sched_yield();
+    }
+    if (LOAD_ACQUIRE(lexring_stop)) {
+      return 0;
+    }
+    token = yylex();
+    i = head & (LEXRINGSIZE - 1);
+    lexring[i].token = token;
+    lexring[i].pos = yypos;
+    memcpy(lexring_values + i * lexvalue_size, yylval_address(),
+           lexvalue_size);
+    head++;
+    STORE_RELEASE(lexring_head, head);
+  } while (token != 0 /*EOF*/);
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void start_lexer() {
+  if (! lexring) {
+    lexvalue_size = yylval_size();
+    lexring = (struct lexrecord *)
+              yymemalloc(LEXRINGSIZE * sizeof(struct lexrecord));
+    lexring_values = (char *) yymemalloc((LEXRINGSIZE + 1) * lexvalue_size);
+    if (! lexring || ! lexring_values) {
+      yymallocerror();
     }
+    lexvalue = lexring_values + LEXRINGSIZE * lexvalue_size;
+  }
+  lexring_head = 0;
+  lexring_tail = 0;
+  lexring_stop = 0;
+  if (pthread_create(&lexer_thread, 0, lexer_main, 0) != 0) {
+    printf("cannot start scanner thread\n");
+    exit(1);
+  }
+  lexer_running = 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * wait for the scanner thread
+ * (if the parse is abandoned the thread is told to stop)
+ */
+PRIVATE void stop_lexer() {
+  if (lexer_running) {
+    STORE_RELEASE(lexring_stop, 1);
+    pthread_join(lexer_thread, 0);
+    lexer_running = 0;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void release_lexer() {
+  stop_lexer();
+  if (lexring) {
+    yymemfree(lexring);
+    yymemfree(lexring_values);
+  }
+  lexring = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * take the next token from the ring
+ * its value and position are stored in 'lexvalue' and 'lexpos'
+ */
+PRIVATE long lexer_read() {
+  unsigned long tail = lexring_tail;
+  unsigned long i;
+  long token;
+
+  while (LOAD_ACQUIRE(lexring_head) == tail) {
+    /* ring empty */
+    sched_yield();
+  }
+  i = tail & (LEXRINGSIZE - 1);
+  token = lexring[i].token;
+  lexpos = lexring[i].pos;
+  memcpy(lexvalue, lexring_values + i * lexvalue_size, lexvalue_size);
+  /* the slot may be overwritten from now on */
+  STORE_RELEASE(lexring_tail, tail + 1);
+  return token;
+}
+
+#define LEX() lexer_read()
+#define LEXPOS lexpos
+#define FIRST_LEXVAL() first_lexval_at(lexvalue, lexpos)
+#define NEXT_LEXVAL() next_lexval_at(lexvalue, lexpos)
+#else
+#define LEX() yylex()
+#define LEXPOS yypos
+#define FIRST_LEXVAL() first_lexval()
+#define NEXT_LEXVAL() next_lexval()
+#endif
+
+/*============================================================================*/
+/* TOKENS                                                                     */
+/*============================================================================*/
+
+/*
+ * read next token
+ * current token: 'sym'
+ * following token: 'lookaheadsym'
+ * (and 'lookaheadsym2' if LOOKAHEAD2 is set)
+ * extend the lexical values by calling
+ * next_lexval() provided by 'yygrammar.c'
+ * (once for each token read, including EOF)
+ */
+PRIVATE readsym() {
+  long oldpos;
+
+  sym = lookaheadsym;
+  oldpos = lookaheadpos;
+  posforerrormsg = lookaheadpos;
+  TRACEEVENT(YYTRACE_TOKEN, 0, sym - term_base, posforerrormsg, 0, 0);
+
+#if LOOKAHEAD2
+  lookaheadsym = lookaheadsym2;
+  lookaheadpos = lookaheadpos2;
+  if (lookaheadsym2 != 50000 /*EOF*/) {
+#if PHASETIMING
+    int oldphase = PHASE(YYPHASE_LEX);
+#endif
+    lookaheadsym2 = LEX() + term_base;
+    lookaheadpos2 = LEXPOS;
+#if PHASETIMING
+    PHASE(oldphase);
+#endif
+    NEXT_LEXVAL();
+  }
+#else
+  if (lookaheadsym != 50000 /*EOF*/) {
+#if PHASETIMING
+    int oldphase = PHASE(YYPHASE_LEX);
+#endif
+    lookaheadsym = LEX() + term_base;
+    lookaheadpos = LEXPOS;
+#if PHASETIMING
+    PHASE(oldphase);
 #endif
+    NEXT_LEXVAL();
+  }
+#endif
+  /*
+  yypos = oldpos;
+  */
+}
+
+/*============================================================================*/
+/* GRAMMAR                                                                    */
+/*============================================================================*/
+
+
+
+/* subptr points to an item */
+/* return the prio of corresponding rule */
+PRIVATE int getprio(int subptr) {
+  int i;
+
+  /* find end of rule */
+  i = dot[subptr];
+  while (yygrammar[i] > 0) {
+    i++;
+  }
+  /* i points to the negative lhs encoding */
+  i++;
+  /* i now points to the rule number, this is also the index of the prio */
+
+  return yyannotation[i];
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* i is the index of a member */
+/* return the annotation of the member before the dot */
+PRIVATE int getmemberannotation(int i) {
+  int grammarindex, annotation;
+
+  grammarindex = dot[i] - 1;
+  annotation = yyannotation[grammarindex];
+  return annotation;
+}
+
+/*============================================================================*/
+/* PARSE FOREST                                                               */
+/*============================================================================*/
+
+#if SPPF
+
+/*
+ * If SPPF is set, an ambiguity that is not resolved by an annotation
+ * does not terminate the parser.
+ * The competing pair < L, S > is kept as a "packed node"
+ * of the item I at which the ambiguity was detected.
+ *
+ * Items (with their left and sub pointers that are already shared)
+ * and packed nodes form a shared packed parse forest:
+ * < left[I], sub[I] > is the first packed node of item I,
+ * the further packed nodes are
+ *    packed[I], pk_next[packed[I]], ...
+ * where K represents the pair < pk_left[K], pk_sub[K] >.
+ *
+ * The packed nodes of an item are kept in the order given by 'preferred',
+ * < left[I], sub[I] > is always the best ranked one.
+ *
+ * There is at most one packed node for each triple < I, L, S >,
+ * hence the size of the forest is polynomial in the length of the input
+ * even if the number of trees is exponential.
+ */
+
+#define PACKEDINCR 10000
+
+int PACKEDLIMIT = 0;
+long *pk_left, *pk_sub, *pk_next;
+long last_packed = 0;
+
+PRIVATE int test_for_cycle();
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * true if the packed node < l1, s1 > is ranked before < l2, s2 >
+ *
+ * different left pointers (conjunctive ambiguity) are ranked
+ * as if the member were annotated with %short,
+ * different sub pointers (disjunctive ambiguity) are ranked
+ * according to the %prio annotations of the rules of the subtrees
+ */
+PRIVATE int preferred(int l1, int s1, int l2, int s2) {
+  if (l1 != l2) {
+    return l1 > l2;
+  }
+  if (s1 && s2) {
+    return getprio(s1) > getprio(s2);
+  }
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * add the packed node < l, s > to the item with index i
+ */
+PRIVATE pack(int i, int l, int s) {
+  long k, p, prev;
+
+  if (left[i] == l && sub[i] == s) {
+    return;
+  }
+  for (k = packed[i]; k; k = pk_next[k]) {
+    if (pk_left[k] == l && pk_sub[k] == s) {
+      return;
+    }
+  }
+
+  /* a packed node that contains item i would make the forest cyclic */
+  if (l >= i && test_for_cycle(i, l)) {
+    return;
+  }
+  if (s >= i && test_for_cycle(i, s)) {
+    return;
+  }
+
+  if (last_packed >= PACKEDLIMIT - 1) {
+    PACKEDLIMIT += PACKEDINCR;
+    pk_left = (long *) yymemrealloc(pk_left, PACKEDLIMIT * sizeof(long));
+    pk_sub = (long *) yymemrealloc(pk_sub, PACKEDLIMIT * sizeof(long));
+    pk_next = (long *) yymemrealloc(pk_next, PACKEDLIMIT * sizeof(long));
+    if (! pk_left || ! pk_sub || ! pk_next) {
+      yymallocerror();
+    }
+    COUNTN(bytes_allocated, 3 * PACKEDINCR * sizeof(long));
+  }
+  k = ++last_packed;
+
+  if (preferred(l, s, left[i], sub[i])) {
+    /* < l, s > becomes the first packed node */
+    pk_left[k] = left[i];
+    pk_sub[k] = sub[i];
+    pk_next[k] = packed[i];
+    packed[i] = k;
+    left[i] = l;
     sub[i] = s;
+    return;
+  }
+
+  pk_left[k] = l;
+  pk_sub[k] = s;
+  prev = 0;
+  p = packed[i];
+  while (p && ! preferred(l, s, pk_left[p], pk_sub[p])) {
+    prev = p;
+    p = pk_next[p];
+  }
+  pk_next[k] = p;
+  if (prev) {
+    pk_next[prev] = k;
+  } else {
+    packed[i] = k;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * A tree of the forest is selected by a sequence of choice points.
+ * When the tree is traversed in the order used by 'yyselect'
+ * the k-th item with more than one packed node that is encountered
+ * uses its packed node number ch_alt[k] (0 is < left[I], sub[I] >).
+ *
+ * The trees are enumerated by incrementing this sequence
+ * like an odometer whose digits are discovered by traversing the tree.
+ */
+
+#define CHOICEINCR 200
+
+int CHOICELIMIT = 0;
+long *ch_item;
+int *ch_alt;
+int ch_len = 0;
+int ch_ptr = 0;
+
+long forest_root;
+int forest_held = 0;
+
+long *forest_stack;
+int FORESTSTACKSIZE = 0;
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the number of packed nodes of item i
+ */
+PRIVATE int alternatives(long i) {
+  int n;
+  long k;
+
+  n = 1;
+  for (k = packed[i]; k; k = pk_next[k]) {
+    n++;
+  }
+  return n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * item i has more than one packed node:
+ * set *ref_l and *ref_s to the pair selected for the current choice point
+ * and advance to the next choice point
+ */
+PRIVATE select_alternative(long i, long *ref_l, long *ref_s) {
+  int a;
+  long k;
+
+  if (ch_ptr == ch_len) {
+    /* choice point not yet visited: select the best ranked pair */
+    if (ch_len == CHOICELIMIT) {
+      CHOICELIMIT += CHOICEINCR;
+      ch_item = (long *) yymemrealloc(ch_item, CHOICELIMIT * sizeof(long));
+      ch_alt = (int *) yymemrealloc(ch_alt, CHOICELIMIT * sizeof(int));
+      if (! ch_item || ! ch_alt) {
+        yymallocerror();
+      }
+    }
+    ch_item[ch_len] = i;
+    ch_alt[ch_len] = 0;
+    ch_len++;
+  }
+  a = ch_alt[ch_ptr++];
+
+  if (a == 0) {
+    *ref_l = left[i];
+    *ref_s = sub[i];
+  } else {
+    k = packed[i];
+    while (--a) {
+      k = pk_next[k];
+    }
+    *ref_l = pk_left[k];
+    *ref_s = pk_sub[k];
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * push item index n onto the stack used to traverse the forest
+ */
+PRIVATE forest_push(int *ref_sp, long n) {
+  if (*ref_sp == FORESTSTACKSIZE) {
+    FORESTSTACKSIZE += CHOICEINCR;
+    forest_stack =
+      (long *) yymemrealloc(forest_stack, FORESTSTACKSIZE * sizeof(long));
+    if (! forest_stack) {
+      yymallocerror();
+    }
+  }
+  forest_stack[(*ref_sp)++] = n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * traverse the currently selected tree in the order used by 'yyselect'
+ * and extend the sequence of choice points
+ * (choice points not yet visited select their best ranked packed node)
+ */
+PRIVATE trace_tree() {
+  int sp = 0;
+  long i, l, s;
+
+  ch_ptr = 0;
+  forest_push(&sp, forest_root);
+  while (sp) {
+    i = forest_stack[--sp];
+    l = left[i];
+    s = sub[i];
+    if (packed[i]) {
+      select_alternative(i, &l, &s);
+    }
+    if (s) {
+      forest_push(&sp, s);
+    }
+    if (l) {
+      forest_push(&sp, l);
+    }
+  }
+  ch_ptr = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * select the best ranked tree
+ */
+PUBLIC void yyforest_first() {
+  ch_len = 0;
+  trace_tree();
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * select the next tree
+ * return 0 if all trees have been enumerated
+ */
+PUBLIC int yyforest_next() {
+  while (ch_len > 0) {
+    if (ch_alt[ch_len - 1] + 1 < alternatives(ch_item[ch_len - 1])) {
+      ch_alt[ch_len - 1]++;
+      trace_tree();
+      return 1;
+    }
+    ch_len--;
+  }
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the number of packed nodes that have been added to the forest
+ * (0 if the input is not ambiguous)
+ */
+PUBLIC long yyforest_packednodes() {
+  return last_packed;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the number of trees in the forest
+ *
+ * for each item reachable from the root
+ *    count[I] = sum over the packed nodes < L, S > of I of count[L]*count[S]
+ * (where count[0] = 1) is computed once in a bottom up traversal
+ */
+PUBLIC double yyforest_trees() {
+  double *count;
+  char *state;
+  double n;
+  int sp = 0;
+  long i, k, l, s;
+
+  count = (double *) yymemalloc((last_item + 2) * sizeof(double));
+  state = (char *) zalloc((last_item + 2) * sizeof(char));
+  if (! count || ! state) {
+    yymallocerror();
+  }
+
+  forest_push(&sp, forest_root);
+  while (sp) {
+    i = forest_stack[sp - 1];
+    if (state[i] == 2) {
+      sp--;
+    } else if (state[i] == 0) {
+      /* first visit: process the items of all packed nodes */
+      state[i] = 1;
+      k = 0;
+      l = left[i];
+      s = sub[i];
+      while (1) {
+        if (s && state[s] == 0) {
+          forest_push(&sp, s);
+        }
+        if (l && state[l] == 0) {
+          forest_push(&sp, l);
+        }
+        k = k ? pk_next[k] : packed[i];
+        if (! k) {
+          break;
+        }
+        l = pk_left[k];
+        s = pk_sub[k];
+      }
+    } else {
+      /* second visit: all items of the packed nodes have been counted */
+      n = 0;
+      k = 0;
+      l = left[i];
+      s = sub[i];
+      while (1) {
+        n += (l ? count[l] : 1) * (s ? count[s] : 1);
+        k = k ? pk_next[k] : packed[i];
+        if (! k) {
+          break;
+        }
+        l = pk_left[k];
+        s = pk_sub[k];
+      }
+      count[i] = n;
+      state[i] = 2;
+      sp--;
+    }
+  }
+
+  n = count[forest_root];
+  yymemfree(count);
+  yymemfree(state);
+  return n;
+}
+
+#endif
+
+/*============================================================================*/
+/* AMBIGUITY RESOLUTION                                                       */
+/*============================================================================*/
+
+/*
+ * items visited by the current call of test_for_cycle:
+ * visited[I] == visit_epoch
+ * (visit_epoch is incremented for each call, so the array is never cleared)
+ */
+PRIVATE long *visited = 0;
+PRIVATE long visited_limit = 0;
+PRIVATE long visit_epoch = 0;
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return true if
+ * the tree to which 'container' (a "subpointer" of an item) points
+ * contains the tree to which 'subtree' (also a "subpointer") points
+ *
+ * the items of the tree are visited depth first, each at most once
+ * (subtrees are shared), using the traversal stack;
+ * items before 'subtree' are not visited
+ * because an earlier item cannot refer a later one
+ */
+PRIVATE int test_for_cycle(int subtree, int container) {
+  long sp = 0;
+  long i;
+
+  if (container < subtree) {
+    return 0;
+  }
+
+  if (visited_limit < ITEMLIMIT) {
+    visited_limit = ITEMLIMIT;
+    visited = (long *) yymemrealloc(visited, visited_limit * sizeof(long));
+    if (! visited) {
+      yymallocerror();
+    }
+    for (i = 0; i < visited_limit; i++) {
+      visited[i] = 0;
+    }
+  }
+  visit_epoch++;
+
+  trav_push(&sp, container);
+  while (sp) {
+    i = trav_stack[--sp];
+    if (i == subtree) {
+      return 1;
+    }
+    if (i < subtree || visited[i] == visit_epoch) {
+      continue;
+    }
+    visited[i] = visit_epoch;
+    if (left[i]) {
+      trav_push(&sp, left[i]);
+    }
+    if (sub[i]) {
+      trav_push(&sp, sub[i]);
+    }
+  }
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+
+/*
+ * The item with index i
+ * and an item with dot d, leftpointer l, and subpointer s
+ * introduce a conjunctive ambiguity
+ */
+PRIVATE conjunctive_ambiguity(int i, int d, int l, int s) {
+  if (left[i] != l) {
+
+    /* Conjunctive Ambiguity */
+
+    int left1, left2, sub1, sub2, annotation;
+    int selected_left, selected_sub;
+
+    COUNT(conjunctive_ambiguities);
+
+    left1 = left[i];
+    sub1 = sub[i];
+
+    left2 = l;
+    sub2 = s;
+
+    annotation = getmemberannotation(i);
+
+    if (annotation == 1) {
+      /* %short */
+
+      if (left1 > left2) {
+        selected_left = left1;
+        selected_sub = sub1;
+      } else {
+        selected_left = left2;
+        selected_sub = sub2;
+      }
+    } else if (annotation == 2) {
+      /* %long */
+
+      if (left2 > left1) {
+        selected_left = left1;
+        selected_sub = sub1;
+      } else {
+        selected_left = left2;
+        selected_sub = sub2;
+      }
+    } else if (annotation == 0) {
+      /* annotation == undef */
+
+      int old_sub, old_left;
+
+#if SPPF
+      pack(i, l, s);
+      return;
+#endif
+
+      printf("\n");
+      printf("GRAMMAR DEBUG INFORMATION\n");
+      printf("\n");
+      printf("Grammar ambiguity detected.\n");
+
+      {
+        int k;
+        k = dot[i];
+        while (yygrammar[k] > 0) {
+          k++;
+        }
+        printf("There are two different parses\n");
+        printf("for the beginning of ``%s'', alternative at ",
+               yyprintname(-yygrammar[k]));
+        print_coordinate(k + 1);
+        printf(",\n");
+      }
+      printf("upto and containing ``%s'' at ", yyprintname(yygrammar[d - 1]));
+      print_coordinate(d - 1);
+      printf(".\n");
+
+      printf("\n");
+      printf("PARSE 1\n");
+      printf("-------\n");
+      printf("\n");
+      print_tree(i);
+
+      printf("\n");
+      printf("PARSE 2\n");
+      printf("-------\n");
+      printf("\n");
+      print_tree(last_item + 1);
+
+      printf("\n");
+      printf("For ``%s'' at ", yyprintname(yygrammar[d - 1]));
+      print_coordinate(d - 1);
+      printf(",\n");
+      if (left1 > left2) {
+        printf("use %%short annotation to select first parse,\n");
+        printf("use %%long annotation to select second parse.\n");
+      } else {
+        printf("use %%long annotation to select first parse,\n");
+        printf("use %%short annotation to select second parse.\n");
+      }
+
+      printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
+      yypos = posforerrormsg;
+      yyerror("source text uncovers unhandled grammar ambiguity");
+      exit(1);
+
+      selected_left = l;
+      selected_sub = s;
+    } else {
+      /* user -N */
+      int r;
+
+      if (left1 > left2) {
+        COUNT(confilter_calls);
+        r = confilter(-annotation, i, last_item + 1);
+
+        if (r == 1) {
+          /* %short */
+          selected_left = left1;
+          selected_sub = sub1;
+        } else if (r == 2) {
+          /* %long */
+          selected_left = left2;
+          selected_sub = sub2;
+        } else {
+          printf("user function `confilter' returns invalid value\n");
+          exit(1);
+        }
+      } else {
+        COUNT(confilter_calls);
+        r = confilter(-annotation, last_item + 1, i);
+
+        if (r == 2) {
+          /* %long */
+          selected_left = left1;
+          selected_sub = sub1;
+        } else if (r == 1) {
+          /* %short */
+          selected_left = left2;
+          selected_sub = sub2;
+        } else {
+          printf("user function `confilter' returns invalid value\n");
+          exit(1);
+        }
+      }
+
+    }
+
+    left[i] = selected_left;
+    sub[i] = selected_sub;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+/*
+ * Called when a disjunctive ambiguity is detected and there are
+ * "%disfilter n" annotations instead of "%prio n".
+ * p1 and p2 are conflicting items
+ * The rule of p1 is labeled with %disfilter n1,
+ * the rule of p2 is labeled with %disfilter n2.
+ * If the function returns 1, p1 will be selected,
+ * if the function returns 2, p2 will be selected,
+ */
+int disfilter(int n1, int n2, int p1, int p2) {
+  /* dummy implementation for testing purposes */
+  /* should be replaced by user code */
+  if (n1 > n2) {
+    return 1;
+  }
+  if (n1 < n2) {
+    return 2;
+  }
+  return 3;
+}
+
+
+int confilter(int n, int p1, int p2) {
+  /* dummy implementation for testing purposes */
+  /* should be replaced by user code */
+  return n;
+}
+/*----------------------------------------------------------------------------*/
+
+/*
+ * The item with index i
+ * and an item with dot d, leftpointer l, and subpointer s
+ * introduce a disjunctive ambiguity
+ */
+PRIVATE disjunctive_ambiguity(int i, int d, int l, int s) {
+  /* Disjunctive Ambiguity */
+
+  int sub1, sub2, rule1, rule2, prio1, prio2;
+
+  COUNT(disjunctive_ambiguities);
+
+  sub1 = sub[i];
+  sub2 = s;
+
+  prio1 = getprio(sub1);
+  prio2 = getprio(sub2);
+
+  if (prio1 == -1 || prio2 == -1) {
+    /* undefined prio */
+
+#if SPPF
+    pack(i, l, s);
+    return;
+#endif
+
+    printf("\n");
+    printf("GRAMMAR DEBUG INFORMATION\n");
+    printf("\n");
+    printf("Grammar ambiguity detected.\n");
+    printf
+    ("Two different ``%s'' derivation trees for the same phrase.\n",
+     yyprintname(yygrammar[d - 1]));
+
+    printf("\n");
+    printf("TREE 1\n");
+    printf("------\n");
+    printf("\n");
+    print_tree(sub[i]);
+    printf("\n");
+    printf("TREE 2\n");
+    printf("------\n");
+    printf("\n");
+    print_tree(s);
+    printf("\n");
+
+    if (test_for_cycle(s, sub[i])) {
+      /* not possible */
+      printf("Tree 1 contains tree 2 as subtree.\n");
+      printf
+      ("Use %%prio annotation to select the second tree.\n");
+      printf("An annotation selecting the first tree\n");
+      printf("would not resolve the ambiguity.\n");
+    } else if (test_for_cycle(sub[i], s)) {
+      printf("Tree 2 contains tree 1 as subtree.\n");
+      printf
+      ("Use %%prio annotation to select the first tree.\n");
+      printf("An annotation selecting the second tree\n");
+      printf("would not resolve the ambiguity.\n");
+    } else {
+      printf("Use %%prio annotation to select an alternative.\n");
+    }
+
+    printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
+
+    yypos = posforerrormsg;
+    yyerror("source text uncovers unhandled grammar ambiguity");
+    exit(1);
+
+  } else if ((prio1 < 0) || (prio2 < 0)) {
+    int r;
+
+    COUNT(disfilter_calls);
+    r = disfilter(-prio1 - 1, -prio2 - 1, sub[i], s);
+    if (r == 1) {
+      /* use old value */
+    } else if (r == 2) {
+#if DYNAMICCYCLECHECK
+      if (s >= i) {
+        if (test_for_cycle(i, s)) {
+          printf("\n");
+          printf("GRAMMAR DEBUG INFORMATION\n");
+          printf("\n");
+          printf("Annotation for ``%s'' allows cyclic derivation.\n",
+                 yyprintname(yygrammar[d - 1]));
+          printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
+          printf("-b-\n");
+          yyerror("source text uncovers unhandled grammar ambiguity");
+          exit(1);
+        }
+      }
+#endif
+      sub[i] = s;
+    } else {
+      printf("user function `disfilter' returns invalid value\n");
+      exit(1);
+    }
+  } else if (prio1 > prio2) {
+  } else {
+#if DYNAMICCYCLECHECK
+    if (s >= i) {
+      if (test_for_cycle(i, s)) {
+        printf("\n");
+        printf("GRAMMAR DEBUG INFORMATION\n");
+        printf("\n");
+        printf("Annotation for ``%s'' allows cyclic derivation.\n",
+               yyprintname(yygrammar[d - 1]));
+        printf("\nEND OF GRAMMAR DEBUG INFORMATION\n\n");
+        yypos = posforerrormsg;
+        yyerror("source text uncovers unhandled grammar ambiguity");
+        exit(1);
+      }
+    }
+#endif
+    sub[i] = s;
+  }
+}
+
+/*============================================================================*/
+/* EARLEY                                                                     */
+/*============================================================================*/
+
+/*
+ * An item with dot d, backpointer b, leftpointer l, subpointer s
+ * has been preliminary added to the current list at position
+ * last_item+1 (sentinel)
+ * if there is no other item with dot d and backpointer b
+ * make this item permanent
+ * otherwise, if the old item has a different backpointer/subpointer
+ * then an ambiguity is detected
+ * if the backpointer/subpointer is the same
+ * the new item is already present
+ */
+PRIVATE SEARCH(int d, int b, int l, int s) {
+  register long i;
+
+  i = thislist;
+
+  while ((dot[i] != d) || (back[i] != b)) {
+    i++;
+  }
+  COUNTN(search_probes, i - thislist + 1);
+
+  if (i == last_item + 1) {
+    last_item++;
+    if (last_item == (ITEMLIMIT - 2)) {
+      table_full();
+    }
+#if HASHING
+    sethash(d, b);
+#endif
+    TRACEEVENT(YYTRACE_ADDED, 0, d, b, l, s);
+    PROFILECOUNT(items, d);
+  } else {
+
+#if DETECTAMBIGUITY
+    if (left[i] != l) {
+      PROFILECOUNT(ambiguities, d);
+      conjunctive_ambiguity(i, d, l, s);
+      TRACEEVENT(YYTRACE_AMBIGUITY, YYTRACE_CONJUNCTIVE,
+                 d, b, left[i], sub[i]);
+
+    } else if (sub[i] != s) {
+      PROFILECOUNT(ambiguities, d);
+      disjunctive_ambiguity(i, d, l, s);
+      TRACEEVENT(YYTRACE_AMBIGUITY, YYTRACE_DISJUNCTIVE,
+                 d, b, left[i], sub[i]);
+    }
+#endif
+
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * add an item with dot d, backpointer b, leftpointer l, and subpointer s
+ * to the current item list
+ * if there is already an item with dot d and backpointer b
+ * then the grammar is ambigous (see 'SEARCH', which actually adds the item)
+ *
+ * hash optimization:
+ * if there is no item with the same hash code for d and b
+ * it is not neccessary to invoke SEARCH because the item is unique in the
+ * current list
+ */
+PRIVATE additem(int d, int b, int l, int s) {
+#if LIMITS
+  if (last_item >= next_check) {
+    check_limits();
+  }
+#endif
+
+  /* sentinel */
+  dot [ last_item + 1 ] = d;
+  back[ last_item + 1 ] = b;
+  left[ last_item + 1 ] = l;
+  sub [ last_item + 1 ] = s;
+#if SPPF
+  packed[ last_item + 1 ] = 0;
+#endif
+
+#if HASHING
+  if (! hashed(d, b)) {
+    last_item++;
+    if (last_item == (ITEMLIMIT - 2)) {
+      table_full();
+    }
+    sethash(d, b);
+    TRACEEVENT(YYTRACE_ADDED, 0, d, b, l, s);
+    PROFILECOUNT(items, d);
+  } else {
+    COUNT(hash_hits);
+#endif
+    SEARCH(d, b, l, s);
+#if HASHING
+  }
+#endif
+
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * compute the kernel of the next item list
+ * prevlist points to the previous list
+ *
+ * KERNEL[i] =
+ *    {
+ *       < N : alpha yygrammar[i] * beta, B,I,0 >
+ *    |
+ *       < N : alpha * yygrammar[i] beta, B,_,_ > is in IL[i-1] and has index I
+ *    }
+ */
+PRIVATE kernel(long prevlist) {
+  long i;
+
+  COUNT(kernel_calls);
+  i = prevlist;
+  while (dot[i]) {
+    if (yygrammar[dot[i]] >= term_base) {
+      if (yygrammar[dot[i]] == sym) {
+#if CHECKVIABLE
+        if (is_viable(dot[i] + 1) || lookaheadswitchedoff)
+#endif
+        {
+          additem(dot[i] + 1, back[i], i, 0);
+        }
+#if CHECKVIABLE
+        else {
+          COUNT(viable_rejections);
+          TRACEEVENT(YYTRACE_REJECTED, YYTRACE_NOTVIABLE,
+                     dot[i] + 1, back[i], i, 0);
+        }
+#endif
+      }
+    }
+    i++;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * predictor step for item 'item'
+ *
+ * PREDICTOR:
+ * The dot is before a nonterm
+ * add the rules for that nonterm (with the dot at the beginning)
+ *
+ * If
+ *    < N : alpha * M beta, B,L,S >
+ * is in IL
+ * then add
+ *    < M : * gamma, B',0,0 >
+ * if there is not yet an an item with the first two components
+ * and there is a rule N : gamma
+ * B' is a reference to IL[i]
+ */
+PRIVATE predictor(long item) {
+  long ruleptr;
+
+  COUNT(predictor_calls);
+  TRACEEVENT(YYTRACE_PREDICTION, 0,
+             dot[item], back[item], left[item], sub[item]);
+  ruleptr = yygrammar[dot[item]];
+  do {
+    int old = last_item;
+
+#if ! LOOKAHEAD
+    /* (1) ORIGINAL VERSION */
+    additem(ruleptr + 1, thislist, 0, 0);
+    if ((back[last_item] == thislist) && (last_item > old)) {
+      specialitemadded = 1;
+    }
+#else
+    /* (2) IMPROVEMENT
+    add test: is current symbol (lookaheadsym)
+     in director set of that rule ?
+        */
+    if (lookup_dirset(ruleptr) || lookaheadswitchedoff) {
+      additem(ruleptr + 1, thislist, 0, 0);
+      if ((back[last_item] == thislist) && (last_item > old)) {
+        specialitemadded = 1;
+      }
+    } else {
+      COUNT(dirset_rejections);
+      TRACEEVENT(YYTRACE_REJECTED, YYTRACE_NOTINDIRSET,
+                 ruleptr + 1, thislist, 0, 0);
+    }
+#endif
+
+    ruleptr = yygrammar[ruleptr];
+
+  } while (ruleptr);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * completer step for item 'item'
+ *
+ * COMPLETER
+ * The dot is at the end of a rule
+ * add the item that triggered this rule to be included
+ * where the dot is advanced after the nonterm
+ *
+ * If
+ *    < M : gamma * , B,L,S >
+ * is in CL (with index ITEM)
+ * and there is an item
+ *    < N : alpha * M beta, B',L',S' >
+ * in the item list to which the back-pointer B refers (with index I)
+ * then add
+ *    < N : alpha M * beta, B',I,ITEM >
+ * if there is not yet an item with the first two components
+ */
+PRIVATE completer(long item) {
+  long lhs, old;
+  register int i;
+  int dot_i;
+
+  COUNT(completer_calls);
+  TRACEEVENT(YYTRACE_COMPLETION, 0,
+             dot[item], back[item], left[item], sub[item]);
+  lhs = -yygrammar[dot[item]];
+  i = back[item];
+  PROFILECOUNT(completions, dot[item]);
+#if TIMELINE
+  tl_completions++;
+#endif
+
+  /* loop over all items in earlier item list */
+  dot[last_item + 1] = 0; /* sentinel */
+  while (dot_i = dot[i]) {
+
+    if (yygrammar[/*dot[i]*/dot_i] == lhs) {
+
+#if CHECKVIABLE
+      if (is_viable(/*dot[i]*/dot_i + 1) || lookaheadswitchedoff)
+#endif
+      {
+        old = last_item;
+        additem(/*dot[i]*/dot_i + 1, back[i], i, item);
+        dot[last_item + 1] = 0; /* sentinel */
+        if ((back[i] == thislist) && (last_item > old)) {
+          specialitemadded = 1;
+        }
+      }
+#if CHECKVIABLE
+      else {
+        COUNT(viable_rejections);
+        TRACEEVENT(YYTRACE_REJECTED, YYTRACE_NOTVIABLE,
+                   dot_i + 1, back[i], i, item);
+      }
+#endif
+    }
+
+    i++;
+  }
+  PROFILECOUNTN(scans, dot[item], i - back[item]);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * compute closure for the kernel of the current item list
+ *
+ * CLOSURE
+ * apply PREDICTOR and COMPLETOR
+ * as long as there are changes
+ */
+PRIVATE closure() {
+  long i;
+  int oldend;
+
+  specialitemadded = 0;
+  do {
+    i = thislist;
+    oldend = last_item;
+    while (i <= last_item) {
+      if (yygrammar[dot[i]] < 0) {
+        completer(i);
+      } else if (yygrammar[dot[i]] < term_base) {
+        predictor(i);
+      }
+      i++;
+    }
+    /*
+    } while (specialitemadded && (oldend!=last_item));
+    */
+  } while ((oldend != last_item));
+}
+
+/*----------------------------------------------------------------------------*/
+
+#if STATISTICS
+/*
+ * the closure of the current item list has been computed:
+ * count its items
+ */
+PRIVATE count_itemlist() {
+  long n;
+  int k;
+
+  n = last_item - thislist + 1;
+  yystats.lists++;
+  yystats.items += n;
+  if (n > yystats.peak_list_size) {
+    yystats.peak_list_size = n;
+  }
+
+  /* list_sizes[k] counts the lists with 2^k <= size < 2^(k+1) */
+  k = 0;
+  while (n > 1 && k < YYSTATBUCKETS - 1) {
+    n >>= 1;
+    k++;
+  }
+  yystats.list_sizes[k]++;
+}
+
+/*----------------------------------------------------------------------------*/
+#endif
+
+#if DYNAMICITEMS
+/*
+ * release the item table
+ */
+PRIVATE release_items() {
+  if (dot) {
+    yymemfree(dot);
+  }
+  if (back) {
+    yymemfree(back);
+  }
+  if (left) {
+    yymemfree(left);
+  }
+  if (sub) {
+    yymemfree(sub);
+  }
+#if SPPF
+  if (packed) {
+    yymemfree(packed);
+  }
+  packed = 0;
+#endif
+  dot = back = left = sub = 0;
+  ITEMLIMIT = 0;
+
+  if (visited) {
+    yymemfree(visited);
+  }
+  visited = 0;
+  visited_limit = 0;
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * compute initial item list
+ * its kernel is given by the item
+ *    YYSTART : * UserRoot EOF
+ * for which the closure is computed
+ *
+ */
+PRIVATE initial_itemlist() {
+
+#if DYNAMICITEMS
+#if LIMITS
+  /* a table of the previous parse larger than 'max_bytes' is released */
+  if (dot && check_table(ITEMLIMIT, ITEMMIN) < ITEMLIMIT) {
+    release_items();
+  }
+#endif
+  /* the table of the previous parse is reused (option KEEPMEMORY) */
+  if (! dot) {
+    ITEMLIMIT = ITEMINCR;
+#if LIMITS
+    /* the first table is not larger than 'max_bytes' */
+    ITEMLIMIT = check_table(ITEMINCR, ITEMMIN);
+#endif
+
+    dot = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
+    if (! dot) {
+      yymallocerror();
+    }
+    back = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
+    if (! back) {
+      yymallocerror();
+    }
+    left = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
+    if (! left) {
+      yymallocerror();
+    }
+    sub = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
+    if (! sub) {
+      yymallocerror();
+    }
+    COUNTN(bytes_allocated, 4 * ITEMLIMIT * sizeof(long));
+#if SPPF
+    packed = (long *) yymemalloc(ITEMLIMIT * sizeof(long));
+    if (! packed) {
+      yymallocerror();
+    }
+    COUNTN(bytes_allocated, ITEMLIMIT * sizeof(long));
+#endif
+  }
+#endif
+
+  thislist = 1;
+#if HASHING
+  clearhash();
+#endif
+  additem(2, 1, 0, 0); /*  YYSTART : * UserRoot EOF  */
+  closure();
+#if STATISTICS
+  count_itemlist();
+#endif
+#if TIMELINE
+  record_itemlist(-1, lookaheadpos);
+#endif
+  additem(0, 0, 0, 0); /* terminator */
+}
+
+/*----------------------------------------------------------------------------*/
+
+
+
+/*----------------------------------------------------------------------------*/
+
+int itemlist_empty;
+
+/*
+ * compute next item list:
+ * kernel and closure
+ */
+PRIVATE next_itemlist() {
+  long prevlist;
+
+
+#if HASHING
+  clearhash();
+#endif
+
+  itemlist_empty = 0;
+  prevlist = thislist;
+  thislist = last_item + 1;
+
+  kernel(prevlist);
+  if (last_item < thislist) {
+    itemlist_empty = 1;
+  }
+  closure();
+#if STATISTICS
+  count_itemlist();
+#endif
+#if TIMELINE
+  record_itemlist(sym - term_base, posforerrormsg);
+#endif
+#if LIMITS
+  check_time();
+#endif
+  additem(0, 0, 0, 0);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * compute the sequence of item lists:
+ * initial_itemlist
+ * and then next_itemlist for each input token
+ */
+PRIVATE itemlist_sequence() {
+#if ERRPOSCORRECTION
+  int saved_sym;
+  int saved_yypos;
+  int saved_thislist;
+  int saved_last_item;
+  int saved_saved_sym;
+  int saved_saved_yypos;
+  int saved_saved_thislist;
+  int saved_saved_last_item;
+  int initial_list;
+#endif
+  last_item = 0;
+  initial_itemlist();
+
+#if ERRPOSCORRECTION
+  saved_sym = sym;
+  saved_yypos = lookaheadpos;
+  saved_thislist = thislist;
+  initial_list = thislist;
+  saved_last_item = last_item;
+#endif
+  do {
+    readsym();
+
+#if ERRPOSCORRECTION
+    saved_saved_sym = saved_sym;
+    saved_saved_yypos = saved_yypos;
+    saved_saved_thislist = saved_thislist;
+    saved_saved_last_item = saved_last_item;
+
+    saved_sym = sym;
+    saved_yypos = lookaheadpos;
+    saved_thislist = thislist;
+    saved_last_item = last_item;
+#endif
+    next_itemlist();
+    if (itemlist_empty) {
+      break;
+    }
+  } while (sym != eofsym);
+
+
+  if (itemlist_empty) {
+
+#if ERRPOSCORRECTION
+
+    /* switch off lookahead optimization and recompute
+     * last item lists
+     */
+
+    int p_saved_saved_yypos = saved_saved_yypos;
+    int p_saved_yypos = saved_yypos;
+    int p_yypos = yypos;
+    int p_lookaheadpos = lookaheadpos;
+
+    lookaheadswitchedoff = 1;
+
+#if LOOKAHEAD2
+    /* the initial list has been pruned with the first two tokens,
+     * if one of them is wrong the list must be recomputed as well
+     */
+    if (saved_thislist == initial_list ||
+        saved_saved_thislist == initial_list) {
+      last_item = 0;
+      initial_itemlist();
+      saved_last_item = last_item;
+      saved_saved_last_item = last_item;
+    }
+#endif
+
+    if (saved_thislist == initial_list) {
+      thislist = saved_thislist;
+      last_item = saved_last_item;
+    } else {
+      thislist = saved_saved_thislist;
+      last_item = saved_saved_last_item;
+      sym = saved_saved_sym;
+      next_itemlist();
+      if (itemlist_empty) {
+        printf("-1-\n");
+        posforerrormsg = p_saved_saved_yypos;
+        syntaxerror();
+      }
+    }
+
+    sym = saved_sym;
+    next_itemlist();
+    if (itemlist_empty) {
+      /*
+      printf("-2-\n");
+      */
+      posforerrormsg = p_saved_saved_yypos;
+      syntaxerror();
+    }
+
+    sym = lookaheadsym;
+    next_itemlist();
+    if (itemlist_empty) {
+      /*
+      printf("-3-\n");
+      */
+      posforerrormsg = p_saved_yypos;
+      syntaxerror();
+    }
+
+#if LOOKAHEAD2
+    /* the second lookahead token may have emptied the list */
+    sym = lookaheadsym2;
+    next_itemlist();
+    if (itemlist_empty) {
+      posforerrormsg = lookaheadpos2;
+      syntaxerror();
+    }
+#endif
+
+    printf("PROGRAM ERROR\n");
+    exit(1);
+#else
+    syntaxerror();
+#endif
+  }
+}
+
+/*============================================================================*/
+/* ERROR RECOVERY                                                             */
+/*============================================================================*/
+
+#if ERRORRECOVERY
+
+/*
+ * If ERRORRECOVERY is set, a syntax error does not terminate the program.
+ * When the item list for the current token T is empty,
+ * the previous item list C is recomputed without lookahead
+ * and the cheapest of the following repairs is applied:
+ *
+ *    insert a token E before T
+ *       (E is a token expected in C and C E T can be recognized)
+ *    delete T
+ *       (C U can be recognized, U is the token after T)
+ *    delete T and repair again before U
+ *
+ * Each repair is recorded as a diagnostic and the recognition continues.
+ * At the end yyparse() skips the tree walk and returns YYPARSE_ERROR.
+ * The parse is abandoned at an unexpected end of input
+ * or after MAXERRORS diagnostics.
+ */
+
+#define MAXERRORS 100
+#define DIAGNOSTICSINCR 100
+
+PRIVATE struct yydiagnostic *diagnostics = 0;
+PRIVATE long diagnostics_length = 0;
+PRIVATE long diagnostics_limit = 0;
+PRIVATE int recovery_failed;
+PRIVATE int extend_deletion; /* add further deletions to the last one */
+
+/*
+ * how an item list has been computed:
+ * from the list given by 'thislist' and 'last_item' by reading 'sym'
+ * ('initial' is set for the initial item list)
+ */
+struct listorigin {
+  int initial;
+  long thislist;
+  long last_item;
+  long sym;
+};
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * record a diagnostic for token t at position pos
+ * consecutive deletions are combined into a single diagnostic
+ */
+PRIVATE add_diagnostic(int kind, long pos, long t) {
+  struct yydiagnostic *d;
+
+  if (kind == YYDIAG_DELETED && extend_deletion) {
+    diagnostics[diagnostics_length - 1].count++;
+    return;
+  }
+  if (diagnostics_length == diagnostics_limit) {
+    diagnostics_limit += DIAGNOSTICSINCR;
+    diagnostics = (struct yydiagnostic *)
+                  yymemrealloc(diagnostics,
+                               diagnostics_limit * sizeof(struct yydiagnostic));
+    if (! diagnostics) {
+      yymallocerror();
+    }
+  }
+  d = &diagnostics[diagnostics_length++];
+  d->kind = kind;
+  d->pos = pos;
+  d->token = t - term_base;
+  d->count = 1;
+  extend_deletion = (kind == YYDIAG_DELETED);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * compute the item list for token t from the current list
+ * if it is empty, the current list is restored and 0 is returned
+ */
+PRIVATE int try_token(long t) {
+  long l = thislist;
+  long e = last_item;
+  long saved_sym = sym;
+
+  sym = t;
+  next_itemlist();
+  sym = saved_sym;
+  if (! itemlist_empty) {
+    return 1;
+  }
+  thislist = l;
+  last_item = e;
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * recompute the item list with origin o
+ */
+PRIVATE recompute(struct listorigin *o) {
+  if (o->initial) {
+    last_item = 0;
+    initial_itemlist();
+  } else {
+    thislist = o->thislist;
+    last_item = o->last_item;
+    try_token(o->sym);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * set o to the origin of the list computed from the current list
+ */
+PRIVATE set_origin(struct listorigin *o, long t) {
+  o->initial = 0;
+  o->thislist = thislist;
+  o->last_item = last_item;
+  o->sym = t;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * the item list for 'sym' computed from the list with origin *ref_p
+ * is empty, *ref_pp is the origin of the list before
+ *
+ * repair the input such that the next item list is not empty,
+ * this becomes the current list
+ * *ref_p and *ref_pp are updated to the origins of this list
+ * and of its predecessor
+ */
+PRIVATE recover(struct listorigin *ref_pp, struct listorigin *ref_p) {
+  struct listorigin c, cur, pred;
+  long k, j, t;
+
+  lookaheadswitchedoff = 1;
+
+  /* C: the previous list, without lookahead */
+  recompute(ref_pp);
+  c = *ref_pp;
+
+  extend_deletion = 0;
+
+  /* the lookahead may have removed the items for 'sym' */
+  set_origin(&cur, sym);
+  if (try_token(sym)) {
+    /* the error is at the following token */
+    c = cur;
+    readsym();
+  }
+
+  for (;;) {
+    set_origin(&cur, sym);
+    if (try_token(sym)) {
+      pred = c;
+      break;
+    }
+
+    if (diagnostics_length >= MAXERRORS) {
+      add_diagnostic(YYDIAG_ABANDONED, posforerrormsg, sym);
+      recovery_failed = 1;
+      break;
+    }
+
+    /* insert a token expected in C */
+    for (k = thislist; dot[k]; k++) {
+      t = yygrammar[dot[k]];
+      if (t < term_base || t == eofsym) {
+        continue;
+      }
+      for (j = thislist; j < k; j++) {
+        if (yygrammar[dot[j]] == t) {
+          break;
+        }
+      }
+      if (j < k) {
+        /* already tried */
+        continue;
+      }
+      set_origin(&pred, t);
+      if (try_token(t)) {
+        set_origin(&cur, sym);
+        if (try_token(sym)) {
+          add_diagnostic(YYDIAG_INSERTED, posforerrormsg, t);
+          goto repaired;
+        }
+        thislist = pred.thislist;
+        last_item = pred.last_item;
+      }
+    }
+
+    if (sym == eofsym) {
+      add_diagnostic(YYDIAG_ABANDONED, posforerrormsg, sym);
+      recovery_failed = 1;
+      break;
+    }
+
+    /* delete 'sym' */
+    add_diagnostic(YYDIAG_DELETED, posforerrormsg, sym);
+    set_origin(&cur, lookaheadsym);
+    if (try_token(lookaheadsym)) {
+      readsym();
+      pred = c;
+      break;
+    }
+    readsym();
+  }
+
+repaired:
+  lookaheadswitchedoff = 0;
+  *ref_pp = pred;
+  *ref_p = cur;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * compute the sequence of item lists
+ * (as 'itemlist_sequence', but repairing syntax errors)
+ */
+PRIVATE itemlist_sequence_with_recovery() {
+  struct listorigin p, pp;
+
+  diagnostics_length = 0;
+  recovery_failed = 0;
+
+  last_item = 0;
+  initial_itemlist();
+  p.initial = 1;
+
+  do {
+    readsym();
+    pp = p;
+    set_origin(&p, sym);
+    next_itemlist();
+    if (itemlist_empty) {
+      recover(&pp, &p);
+      if (recovery_failed) {
+        return;
+      }
+    }
+  } while (sym != eofsym);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the diagnostics of the last parse
+ * *ref_length is set to the number of diagnostics
+ */
+PUBLIC struct yydiagnostic *yyparse_diagnostics(long *ref_length) {
+  *ref_length = diagnostics_length;
+  return diagnostics;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * print token t (as returned by yylex) to f
+ */
+PRIVATE fprint_token(FILE *f, long t) {
+  if (t == 0) {
+    fprintf(f, "end of input");
+  } else if (t <= max_char) {
+    fprintf(f, "'%c'", (int) t);
+  } else {
+    fprintf(f, "%s", yyprintname(t + term_base));
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the diagnostics of the last parse to f
+ */
+PUBLIC void yyprint_diagnostics(FILE *f) {
+  struct yydiagnostic *d;
+  long k;
+
+  for (k = 0; k < diagnostics_length; k++) {
+    d = &diagnostics[k];
+    fprintf(f, "%ld: syntax error, ", d->pos);
+    if (d->kind == YYDIAG_INSERTED) {
+      fprint_token(f, d->token);
+      fprintf(f, " inserted\n");
+    } else if (d->kind == YYDIAG_DELETED) {
+      fprint_token(f, d->token);
+      if (d->count > 1) {
+        fprintf(f, " and %ld following tokens", d->count - 1);
+      }
+      fprintf(f, " deleted\n");
+    } else {
+      fprintf(f, "unexpected ");
+      fprint_token(f, d->token);
+      fprintf(f, ", parse abandoned\n");
+    }
+  }
+}
+
+#endif
+
+/*============================================================================*/
+/* DERIVATION LOG                                                             */
+/*============================================================================*/
+
+#if DERIVATIONLOG
+
+/*
+ * If DERIVATIONLOG is set and a log file has been set with
+ * yyderivation_log() (or the log is kept by the parse cache),
+ * the rule numbers returned by yyselect() are recorded during the tree walk
+ * and written to it with the lexical values of the tokens after the walk.
+ * yyreplay() runs the tree walker YYSTART again on such a log
+ * without reading tokens or computing item lists,
+ * a log that does not fit the grammar is rejected before the walk.
+ *
+ * Format (native byte order, so a log can be mapped into memory):
+ *    struct loghdr
+ *    rule numbers as unsigned LEB128 varints (rule_bytes bytes)
+ *    for each token: position as zigzag varint, lexval_size bytes of yylval
+ * The lexical values are copied as they are, so attributes that are
+ * pointers are only meaningful in the process that wrote the log
+ * (token text can be passed as slices, see SOURCEBUFFER).
+ */
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define LOGMAGIC "EDLG"
+#define LOGVERSION 1
+
+struct loghdr {
+  char magic[4];
+  unsigned int version;
+  unsigned long long grammar;      /* grammar_hash() of the writer */
+  unsigned int lexval_size;        /* sizeof(YYSTYPE) of the writer */
+  unsigned int reserved;
+  unsigned long long rule_bytes;
+  unsigned long long rules;
+  unsigned long long tokens;
+};
+
+PRIVATE FILE *log_file = 0;
+PRIVATE int log_capture = 0;       /* the log is wanted (option PARSECACHE) */
+PRIVATE int log_walk = 0;          /* the rules of this walk are logged */
+
+PRIVATE unsigned char *log_buf = 0;
+PRIVATE long log_buf_length = 0;
+PRIVATE long log_buf_room = 0;     /* the encoded log */
+
+PRIVATE unsigned char *rule_log = 0;
+PRIVATE long rule_log_length = 0;
+PRIVATE long rule_log_room = 0;
+PRIVATE long rule_log_count = 0;
+
+PRIVATE int replaying = 0;
+PRIVATE const unsigned char *replay_ptr;
+PRIVATE const unsigned char *replay_end;
+
+extern void *yylexval();
+extern long yylexpos();
+
+PRIVATE void walk();
+extern long yytokencount();
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * FNV-1a hash of the encoded grammar,
+ * a log can only be replayed with the grammar that wrote it
+ */
+PRIVATE unsigned long long grammar_hash() {
+  unsigned long long h = 14695981039346656037ULL;
+  int i;
+
+  for (i = 0; i <= c_length; i++) {
+    h ^= (unsigned int) yygrammar[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void log_rule(int rule) {
+  unsigned long v = rule;
+
+  if (rule_log_length + 10 > rule_log_room) {
+    rule_log_room = rule_log_room ? 2 * rule_log_room : 4096;
+    rule_log = (unsigned char *) yymemrealloc(rule_log, rule_log_room);
+    if (! rule_log) {
+      yymallocerror();
+    }
+  }
+  while (v >= 0x80) {
+    rule_log[rule_log_length++] = (v & 0x7f) | 0x80;
+    v >>= 7;
+  }
+  rule_log[rule_log_length++] = v;
+  rule_log_count++;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void put_bytes(const void *p, long n) {
+  if (log_buf_length + n > log_buf_room) {
+    log_buf_room = log_buf_room ? 2 * log_buf_room : 4096;
+    if (log_buf_room < log_buf_length + n) {
+      log_buf_room = log_buf_length + n;
+    }
+    log_buf = (unsigned char *) yymemrealloc(log_buf, log_buf_room);
+    if (! log_buf) {
+      yymallocerror();
+    }
+  }
+  memcpy(log_buf + log_buf_length, p, n);
+  log_buf_length += n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void put_varint(unsigned long v) {
+  unsigned char b[10];
+  int n = 0;
+
+  while (v >= 0x80) {
+    b[n++] = (v & 0x7f) | 0x80;
+    v >>= 7;
+  }
+  b[n++] = v;
+  put_bytes(b, n);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * returns 0 if the varint extends beyond the end of the log
+ */
+PRIVATE int get_varint(unsigned long *ref_v) {
+  unsigned long v = 0;
+  int shift = 0;
+
+  while (replay_ptr < replay_end && shift < 64) {
+    unsigned char b = *replay_ptr++;
+
+    v |= (unsigned long) (b & 0x7f) << shift;
+    if (! (b & 0x80)) {
+      *ref_v = v;
+      return 1;
+    }
+    shift += 7;
+  }
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * encode the log of the parse just walked into log_buf
+ */
+PRIVATE void encode_log() {
+  struct loghdr h;
+  long i, n, size;
+  long pos;
+
+  memset(&h, 0, sizeof(h));
+  memcpy(h.magic, LOGMAGIC, 4);
+  h.version = LOGVERSION;
+  h.grammar = grammar_hash();
+  h.lexval_size = size = yylval_size();
+  h.rule_bytes = rule_log_length;
+  h.rules = rule_log_count;
+  h.tokens = n = yytokencount();
+
+  log_buf_length = 0;
+  put_bytes(&h, sizeof(h));
+  put_bytes(rule_log, rule_log_length);
+  for (i = 0; i < n; i++) {
+    pos = yylexpos(i);
+    put_varint(((unsigned long) pos << 1) ^ (pos < 0 ? ~0UL : 0));
+    put_bytes(yylexval(i), size);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the encoded log to the log file
+ */
+PRIVATE void write_log() {
+  fwrite(log_buf, 1, log_buf_length, log_file);
+  fflush(log_file);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the derivation log of each following parse to f
+ * (0: no log)
+ */
+PUBLIC void yyderivation_log(FILE *f) {
+  log_file = f;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * check the rule numbers between replay_ptr and replay_end
+ * by simulating the walk: each rule must be an alternative of the member
+ * it is selected for, and the log must hold exactly the derivation
+ * (so yyselect() cannot run out of rules during the replay)
+ * returns 0 if the log does not fit the grammar
+ */
+PRIVATE int check_log(unsigned long rules, unsigned long tokens) {
+  int *alt;
+  long *members;
+  long top = 0, room = 64;
+  unsigned long rule, count = 0, token = 0;
+  int i, j, max_rule = 0, ok;
+
+  for (i = 1; i <= c_length; i = j + 2) {
+    for (j = i + 1; yygrammar[j] >= 0; j++) {
+    }
+    if (yygrammar[j + 1] > max_rule) {
+      max_rule = yygrammar[j + 1];
+    }
+  }
+  /* alt[rule]: index of its first member, 0: no such rule */
+  alt = (int *) zalloc((max_rule + 1) * sizeof(int));
+  members = (long *) yymemalloc(room * sizeof(long));
+  if (! alt || ! members) {
+    yymallocerror();
+  }
+  for (i = 1; i <= c_length; i = j + 2) {
+    for (j = i + 1; yygrammar[j] >= 0; j++) {
+    }
+    alt[yygrammar[j + 1]] = i + 1;
+  }
+
+  /* the first member is YYSTART (nonterminal 1) */
+  ok = 1;
+  j = 1;
+  for (;;) {
+    if (j >= term_base) {
+      token++;
+    } else {
+      /* the next rule must be an alternative of nonterminal j */
+      if (! get_varint(&rule) || rule > (unsigned long) max_rule ||
+          alt[rule] == 0) {
+        ok = 0;
+        break;
+      }
+      for (i = alt[rule]; yygrammar[i] >= 0; i++) {
+      }
+      if (-yygrammar[i] != j) {
+        ok = 0;
+        break;
+      }
+      count++;
+      if (top == room) {
+        room *= 2;
+        members = (long *) yymemrealloc(members, room * sizeof(long));
+        if (! members) {
+          yymallocerror();
+        }
+      }
+      members[top++] = alt[rule];
+    }
+    while (top > 0 && yygrammar[members[top - 1]] < 0) {
+      top--;
+    }
+    if (top == 0) {
+      break;
+    }
+    j = yygrammar[members[top - 1]++];
+  }
+  yymemfree(members);
+  yymemfree(alt);
+  return ok && count == rules && token == tokens && replay_ptr == replay_end;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * run the tree walker on the derivation log 'log' of 'length' bytes
+ * returns YYPARSE_BADLOG if it has not been written with this grammar
+ */
+PUBLIC int yyreplay(const void *log, long length) {
+  struct loghdr h;
+  const unsigned char *tokens;
+  unsigned long i, pos;
+  char *value;
+  long size;
+
+#if EVENTSTREAM
+  yyevents_release();
+#endif
+  if (length < (long) sizeof(h)) {
+    return YYPARSE_BADLOG;
+  }
+  memcpy(&h, log, sizeof(h));
+  size = yylval_size();
+  if (memcmp(h.magic, LOGMAGIC, 4) != 0 || h.version != LOGVERSION ||
+      h.grammar != grammar_hash() || h.lexval_size != size ||
+      h.rule_bytes > length - sizeof(h)) {
+    return YYPARSE_BADLOG;
+  }
+  tokens = (const unsigned char *) log + sizeof(h) + h.rule_bytes;
+  replay_ptr = (const unsigned char *) log + sizeof(h);
+  replay_end = tokens;
+  if (! check_log(h.rules, h.tokens)) {
+    return YYPARSE_BADLOG;
+  }
+
+  /* lexical values */
+  replay_ptr = tokens;
+  replay_end = (const unsigned char *) log + length;
+  value = (char *) yymemalloc(size);
+  if (! value) {
+    yymallocerror();
+  }
+  for (i = 0; i < h.tokens; i++) {
+    if (! get_varint(&pos) || replay_end - replay_ptr < size) {
+      yymemfree(value);
+      free_lexelems();
+      return YYPARSE_BADLOG;
+    }
+    memcpy(value, replay_ptr, size);
+    replay_ptr += size;
+    if (i == 0) {
+      first_lexval_at(value, (long) (pos >> 1) ^ -(long) (pos & 1));
+    } else {
+      next_lexval_at(value, (long) (pos >> 1) ^ -(long) (pos & 1));
+    }
+  }
+  yymemfree(value);
+
+  /* rule numbers, read by yyselect() */
+  replay_ptr = (const unsigned char *) log + sizeof(h);
+  replay_end = tokens;
+  replaying = 1;
+  init_lexelem();
+  PHASE(YYPHASE_WALK);
+  walk();
+  PHASE(-1);
+  replaying = 0;
+
+#if KEEPMEMORY
+  free_lexelems();
+#else
+  release_lexelems();
+#endif
+  return YYPARSE_OK;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * replay the derivation log in file 'path' (mapped into memory)
+ * returns YYPARSE_BADLOG if the file cannot be read or is not a valid log
+ */
+PUBLIC int yyreplay_file(const char *path) {
+  int fd;
+  struct stat st;
+  void *p;
+  int result;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return YYPARSE_BADLOG;
+  }
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return YYPARSE_BADLOG;
+  }
+  p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) {
+    return YYPARSE_BADLOG;
+  }
+  result = yyreplay(p, st.st_size);
+  munmap(p, st.st_size);
+  return result;
+}
+
+#endif
+
+#if PARSECACHE
+
+/*============================================================================*/
+/* PARSE CACHE                                                                */
+/*============================================================================*/
+
+/*
+ * With option PARSECACHE (which needs SOURCEBUFFER and DERIVATIONLOG),
+ * yyparse_cached() looks up the source text in a cache of derivation logs
+ * before parsing it. The key is a 128 bit hash of the source text,
+ * its length and the grammar_hash().
+ * On a hit the log is replayed (see yyreplay): the scanner is not called
+ * and no item lists are computed. On a miss the text is parsed by yyparse()
+ * and the log of the walk is entered into the cache.
+ *
+ * The logs are kept in memory up to a given number of bytes, the least
+ * recently used ones are dropped first. If a directory has been given,
+ * each log is also written to a file named after the key, so that other
+ * processes and later runs find it.
+ *
+ * As for the derivation log, the lexical values are copied as they are,
+ * so token text should be passed as slices of the source.
+ * The cache is kept until yyparse_cache_clear() is called.
+ */
+
+#define CACHEBUCKETS 1024
+#define CACHENAMESIZE 80             /* file name without the directory */
+#define ROTL(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+struct cachekey {
+  unsigned long long h1, h2;
+  long length;                       /* of the source text */
+};
+
+struct cacheentry {
+  struct cachekey key;
+  struct cacheentry *hnext;          /* next entry in the same bucket */
+  struct cacheentry *newer, *older;  /* the list of all entries */
+  unsigned char *log;
+  long length;
+};
+
+PRIVATE struct cacheentry **cache_buckets = 0;
+PRIVATE long cache_bucket_count = 0;
+PRIVATE struct cacheentry *cache_newest = 0;
+PRIVATE struct cacheentry *cache_oldest = 0;
+
+PRIVATE long cache_limit = 0;        /* bytes of logs kept in memory */
+PRIVATE char *cache_dir = 0;
+PRIVATE char *cache_path = 0;        /* room for two file names in cache_dir */
+
+PRIVATE struct yycachestatistics cache_stats;
+
+PRIVATE unsigned char *captured_log = 0;
+PRIVATE long captured_length = 0;    /* log of the last yyparse() */
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * hash the source text, 8 bytes at a time in two independent lanes
+ */
+PRIVATE void source_key(struct cachekey *k) {
+  const unsigned char *p = (const unsigned char *) yysource_text();
+  long n = yysource_length();
+  unsigned long long h1, h2, w;
+  long i;
+
+  h1 = grammar_hash();
+  h2 = ~h1 ^ (unsigned long long) n;
+  for (i = 0; i + 8 <= n; i += 8) {
+    memcpy(&w, p + i, 8);
+    h1 = ROTL(h1 ^ w, 29) * 0x9e3779b97f4a7c15ULL;
+    h2 = ROTL(h2 + w, 31) * 0xc2b2ae3d27d4eb4fULL;
+  }
+  w = 0;
+  memcpy(&w, p + i, n - i);
+  h1 = ROTL(h1 ^ w, 29) * 0x9e3779b97f4a7c15ULL;
+  h2 = ROTL(h2 + w, 31) * 0xc2b2ae3d27d4eb4fULL;
+
+  h1 ^= h2 >> 31;
+  h1 *= 0xff51afd7ed558ccdULL;
+  h1 ^= h1 >> 33;
+  h2 ^= h1 >> 29;
+  h2 *= 0xc4ceb9fe1a85ec53ULL;
+  h2 ^= h2 >> 32;
+  k->h1 = h1;
+  k->h2 = h2;
+  k->length = n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE struct cacheentry *lookup_entry(struct cachekey *k) {
+  struct cacheentry *e;
+
+  if (! cache_buckets) {
+    return 0;
+  }
+  e = cache_buckets[k->h1 & (cache_bucket_count - 1)];
+  while (e) {
+    if (e->key.h1 == k->h1 && e->key.h2 == k->h2 &&
+        e->key.length == k->length) {
+      return e;
+    }
+    e = e->hnext;
+  }
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void unlink_entry(struct cacheentry *e) {
+  if (e->newer) {
+    e->newer->older = e->older;
+  } else {
+    cache_newest = e->older;
+  }
+  if (e->older) {
+    e->older->newer = e->newer;
+  } else {
+    cache_oldest = e->newer;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void make_newest(struct cacheentry *e) {
+  e->older = cache_newest;
+  e->newer = 0;
+  if (cache_newest) {
+    cache_newest->newer = e;
+  } else {
+    cache_oldest = e;
+  }
+  cache_newest = e;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void drop_entry(struct cacheentry *e) {
+  struct cacheentry **ref;
+
+  ref = &cache_buckets[e->key.h1 & (cache_bucket_count - 1)];
+  while (*ref != e) {
+    ref = &(*ref)->hnext;
+  }
+  *ref = e->hnext;
+  unlink_entry(e);
+  cache_stats.entries--;
+  cache_stats.bytes -= e->length;
+  yymemfree(e->log);
+  yymemfree(e);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * drop the least recently used entries until the logs fit into the limit
+ */
+PRIVATE void trim_cache() {
+  while (cache_oldest && cache_stats.bytes > cache_limit) {
+    drop_entry(cache_oldest);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void grow_buckets() {
+  struct cacheentry **old = cache_buckets;
+  struct cacheentry *e, *next;
+  long i, n = cache_bucket_count;
+
+  cache_bucket_count = n ? 2 * n : CACHEBUCKETS;
+  cache_buckets = (struct cacheentry **)
+    yymemalloc(cache_bucket_count * sizeof(struct cacheentry *));
+  if (! cache_buckets) {
+    yymallocerror();
+  }
+  memset(cache_buckets, 0, cache_bucket_count * sizeof(struct cacheentry *));
+  for (i = 0; i < n; i++) {
+    for (e = old[i]; e; e = next) {
+      next = e->hnext;
+      e->hnext = cache_buckets[e->key.h1 & (cache_bucket_count - 1)];
+      cache_buckets[e->key.h1 & (cache_bucket_count - 1)] = e;
+    }
+  }
+  if (old) {
+    yymemfree(old);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * enter 'log' (allocated by yymemalloc) into the cache,
+ * it is released if it does not fit
+ */
+PRIVATE void keep_entry(struct cachekey *k, unsigned char *log, long length) {
+  struct cacheentry *e;
+
+  if (length > cache_limit) {
+    yymemfree(log);
+    return;
+  }
+  if (cache_stats.entries >= cache_bucket_count) {
+    grow_buckets();
+  }
+  e = (struct cacheentry *) yymemalloc(sizeof(struct cacheentry));
+  if (! e) {
+    yymallocerror();
+  }
+  e->key = *k;
+  e->log = log;
+  e->length = length;
+  e->hnext = cache_buckets[k->h1 & (cache_bucket_count - 1)];
+  cache_buckets[k->h1 & (cache_bucket_count - 1)] = e;
+  make_newest(e);
+  cache_stats.entries++;
+  cache_stats.bytes += length;
+  trim_cache();
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * called by finish_parse() when the log of the walk has been encoded
+ */
+PRIVATE void capture_log() {
+  captured_log = (unsigned char *) yymemrealloc(log_buf, log_buf_length);
+  if (! captured_log) {
+    yymallocerror();
+  }
+  captured_length = log_buf_length;
+  log_buf = 0;
+  log_buf_length = 0;
+  log_buf_room = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void set_cache_path(char *path, struct cachekey *k,
+                            const char *suffix) {
+  sprintf(path, "%s/%016llx%016llx-%lx%s",
+          cache_dir, k->h1, k->h2, k->length, suffix);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * read the log for 'k' from the cache directory
+ * returns 0 if there is none
+ */
+PRIVATE int read_cache_file(struct cachekey *k,
+                            unsigned char **ref_log, long *ref_length) {
+  int fd;
+  struct stat st;
+  unsigned char *log;
+  long done, n;
+
+  set_cache_path(cache_path, k, ".edlg");
+  fd = open(cache_path, O_RDONLY);
+  if (fd < 0) {
+    return 0;
+  }
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return 0;
+  }
+  log = (unsigned char *) yymemalloc(st.st_size);
+  if (! log) {
+    yymallocerror();
+  }
+  for (done = 0; done < st.st_size; done += n) {
+    n = read(fd, log + done, st.st_size - done);
+    if (n <= 0) {
+      close(fd);
+      yymemfree(log);
+      return 0;
+    }
+  }
+  close(fd);
+  *ref_log = log;
+  *ref_length = st.st_size;
+  return 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the log for 'k' into the cache directory
+ * (under a temporary name first, so readers never see a partial file)
+ */
+PRIVATE void write_cache_file(struct cachekey *k,
+                              unsigned char *log, long length) {
+  char *tmp = cache_path + strlen(cache_dir) + CACHENAMESIZE;
+  char suffix[32];
+  FILE *f;
+  int ok;
+
+  sprintf(suffix, ".%ld.tmp", (long) getpid());
+  set_cache_path(tmp, k, suffix);
+  set_cache_path(cache_path, k, ".edlg");
+  f = fopen(tmp, "wb");
+  if (! f) {
+    return;
+  }
+  ok = fwrite(log, 1, length, f) == length;
+  ok = fclose(f) == 0 && ok;
+  if (! ok || rename(tmp, cache_path) != 0) {
+    remove(tmp);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * keep up to 'max_bytes' of logs in memory,
+ * and their files in directory 'dir' (0: no files)
+ */
+PUBLIC void yyparse_cache(long max_bytes, const char *dir) {
+  cache_limit = max_bytes;
+  if (cache_dir) {
+    yymemfree(cache_dir);
+    yymemfree(cache_path);
+  }
+  cache_dir = cache_path = 0;
+  if (dir) {
+    cache_dir = (char *) yymemalloc(strlen(dir) + 1);
+    cache_path = (char *) yymemalloc(2 * (strlen(dir) + CACHENAMESIZE));
+    if (! cache_dir || ! cache_path) {
+      yymallocerror();
+    }
+    strcpy(cache_dir, dir);
+  }
+  trim_cache();
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * parse the source text, or replay its log if it has been parsed before
+ * returns the result of yyparse() or yyreplay()
+ */
+PUBLIC int yyparse_cached() {
+  struct cachekey k;
+  struct cacheentry *e;
+  unsigned char *log;
+  long length;
+  int result;
+
+  if (! yysource_text() || (cache_limit == 0 && ! cache_dir)) {
+    return yyparse();
+  }
+  source_key(&k);
+  e = lookup_entry(&k);
+  if (e) {
+    unlink_entry(e);
+    make_newest(e);
+    result = yyreplay(e->log, e->length);
+    if (result != YYPARSE_BADLOG) {
+      cache_stats.hits++;
+      return result;
+    }
+    drop_entry(e);
+  }
+  if (cache_dir && read_cache_file(&k, &log, &length)) {
+    result = yyreplay(log, length);
+    if (result != YYPARSE_BADLOG) {
+      cache_stats.disk_hits++;
+      keep_entry(&k, log, length);
+      return result;
+    }
+    yymemfree(log);
+  }
+
+  cache_stats.misses++;
+  captured_log = 0;
+  log_capture = 1;
+  result = yyparse();
+  log_capture = 0;
+  if (captured_log) {
+    if (cache_dir) {
+      write_cache_file(&k, captured_log, captured_length);
+    }
+    keep_entry(&k, captured_log, captured_length);
+    captured_log = 0;
+  }
+  return result;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PUBLIC struct yycachestatistics *yyparse_cache_statistics() {
+  return &cache_stats;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * drop all logs kept in memory (the files are not removed)
+ */
+PUBLIC void yyparse_cache_clear() {
+  while (cache_oldest) {
+    drop_entry(cache_oldest);
+  }
+  if (cache_buckets) {
+    yymemfree(cache_buckets);
+  }
+  cache_buckets = 0;
+  cache_bucket_count = 0;
+}
+
+#endif
+
+/*============================================================================*/
+/* RETURN LEFTPARSE STEP BY STEP                                              */
+/*============================================================================*/
+
+/*
+ * when the recognizer has terminated
+ * leftpointers and sub pointers represent the parse tree
+ * (starting with the item YYSTART : UserRoot EOF * )
+ * the function 'yyselect' returns the rule number
+ * one after each other in the order of a left derivation
+ * as required by the tree walker implemented in yyactions.c
+ * it uses a stack to keep track of items that need to be processed later
+ *
+ * with option LINEARWALK the whole left-derivation is computed by
+ * 'linearize' before the tree walker is invoked and stored in the array
+ * 'derivation', 'yyselect' then simply returns the next element
+ */
+
+#define STACKINCR 200
+int STACKSIZE;
+int *stack;
+int stptr = 0;
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * push item index n onto the stack
+ */
+PRIVATE push(int n) {
+  if (stptr == STACKSIZE - 2) {
+    STACKSIZE += STACKINCR;
+    stack = (int *) yymemrealloc(stack, sizeof(int) * STACKSIZE);
+    if (! stack) {
+      yymallocerror();
+    }
+    COUNTN(bytes_allocated, sizeof(int) * STACKINCR);
+  }
+  stack[stptr++] = n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * pop an item index from the stack and return the value
+ */
+PRIVATE int pop() {
+  stptr--;
+  return stack[stptr];
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Init stack
+ * push index of 'item'
+ */
+PRIVATE init_stack() {
+  stptr = 0;
+  if (stack) {
+    /* the stack of the previous parse is reused (option KEEPMEMORY) */
+    return;
+  }
+  STACKSIZE = STACKINCR;
+  stack = (int *) yymemalloc(sizeof(int) * STACKSIZE);
+  if (! stack) {
+    yymallocerror();
+  }
+  COUNTN(bytes_allocated, sizeof(int) * STACKSIZE);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release the stack
+ */
+PRIVATE release_stack() {
+  if (stack) {
+    yymemfree(stack);
+  }
+  stack = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * return the next rule number (for the left-derivation)
+ * or -1 if the stack is empty
+ *
+ * the stack always contains pointers to items that still must be processed
+ * to produce a left-derivation
+ * the top element must be processed first
+ * if the dot appears inside a rule
+ *    M : alpha N * beta
+ * then the items representing the parse for beta are already on the stack
+ * and the items representing alpha N must be pushed
+ * they are represented by the sub pointer of the item
+ * (corresponding to the parse for N)
+ * and the leftpointer of the item
+ * (corresponding to the parse for alpha)
+ * if the item has the form
+ *    M : gamma *
+ * (i.e. the rule has been completed)
+ * first the items representing gamma are pushed
+ * then the rule number is returned
+ * subsequent calls will process the items
+ * representing gamma
+ *
+ */
+PRIVATE int next_rule() {
+  int i;
+  while (stptr > 0) {
+    i = pop();
+#if SPPF
+    if (packed[i]) {
+      long l, s;
+
+      select_alternative(i, &l, &s);
+      if (s) {
+        push(s);
+      }
+      if (l) {
+        push(l);
+      }
+      if (yygrammar[dot[i]] < 0) {
+        return yygrammar[dot[i] + 1];
+      }
+      continue;
+    }
+#endif
+    if (sub[i]) {
+      push(sub[i]);
+    }
+    if (left[i]) {
+      push(left[i]);
+    }
+    if (yygrammar[dot[i]] < 0) {
+      return yygrammar[dot[i] + 1];
+    }
+  }
+  return -1;
+}
+
+#if LINEARWALK
+
+/*----------------------------------------------------------------------------*/
+
+#define DERIVATIONINCR 4096
+int *derivation = 0;
+long derivation_length = 0;
+long derivation_room = 0;
+THREADLOCAL long derivation_cursor = 0;
+
+#if SUBTREESKIP
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * with option SUBTREESKIP (which requires LINEARWALK) a semantic action
+ * may call yyskip() to pass over the members of its alternative
+ * that have not yet been walked
+ *
+ * for each element p of 'derivation' 'compute_extents' determines
+ * the end of the subtree of p (subtree_end[p]) and
+ * the number of tokens covered by it (subtree_tokens[p])
+ * 'yyselect' keeps the rules whose alternatives are being walked
+ * on the stack 'open_rules', with the number of their children selected
+ * yyskip() notes how many nonterminal members of the innermost such rule
+ * remain, the walker still calls their functions:
+ * for them 'yyselect' moves the derivation and the token cursor
+ * past their subtree and returns 0 (no alternative), so they return at once
+ * (the remaining terminal members read their own tokens)
+ */
+
+long *subtree_end = 0;
+long *subtree_tokens = 0;
+long subtree_room = 0;
+
+struct openrule {
+  long pos;                        /* index in 'derivation' */
+  long token;                      /* index of its first token */
+  long children;                   /* nonterminal members selected */
+};
+
+THREADLOCAL struct openrule *open_rules = 0;
+THREADLOCAL long open_count = 0;
+THREADLOCAL long open_room = 0;
+
+int *rule_nonterms = 0;            /* number of nonterminal members */
+int *rule_terms = 0;               /* number of terminal members */
+int *rule_alt = 0;                 /* index of the alternative in yygrammar */
+int rule_limit = 0;                /* largest rule number + 1 */
+
+THREADLOCAL long pending_skips = 0;   /* skipped members still to be selected */
+THREADLOCAL long skip_token_end = 0;  /* end of the tokens of the skipped rule */
+
+extern long yytokenindex();
+extern void skip_lexvals();
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * count the members of each rule
+ *
+ * yygrammar holds the alternatives one after the other:
+ *    next alternative, members, -(left hand side), rule number
+ */
+PRIVATE void init_rule_members() {
+  int i, j, rule, max_rule;
+
+  if (rule_nonterms) {
+    return;
+  }
+  max_rule = 0;
+  for (i = 1; i <= c_length; i = j + 2) {
+    for (j = i + 1; yygrammar[j] >= 0; j++) {
+    }
+    if (yygrammar[j + 1] > max_rule) {
+      max_rule = yygrammar[j + 1];
+    }
+  }
+  rule_limit = max_rule + 1;
+  rule_nonterms = (int *) yymemalloc(rule_limit * sizeof(int));
+  rule_terms = (int *) yymemalloc(rule_limit * sizeof(int));
+  rule_alt = (int *) yymemalloc(rule_limit * sizeof(int));
+  if (! rule_nonterms || ! rule_terms || ! rule_alt) {
+    yymallocerror();
+  }
+  for (i = 1; i <= c_length; i = j + 2) {
+    for (j = i + 1; yygrammar[j] >= 0; j++) {
+    }
+    rule = yygrammar[j + 1];
+    rule_alt[rule] = i;
+    rule_nonterms[rule] = rule_terms[rule] = 0;
+    for (j = i + 1; yygrammar[j] >= 0; j++) {
+      if (yygrammar[j] >= term_base) {
+        rule_terms[rule]++;
+      } else {
+        rule_nonterms[rule]++;
+      }
+    }
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * compute subtree_end and subtree_tokens for 'derivation'
+ *
+ * the derivation is processed from right to left,
+ * 'roots' holds the subtrees following the current element,
+ * the first one on top
+ * (the subtrees of the children of a rule are the next ones)
+ */
+PRIVATE void compute_extents() {
+  long *roots;
+  long top = 0;
+  long p, q, k;
+
+  init_rule_members();
+  if (derivation_length > subtree_room) {
+    subtree_room = derivation_room;
+    subtree_end = (long *)
+                  yymemrealloc(subtree_end, subtree_room * sizeof(long));
+    subtree_tokens = (long *)
+                     yymemrealloc(subtree_tokens, subtree_room * sizeof(long));
+    if (! subtree_end || ! subtree_tokens) {
+      yymallocerror();
+    }
+  }
+  roots = (long *) yymemalloc((derivation_length + 1) * sizeof(long));
+  if (! roots) {
+    yymallocerror();
+  }
+  for (p = derivation_length - 1; p >= 0; p--) {
+    subtree_end[p] = p + 1;
+    subtree_tokens[p] = rule_terms[derivation[p]];
+    for (k = rule_nonterms[derivation[p]]; k > 0; k--) {
+      q = roots[--top];
+      subtree_end[p] = subtree_end[q];
+      subtree_tokens[p] += subtree_tokens[q];
+    }
+    roots[top++] = p;
+  }
+  yymemfree(roots);
+
+  open_count = 0;
+  pending_skips = 0;
+  skip_token_end = 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * note that the alternative at 'derivation_cursor' is being walked
+ * rules whose subtrees end before it have been completed
+ */
+PRIVATE void open_rule() {
+  while (open_count > 0 &&
+         subtree_end[open_rules[open_count - 1].pos] <= derivation_cursor) {
+    open_count--;
+  }
+  if (open_count > 0) {
+    /* the parent of the new rule */
+    open_rules[open_count - 1].children++;
+  }
+  if (open_count == open_room) {
+    open_room = open_room ? 2 * open_room : 256;
+    open_rules = (struct openrule *)
+                 yymemrealloc(open_rules, open_room * sizeof(struct openrule));
+    if (! open_rules) {
+      yymallocerror();
+    }
+  }
+  open_rules[open_count].pos = derivation_cursor;
+  open_rules[open_count].token = yytokenindex() + 1;
+  open_rules[open_count].children = 0;
+  open_count++;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * skip the members of the current alternative that have not been walked
+ * (to be called from a semantic action)
+ *
+ * the current alternative is the innermost one with members still to walk
+ * (so a call from an action after the last member of an alternative
+ * refers to the enclosing alternative)
+ * the remaining nonterminal members of the alternative are not walked:
+ * their attributes are undefined and their actions are not executed,
+ * the actions of the alternative itself are executed
+ * and its terminal members still get their lexical values
+ * returns 1 if members have been skipped, 0 otherwise
+ */
+PUBLIC int yyskip() {
+  long token = yytokenindex() + 1;
+  long p, token_end;
+
+#if DERIVATIONLOG
+  /* a log must hold the whole derivation */
+  if (log_walk || replaying) {
+    return 0;
+  }
+#endif
+  if (pending_skips > 0 || token < skip_token_end) {
+    /* the alternative is being skipped already */
+    return 1;
+  }
+  while (open_count > 0) {
+    p = open_rules[open_count - 1].pos;
+    token_end = open_rules[open_count - 1].token + subtree_tokens[p];
+    if (derivation_cursor < subtree_end[p] || token < token_end) {
+      break;
+    }
+    open_count--;
+  }
+  if (open_count == 0) {
+    return 0;
   }
+  pending_skips = rule_nonterms[derivation[p]] -
+                  open_rules[open_count - 1].children;
+  skip_token_end = token_end;
+  return 1;
 }
 
-/*============================================================================*/
-/* EARLEY                                                                     */
-/*============================================================================*/
+/*----------------------------------------------------------------------------*/
 
 /*
- * An item with dot d, backpointer b, leftpointer l, subpointer s
- * has been preliminary added to the current list at position
- * last_item+1 (sentinel)
- * if there is no other item with dot d and backpointer b
- * make this item permanent
- * otherwise, if the old item has a different backpointer/subpointer
- * then an ambiguity is detected
- * if the backpointer/subpointer is the same
- * the new item is already present
+ * release the tables used by yyskip()
  */
-PRIVATE SEARCH(int d, int b, int l, int s) {
-  register long i;
-
-  i = thislist;
-
-  while ((dot[i] != d) || (back[i] != b)) {
-    i++;
+PRIVATE void release_extents() {
+  if (subtree_end) {
+    yymemfree(subtree_end);
   }
+  if (subtree_tokens) {
+    yymemfree(subtree_tokens);
+  }
+  if (open_rules) {
+    yymemfree(open_rules);
+  }
+  subtree_end = subtree_tokens = 0;
+  subtree_room = 0;
+  open_rules = 0;
+  open_room = 0;
+  open_count = 0;
+}
 
-  if (i == last_item + 1) {
-    last_item++;
-    if (last_item == (ITEMLIMIT - 2)) {
-      table_full();
-    }
-#if HASHING
-    sethash(d, b);
 #endif
-  } else {
 
-#if DETECTAMBIGUITY
-    if (left[i] != l) {
-      conjunctive_ambiguity(i, d, l, s);
+/*----------------------------------------------------------------------------*/
 
-    } else if (sub[i] != s) {
-      disjunctive_ambiguity(i, d, l, s);
-    }
-#endif
+/*
+ * compute the left-derivation of the tree represented by item 'root'
+ * in one pass and store the rule numbers in 'derivation'
+ */
+PRIVATE void linearize(int root) {
+  int rule;
 
+  init_stack();
+  push(root);
+  derivation_length = 0;
+  derivation_cursor = 0;
+  while ((rule = next_rule()) >= 0) {
+    if (derivation_length == derivation_room) {
+      derivation_room += derivation_room ? derivation_room : DERIVATIONINCR;
+      derivation = (int *)
+                   yymemrealloc(derivation, derivation_room * sizeof(int));
+      if (! derivation) {
+        yymallocerror();
+      }
+    }
+    derivation[derivation_length++] = rule;
   }
+#if SUBTREESKIP
+  compute_extents();
+#endif
 }
 
+#if PARALLELWALK
+
 /*----------------------------------------------------------------------------*/
 
 /*
- * add an item with dot d, backpointer b, leftpointer l, and subpointer s
- * to the current item list
- * if there is already an item with dot d and backpointer b
- * then the grammar is ambigous (see 'SEARCH', which actually adds the item)
+ * with option PARALLELWALK (which requires LINEARWALK and SUBTREESKIP)
+ * the elements of the nonterminal named by 'accent -parallel name'
+ * are walked by a pool of threads while the main walk proceeds
  *
- * hash optimization:
- * if there is no item with the same hash code for d and b
- * it is not neccessary to invoke SEARCH because the item is unique in the
- * current list
+ * 'find_tasks' collects the outermost occurrences of the nonterminal
+ * in the derivation (its rules are listed in yyparallel_rules),
+ * a worker walks such a task by calling yyparallel_walk()
+ * with its own derivation and token cursor (they are thread local)
+ * and stores the output attributes in 'task_results'
+ * when the main walk reaches the occurrence, the generated function
+ * calls yyparallel_result(): it waits for the task and moves the cursors
+ * past its subtree, a task not yet started is walked by the main thread
+ *
+ * the semantic actions of the nonterminal must not depend on each other
+ * and must be thread safe (as must be the allocator, see yyset_allocator),
+ * occurrences that the main walk skips with yyskip() are walked anyway
+ *
+ * yylval is thread local in the generated code, yypos is not:
+ * get_lexval() leaves it alone in a worker (see yyparallel_worker),
+ * the actions walked there use yylexpos(yytokenindex())
+ * the walk is not parallel if a derivation log is written,
+ * so the workers never reach log_rule()
  */
-PRIVATE additem(int d, int b, int l, int s) {
 
-  /* sentinel */
-  dot [ last_item + 1 ] = d;
-  back[ last_item + 1 ] = b;
-  left[ last_item + 1 ] = l;
-  sub [ last_item + 1 ] = s;
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
 
-#if HASHING
-  if (! hashed(d, b)) {
-    last_item++;
-    if (last_item == (ITEMLIMIT - 2)) {
-      table_full();
+#define TASK_FREE 0
+#define TASK_CLAIMED 1
+#define TASK_DONE 2
+
+struct walktask {
+  long pos;                        /* index in 'derivation' */
+  long token;                      /* index of its first token */
+  int state;                       /* TASK_... */
+};
+
+struct walktask *tasks = 0;
+long task_count = 0;
+long task_room = 0;
+char *task_results = 0;
+long results_room = 0;
+long next_task = 0;                /* next task for the workers */
+long main_task = 0;                /* next task met by the main walk */
+
+char *parallel_rule = 0;           /* rules of the parallel nonterminal */
+
+#define MAXWORKERS 64
+pthread_t workers[MAXWORKERS];
+int worker_count = 0;
+int parallel_threads = 0;          /* 0: one for each processor */
+pthread_mutex_t task_lock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t task_done = PTHREAD_COND_INITIALIZER;
+
+THREADLOCAL int in_worker = 0;
+
+extern int yyparallel_rules[];
+extern int yyparallel_width;
+extern void yyparallel_walk();
+extern void init_lexelem();
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * set the number of threads of the parallel walk
+ * (including the main thread, 0: one for each processor)
+ */
+PUBLIC void yyparallel_threads(int n) {
+  parallel_threads = n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void add_task(long pos, long token) {
+  if (task_count == task_room) {
+    task_room = task_room ? 2 * task_room : 256;
+    tasks = (struct walktask *)
+            yymemrealloc(tasks, task_room * sizeof(struct walktask));
+    if (! tasks) {
+      yymallocerror();
     }
-    sethash(d, b);
-  } else {
-#endif
-    SEARCH(d, b, l, s);
-#if HASHING
   }
-#endif
-
+  tasks[task_count].pos = pos;
+  tasks[task_count].token = token;
+  tasks[task_count].state = TASK_FREE;
+  task_count++;
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * compute the kernel of the next item list
- * prevlist points to the previous list
+ * collect the outermost occurrences of the parallel nonterminal
  *
- * KERNEL[i] =
- *    {
- *       < N : alpha yygrammar[i] * beta, B,I,0 >
- *    |
- *       < N : alpha * yygrammar[i] beta, B,_,_ > is in IL[i-1] and has index I
- *    }
+ * the walk is simulated: 'members' holds for each rule being walked
+ * the index of its next member in yygrammar,
+ * a nonterminal member corresponds to the next element of 'derivation'
  */
-PRIVATE kernel(long prevlist) {
-  long i;
-  i = prevlist;
-  while (dot[i]) {
-    if (yygrammar[dot[i]] >= term_base) {
-      if (yygrammar[dot[i]] == sym) {
-#if CHECKVIABLE
-        if (is_viable(dot[i] + 1) || lookaheadswitchedoff)
-#endif
-        {
-          additem(dot[i] + 1, back[i], i, 0);
-        }
-#if CHECKVIABLE
-        else {
-#if TRACE
-          printf("rejected by is_viable (kernel)\n");
-#endif
-        }
-#endif
-      }
+PRIVATE void find_tasks() {
+  long *members;
+  long top = 0;
+  long p = 0;
+  long token = 0;
+  long j;
+  int *r;
+
+  task_count = 0;
+  if (! parallel_rule) {
+    parallel_rule = (char *) yymemalloc(rule_limit);
+    if (! parallel_rule) {
+      yymallocerror();
+    }
+    memset(parallel_rule, 0, rule_limit);
+    for (r = yyparallel_rules; *r; r++) {
+      parallel_rule[*r] = 1;
+    }
+  }
+  if (derivation_length == 0) {
+    return;
+  }
+  members = (long *) yymemalloc((derivation_length + 1) * sizeof(long));
+  if (! members) {
+    yymallocerror();
+  }
+  members[top++] = rule_alt[derivation[p++]] + 1;
+  while (top > 0) {
+    j = members[top - 1]++;
+    if (yygrammar[j] < 0) {
+      top--;
+    } else if (yygrammar[j] >= term_base) {
+      token++;
+    } else if (parallel_rule[derivation[p]]) {
+      add_task(p, token);
+      token += subtree_tokens[p];
+      p = subtree_end[p];
+    } else {
+      members[top++] = rule_alt[derivation[p++]] + 1;
     }
-    i++;
   }
+  yymemfree(members);
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE int claim_task(long i) {
+  return __sync_bool_compare_and_swap(&tasks[i].state, TASK_FREE,
+                                      TASK_CLAIMED);
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * predictor step for item 'item'
- *
- * PREDICTOR:
- * The dot is before a nonterm
- * add the rules for that nonterm (with the dot at the beginning)
- *
- * If
- *    < N : alpha * M beta, B,L,S >
- * is in IL
- * then add
- *    < M : * gamma, B',0,0 >
- * if there is not yet an an item with the first two components
- * and there is a rule N : gamma
- * B' is a reference to IL[i]
+ * walk task i in a worker
  */
-PRIVATE predictor(long item) {
-  long ruleptr;
+PRIVATE void walk_task(long i) {
+  derivation_cursor = tasks[i].pos;
+  open_count = 0;
+  pending_skips = 0;
+  skip_token_end = 0;
+  init_lexelem();
+  skip_lexvals(tasks[i].token);
+  yyparallel_walk(task_results + i * yyparallel_width);
 
-  ruleptr = yygrammar[dot[item]];
-  do {
-    int old = last_item;
+  pthread_mutex_lock(&task_lock);
+  STORE_RELEASE(tasks[i].state, TASK_DONE);
+  pthread_cond_broadcast(&task_done);
+  pthread_mutex_unlock(&task_lock);
+}
 
-#if ! LOOKAHEAD
-    /* (1) ORIGINAL VERSION */
-    additem(ruleptr + 1, thislist, 0, 0);
-    if ((back[last_item] == thislist) && (last_item > old)) {
-      specialitemadded = 1;
-    }
-#else
-    /* (2) IMPROVEMENT
-    add test: is current symbol (lookaheadsym)
-     in director set of that rule ?
-        */
-    if (lookup_dirset(ruleptr) || lookaheadswitchedoff) {
-      additem(ruleptr + 1, thislist, 0, 0);
-      if ((back[last_item] == thislist) && (last_item > old)) {
-        specialitemadded = 1;
-      }
-    } else {
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void *walk_worker(void *arg) {
+  long i;
+
+  in_worker = 1;
+  while ((i = __sync_fetch_and_add(&next_task, 1)) < task_count) {
+    if (claim_task(i)) {
+      walk_task(i);
     }
-#endif
+  }
+  if (open_rules) {
+    yymemfree(open_rules);
+  }
+  open_rules = 0;
+  open_room = 0;
+  return 0;
+}
 
-    ruleptr = yygrammar[ruleptr];
+/*----------------------------------------------------------------------------*/
 
-  } while (ruleptr);
+/*
+ * find the tasks and start the workers
+ * (after 'linearize', before the main walk)
+ */
+PRIVATE void start_parallel_walk() {
+  long n;
+
+#if DERIVATIONLOG
+  if (log_walk) {
+    /* the log is written by the main walk */
+    task_count = 0;
+    return;
+  }
+#endif
+  find_tasks();
+  next_task = 0;
+  main_task = 0;
+  if (task_count == 0) {
+    return;
+  }
+  if (task_count * yyparallel_width > results_room) {
+    results_room = task_count * yyparallel_width;
+    task_results = (char *) yymemrealloc(task_results, results_room);
+    if (! task_results) {
+      yymallocerror();
+    }
+  }
+
+  n = parallel_threads ? parallel_threads : sysconf(_SC_NPROCESSORS_ONLN);
+  n--;                             /* the main thread walks as well */
+  if (n > task_count) {
+    n = task_count;
+  }
+  if (n > MAXWORKERS) {
+    n = MAXWORKERS;
+  }
+  for (worker_count = 0; worker_count < n; worker_count++) {
+    if (pthread_create(&workers[worker_count], 0, walk_worker, 0) != 0) {
+      /* the remaining tasks are walked by the main thread */
+      break;
+    }
+  }
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * completer step for item 'item'
- *
- * COMPLETER
- * The dot is at the end of a rule
- * add the item that triggered this rule to be included
- * where the dot is advanced after the nonterm
- *
- * If
- *    < M : gamma * , B,L,S >
- * is in CL (with index ITEM)
- * and there is an item
- *    < N : alpha * M beta, B',L',S' >
- * in the item list to which the back-pointer B refers (with index I)
- * then add
- *    < N : alpha M * beta, B',I,ITEM >
- * if there is not yet an item with the first two components
+ * wait for the workers (after the main walk)
  */
-PRIVATE completer(long item) {
-  long lhs, old;
-  register int i;
-  int dot_i;
+PRIVATE void finish_parallel_walk() {
+  int i;
 
-  lhs = -yygrammar[dot[item]];
-  i = back[item];
+  for (i = 0; i < worker_count; i++) {
+    pthread_join(workers[i], 0);
+  }
+  worker_count = 0;
+  task_count = 0;
+}
 
-  /* loop over all items in earlier item list */
-  dot[last_item + 1] = 0; /* sentinel */
-  while (dot_i = dot[i]) {
+/*----------------------------------------------------------------------------*/
 
-    if (yygrammar[/*dot[i]*/dot_i] == lhs) {
+/*
+ * 1 in a worker thread (called by the generated get_lexval)
+ */
+PUBLIC int yyparallel_worker() {
+  return in_worker;
+}
 
-#if CHECKVIABLE
-      if (is_viable(/*dot[i]*/dot_i + 1) || lookaheadswitchedoff)
-#endif
-      {
-        old = last_item;
-        additem(/*dot[i]*/dot_i + 1, back[i], i, item);
-        dot[last_item + 1] = 0; /* sentinel */
-        if ((back[i] == thislist) && (last_item > old)) {
-          specialitemadded = 1;
-        }
-      }
-#if CHECKVIABLE
-      else {
-#if TRACE
-        printf("rejected by is_viable (completer)\n");
+/*----------------------------------------------------------------------------*/
+
+/*
+ * called by the function of the parallel nonterminal before it selects
+ * an alternative: returns the output attributes if this occurrence
+ * has been walked by a worker, 0 if it must be walked now
+ */
+PUBLIC void *yyparallel_result() {
+  long i;
+
+  if (in_worker || pending_skips > 0) {
+    return 0;
+  }
+#if DERIVATIONLOG
+  if (replaying) {
+    return 0;
+  }
 #endif
-      }
+  while (main_task < task_count && tasks[main_task].pos < derivation_cursor) {
+    main_task++;
+  }
+  if (main_task == task_count || tasks[main_task].pos != derivation_cursor) {
+    return 0;
+  }
+  i = main_task++;
+  if (claim_task(i)) {
+    /* not started by a worker */
+    return 0;
+  }
+  pthread_mutex_lock(&task_lock);
+  while (LOAD_ACQUIRE(tasks[i].state) != TASK_DONE) {
+    pthread_cond_wait(&task_done, &task_lock);
+  }
+  pthread_mutex_unlock(&task_lock);
+
+  derivation_cursor = subtree_end[tasks[i].pos];
+  skip_lexvals(subtree_tokens[tasks[i].pos]);
+  return task_results + i * yyparallel_width;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release the tasks and their results
+ */
+PRIVATE void release_tasks() {
+  if (tasks) {
+    yymemfree(tasks);
+  }
+  if (task_results) {
+    yymemfree(task_results);
+  }
+  tasks = 0;
+  task_results = 0;
+  task_room = 0;
+  results_room = 0;
+  task_count = 0;
+}
+
 #endif
-    }
 
-    i++;
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release the array holding the derivation
+ */
+PRIVATE void release_derivation() {
+  if (derivation) {
+    yymemfree(derivation);
   }
+  derivation = 0;
+  derivation_length = 0;
+  derivation_room = 0;
+#if SUBTREESKIP
+  release_extents();
+#endif
+#if PARALLELWALK
+  release_tasks();
+#endif
 }
 
+#endif
+
 /*----------------------------------------------------------------------------*/
 
 /*
- * compute closure for the kernel of the current item list
+ * return the next rule number (for the left-derivation)
  *
- * CLOSURE
- * apply PREDICTOR and COMPLETOR
- * as long as there are changes
+ * this function is called by the generated tree walker
  */
-PRIVATE closure() {
-  long i;
-  int oldend;
+PUBLIC int yyselect() {
+  int rule;
+#if DERIVATIONLOG
+  if (replaying) {
+    unsigned long logged;
 
-  specialitemadded = 0;
-  do {
-    i = thislist;
-    oldend = last_item;
-    while (i <= last_item) {
-      if (yygrammar[dot[i]] < 0) {
-        completer(i);
-      } else if (yygrammar[dot[i]] < term_base) {
-        predictor(i);
-      }
-      i++;
+    if (! get_varint(&logged)) {
+      /* not reached: yyreplay() has checked the log */
+      return 0;
     }
-    /*
-    } while (specialitemadded && (oldend!=last_item));
-    */
-  } while ((oldend != last_item));
+    return logged;
+  }
+#endif
+#if LINEARWALK
+#if SUBTREESKIP
+  if (pending_skips > 0) {
+    /* a member that yyskip() passes over, with its tokens */
+    pending_skips--;
+    skip_lexvals(subtree_tokens[derivation_cursor]);
+    derivation_cursor = subtree_end[derivation_cursor];
+    return 0;
+  }
+  open_rule();
+#endif
+  rule = derivation[derivation_cursor++];
+#else
+  rule = next_rule();
+#endif
+#if DERIVATIONLOG
+  if (log_walk) {
+    log_rule(rule);
+  }
+#endif
+  return rule;
 }
 
-/*----------------------------------------------------------------------------*/
+#if ASTBUILDER || EVENTSTREAM
+
+/*============================================================================*/
+/* RULE TABLE                                                                 */
+/*============================================================================*/
 
 /*
- * compute initial item list
- * its kernel is given by the item
- *    YYSTART : * UserRoot EOF
- * for which the closure is computed
+ * the alternative and the nonterminal of each rule number,
+ * for the tree builder and the event stream
  *
+ * subphrases (and YYSTART) are recognized by their names in yyprintname(),
+ * their members are attributed to the enclosing rule
  */
-PRIVATE initial_itemlist() {
 
-#if DYNAMICITEMS
-  ITEMLIMIT = ITEMINCR;
+#include <string.h>
 
-  dot = (long *) malloc(ITEMLIMIT * sizeof(long));
-  if (! dot) {
-    yymallocerror();
+/* for each rule number */
+PRIVATE int *rule_start = 0;         /* index of the alternative in yygrammar */
+PRIVATE int *rule_lhs = 0;           /* its nonterminal */
+PRIVATE char *rule_inline = 0;       /* members go to the enclosing rule */
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void init_rule_table() {
+  int i, j, rule, max_rule;
+  char *name;
+
+  if (rule_start) {
+    return;
   }
-  back = (long *) malloc(ITEMLIMIT * sizeof(long));
-  if (! back) {
-    yymallocerror();
+  max_rule = 0;
+  for (i = 1; i <= c_length; i = j + 2) {
+    for (j = i + 1; yygrammar[j] >= 0; j++) {
+    }
+    if (yygrammar[j + 1] > max_rule) {
+      max_rule = yygrammar[j + 1];
+    }
   }
-  left = (long *) malloc(ITEMLIMIT * sizeof(long));
-  if (! left) {
+  rule_start = (int *) yymemalloc((max_rule + 1) * sizeof(int));
+  rule_lhs = (int *) yymemalloc((max_rule + 1) * sizeof(int));
+  rule_inline = (char *) yymemalloc(max_rule + 1);
+  if (! rule_start || ! rule_lhs || ! rule_inline) {
     yymallocerror();
   }
-  sub = (long *) malloc(ITEMLIMIT * sizeof(long));
-  if (! sub) {
-    yymallocerror();
+  for (i = 1; i <= c_length; i = j + 2) {
+    for (j = i + 1; yygrammar[j] >= 0; j++) {
+    }
+    rule = yygrammar[j + 1];
+    rule_start[rule] = i;
+    rule_lhs[rule] = -yygrammar[j];
+    name = yyprintname(-yygrammar[j]);
+    rule_inline[rule] = strcmp(name, "Subphrase") == 0 ||
+                        strcmp(name, "YYSTART") == 0;
   }
-#endif
+}
 
-  thislist = 1;
-#if HASHING
-  clearhash();
-#endif
-  additem(2, 1, 0, 0); /*  YYSTART : * UserRoot EOF  */
-  closure();
-  additem(0, 0, 0, 0); /* terminator */
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void release_rule_table() {
+  if (rule_start) {
+    yymemfree(rule_start);
+    yymemfree(rule_lhs);
+    yymemfree(rule_inline);
+  }
+  rule_start = rule_lhs = 0;
+  rule_inline = 0;
 }
 
+#endif
 
-/*----------------------------------------------------------------------------*/
+#if ASTBUILDER
 
-int itemlist_empty;
+/*============================================================================*/
+/* TREE BUILDER                                                               */
+/*============================================================================*/
 
 /*
- * compute next item list:
- * kernel and closure
+ * With option ASTBUILDER, yyast_build() (called by the YYSTART function
+ * generated by 'accent -ast') builds the derivation tree from the rule
+ * numbers returned by yyselect(), without recursion.
+ *
+ * The nodes, their member arrays and the lexical values of the tokens
+ * are taken from an arena (a list of large blocks) by bumping a pointer,
+ * yyast_free() releases the whole tree.
+ *
+ * The members of anonymous subphrases (options, alternatives, loops)
+ * are inserted into the member array of the enclosing rule,
+ * hence the elements of a loop are one contiguous array.
  */
-PRIVATE next_itemlist() {
-  long prevlist;
 
+#define ARENABLOCK 65536
+#define ARENAALIGN 16
+#define ARENAROUND(n) (((n) + ARENAALIGN - 1) & ~(long) (ARENAALIGN - 1))
 
-#if HASHING
-  clearhash();
-#endif
+struct arenablock {
+  struct arenablock *next;
+};
 
-  itemlist_empty = 0;
-  prevlist = thislist;
-  thislist = last_item + 1;
+PRIVATE struct arenablock *arena_blocks = 0;
+PRIVATE char *arena_ptr = 0;
+PRIVATE char *arena_end = 0;
 
-  kernel(prevlist);
-  if (last_item < thislist) {
-    itemlist_empty = 1;
+PRIVATE struct yyastnode *ast_root = 0;
+
+/* members of the rules being built */
+PRIVATE struct yyastmember *ast_members = 0;
+PRIVATE long ast_member_count = 0;
+PRIVATE long ast_member_room = 0;
+
+/* rules being built */
+struct astframe {
+  int next;                          /* next member in yygrammar */
+  int rule;
+  long first;                        /* its first entry in ast_members */
+  long pos;                          /* of the first token, -1: none */
+};
+
+PRIVATE struct astframe *ast_frames = 0;
+PRIVATE long ast_frame_count = 0;
+PRIVATE long ast_frame_room = 0;
+
+extern void get_lexval();
+extern void *yylval_address();
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void *arena_alloc(long n) {
+  struct arenablock *b;
+  long size;
+  char *p;
+
+  n = ARENAROUND(n);
+  if (arena_end - arena_ptr < n) {
+    size = n > ARENABLOCK ? n : ARENABLOCK;
+    b = (struct arenablock *)
+        yymemalloc(ARENAROUND(sizeof(struct arenablock)) + size);
+    if (! b) {
+      yymallocerror();
+    }
+    b->next = arena_blocks;
+    arena_blocks = b;
+    arena_ptr = (char *) b + ARENAROUND(sizeof(struct arenablock));
+    arena_end = arena_ptr + size;
   }
-  closure();
-  additem(0, 0, 0, 0);
+  p = arena_ptr;
+  arena_ptr += n;
+  return p;
 }
 
 /*----------------------------------------------------------------------------*/
 
-/*
- * compute the sequence of item lists:
- * initial_itemlist
- * and then next_itemlist for each input token
- */
-PRIVATE itemlist_sequence() {
-#if ERRPOSCORRECTION
-  int saved_sym;
-  int saved_yypos;
-  int saved_thislist;
-  int saved_last_item;
-  int saved_saved_sym;
-  int saved_saved_yypos;
-  int saved_saved_thislist;
-  int saved_saved_last_item;
-  int initial_list;
-#endif
-  last_item = 0;
-  initial_itemlist();
+PRIVATE struct yyastmember *new_member() {
+  if (ast_member_count == ast_member_room) {
+    ast_member_room = ast_member_room ? 2 * ast_member_room : 1024;
+    ast_members = (struct yyastmember *)
+      yymemrealloc(ast_members, ast_member_room * sizeof(struct yyastmember));
+    if (! ast_members) {
+      yymallocerror();
+    }
+  }
+  return &ast_members[ast_member_count++];
+}
 
-#if ERRPOSCORRECTION
-  saved_sym = sym;
-  saved_yypos = yypos;
-  saved_thislist = thislist;
-  initial_list = thislist;
-  saved_last_item = last_item;
-#endif
-  do {
-    readsym();
+/*----------------------------------------------------------------------------*/
 
-#if ERRPOSCORRECTION
-    saved_saved_sym = saved_sym;
-    saved_saved_yypos = saved_yypos;
-    saved_saved_thislist = saved_thislist;
-    saved_saved_last_item = saved_last_item;
+PRIVATE void open_frame(int rule) {
+  struct astframe *f;
 
-    saved_sym = sym;
-    saved_yypos = yypos;
-    saved_thislist = thislist;
-    saved_last_item = last_item;
-#endif
-    next_itemlist();
-    if (itemlist_empty) {
-      break;
+  if (ast_frame_count == ast_frame_room) {
+    ast_frame_room = ast_frame_room ? 2 * ast_frame_room : 256;
+    ast_frames = (struct astframe *)
+      yymemrealloc(ast_frames, ast_frame_room * sizeof(struct astframe));
+    if (! ast_frames) {
+      yymallocerror();
     }
-  } while (sym != eofsym);
+  }
+  f = &ast_frames[ast_frame_count++];
+  f->next = rule_start[rule] + 1;
+  f->rule = rule;
+  f->first = ast_member_count;
+  f->pos = -1;
+}
 
+/*----------------------------------------------------------------------------*/
 
-  if (itemlist_empty) {
+/*
+ * all members of the innermost rule have been built:
+ * move them into a node (unless the rule is a subphrase)
+ */
+PRIVATE void close_frame() {
+  struct astframe *f;
+  struct yyastnode *n;
+  struct yyastmember *m;
+  long count;
+
+  f = &ast_frames[--ast_frame_count];
+  if (! rule_inline[f->rule]) {
+    count = ast_member_count - f->first;
+    n = (struct yyastnode *)
+        arena_alloc(sizeof(struct yyastnode) +
+                    count * sizeof(struct yyastmember));
+    n->rule = f->rule;
+    n->nonterm = rule_lhs[f->rule];
+    n->pos = f->pos >= 0 ? f->pos : yypos;
+    n->count = count;
+    n->member = (struct yyastmember *) (n + 1);
+    memcpy(n->member, ast_members + f->first,
+           count * sizeof(struct yyastmember));
+    ast_member_count = f->first;
+
+    m = new_member();
+    m->token = 0;
+    m->pos = n->pos;
+    m->node = n;
+    m->lexval = 0;
+  }
+  if (f->pos >= 0 && ast_frame_count > 0 &&
+      ast_frames[ast_frame_count - 1].pos < 0) {
+    ast_frames[ast_frame_count - 1].pos = f->pos;
+  }
+}
 
-#if ERRPOSCORRECTION
+/*----------------------------------------------------------------------------*/
 
-    /* switch off lookahead optimization and recompute
-     * last item lists
-     */
+/*
+ * build the tree of the current parse, the previous tree is released
+ */
+PUBLIC struct yyastnode *yyast_build() {
+  struct astframe *f;
+  struct yyastmember *m;
+  long lexval_size;
+  int j;
+
+  yyast_free();
+  init_rule_table();
+  lexval_size = yylval_size();
+  ast_member_count = 0;
+  ast_frame_count = 0;
+
+  open_frame(yyselect());
+  while (ast_frame_count > 0) {
+    f = &ast_frames[ast_frame_count - 1];
+    j = f->next++;
+    if (yygrammar[j] < 0) {
+      close_frame();
+    } else if (yygrammar[j] >= term_base) {
+      get_lexval();
+      if (f->pos < 0) {
+        f->pos = yypos;
+      }
+      m = new_member();
+      m->token = yygrammar[j] - term_base;
+      m->pos = yypos;
+      m->node = 0;
+      m->lexval = arena_alloc(lexval_size);
+      memcpy(m->lexval, yylval_address(), lexval_size);
+    } else {
+      open_frame(yyselect());
+    }
+  }
+  /* the members of YYSTART: the start symbol and the end of input */
+  ast_root = ast_members[0].node;
+  return ast_root;
+}
 
-    int p_saved_saved_yypos = saved_saved_yypos;
-    int p_saved_yypos = saved_yypos;
-    int p_yypos = yypos;
-    int p_lookaheadpos = lookaheadpos;
+/*----------------------------------------------------------------------------*/
 
-    lookaheadswitchedoff = 1;
+/*
+ * the tree built by the last call of yyast_build()
+ */
+PUBLIC struct yyastnode *yyast_root() {
+  return ast_root;
+}
 
-    if (saved_thislist == initial_list) {
-      thislist = saved_thislist;
-      last_item = saved_last_item;
-    } else {
-      thislist = saved_saved_thislist;
-      last_item = saved_saved_last_item;
-      sym = saved_saved_sym;
-      next_itemlist();
-      if (itemlist_empty) {
-        printf("-1-\n");
-        posforerrormsg = p_saved_saved_yypos;
-        syntaxerror();
-      }
-    }
+/*----------------------------------------------------------------------------*/
 
-    sym = saved_sym;
-    next_itemlist();
-    if (itemlist_empty) {
-      /*
-      printf("-2-\n");
-      */
-      posforerrormsg = p_saved_saved_yypos;
-      syntaxerror();
-    }
+/*
+ * release the tree
+ */
+PUBLIC void yyast_free() {
+  struct arenablock *b;
 
-    sym = lookaheadsym;
-    next_itemlist();
-    if (itemlist_empty) {
-      /*
-      printf("-3-\n");
-      */
-      posforerrormsg = p_saved_yypos;
-      syntaxerror();
-    }
+  while (arena_blocks) {
+    b = arena_blocks;
+    arena_blocks = b->next;
+    yymemfree(b);
+  }
+  arena_ptr = arena_end = 0;
+  ast_root = 0;
+}
 
-    printf("PROGRAM ERROR\n");
-    exit(1);
-#else
-    syntaxerror();
-#endif
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release the tables of the builder (but not the tree)
+ */
+PRIVATE void release_ast_tables() {
+  if (ast_members) {
+    yymemfree(ast_members);
+  }
+  if (ast_frames) {
+    yymemfree(ast_frames);
   }
+  ast_members = 0;
+  ast_frames = 0;
+  ast_member_room = ast_frame_room = 0;
 }
 
+#endif
+
+#if EVENTSTREAM
+
 /*============================================================================*/
-/* RETURN LEFTPARSE STEP BY STEP                                              */
+/* EVENT STREAM                                                               */
 /*============================================================================*/
 
 /*
- * when the recognizer has terminated
- * leftpointers and sub pointers represent the parse tree
- * (starting with the item YYSTART : UserRoot EOF * )
- * the function 'yyselect' returns the rule number
- * one after each other in the order of a left derivation
- * as required by the tree walker implemented in yyactions.c
- * it uses a stack to keep track of items that need to be processed later
+ * With option EVENTSTREAM, the derivation can be consumed as a sequence
+ * of events instead of being walked by the generated YYSTART:
+ *
+ *    YYEVENT_ENTER   a rule is entered
+ *    YYEVENT_TOKEN   a token of the innermost rule
+ *    YYEVENT_EXIT    all members of the innermost rule have been seen
+ *
+ * After yyevents_callback(f, data), yyparse() (and yyforest_walk(),
+ * yyreplay()) pass each event to f instead of calling YYSTART.
+ * After yyevents_iterate(1), yyparse() returns after recognition and
+ * the events are fetched by yyevent_next(), the memory of the parse is
+ * released when the last event has been fetched or by yyevents_release().
+ *
+ * Subphrases and YYSTART give no events (as in the tree builder).
+ * The events are computed from yyselect() and get_lexval() with an
+ * explicit stack of open rules, no memory is allocated per event.
  */
 
-#define STACKINCR 200
-int STACKSIZE;
-int *stack;
-int stptr = 0;
+struct eventframe {
+  int next;                          /* next member in yygrammar */
+  int rule;
+  int owner;                         /* innermost rule that is not inline */
+};
+
+PRIVATE struct eventframe *event_frames = 0;
+PRIVATE long event_count = 0;
+PRIVATE long event_room = 0;
+
+PRIVATE yyevent_function event_function = 0;
+PRIVATE void *event_data = 0;
+PRIVATE int event_iterate = 0;
+PRIVATE int events_held = 0;         /* parse kept for yyevent_next() */
+
+extern void get_lexval();
+extern void *yylval_address();
+extern long yytokenindex();
+extern long yytokencount();
+extern long yylexpos();
+
+PRIVATE void finish_parse();
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * push item index n onto the stack
+ * stream the events of the following parses to f (0: call YYSTART)
  */
-PRIVATE push(int n) {
-  if (stptr == STACKSIZE - 2) {
-    STACKSIZE += STACKINCR;
-    stack = (int *) realloc(stack, sizeof(int) * STACKSIZE);
-    if (! stack) {
+PUBLIC void yyevents_callback(yyevent_function f, void *data) {
+  event_function = f;
+  event_data = data;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * on != 0: yyparse() returns before the tree walk,
+ * the events are then fetched by yyevent_next()
+ */
+PUBLIC void yyevents_iterate(int on) {
+  event_iterate = on;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void push_event_frame(int rule, int owner) {
+  struct eventframe *f;
+
+  if (event_count == event_room) {
+    event_room = event_room ? 2 * event_room : 256;
+    event_frames = (struct eventframe *)
+      yymemrealloc(event_frames, event_room * sizeof(struct eventframe));
+    if (! event_frames) {
       yymallocerror();
     }
   }
-  stack[stptr++] = n;
+  f = &event_frames[event_count++];
+  f->next = rule_start[rule] + 1;
+  f->rule = rule;
+  f->owner = owner;
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * pop an item index from the stack and return the value
+ * the walk starts with the rule of YYSTART
  */
-PRIVATE int pop() {
-  stptr--;
-  return stack[stptr];
+PRIVATE void start_events() {
+  init_rule_table();
+  event_count = 0;
+  push_event_frame(yyselect(), 0);
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * Init stack
- * push index of 'item'
+ * the position of the next token (for an ENTER event)
  */
-PRIVATE init_stack() {
-  STACKSIZE = STACKINCR;
-  stack = (int *) malloc(sizeof(int) * STACKSIZE);
-  if (! stack) {
-    yymallocerror();
-  }
+PRIVATE long next_token_pos() {
+  long i = yytokenindex() + 1;
+
+  return i < yytokencount() ? yylexpos(i) : yypos;
 }
 
 /*----------------------------------------------------------------------------*/
 
 /*
- * return the next rule number (for the left-derivation)
- *
- * this function is called by the generated tree walker
- *
- * the stack always contains pointers to items that still must be processed
- * to produce a left-derivation
- * the top element must be processed first
- * if the dot appears inside a rule
- *    M : alpha N * beta
- * then the items representing the parse for beta are already on the stack
- * and the items representing alpha N must be pushed
- * they are represented by the sub pointer of the item
- * (corresponding to the parse for N)
- * and the leftpointer of the item
- * (corresponding to the parse for alpha)
- * if the item has the form
- *    M : gamma *
- * (i.e. the rule has been completed)
- * first the items representing gamma are pushed
- * then the rule number is returned
- * subsequent calls will process the items
- * representing gamma
+ * fetch the next event of the derivation
+ * returns 0 if there are no more events
  *
+ * the lexical value of a token event is valid until the next event
  */
-PUBLIC int yyselect() {
-  int i;
-  while (1) {
-    i = pop();
-    if (sub[i]) {
-      push(sub[i]);
-    }
-    if (left[i]) {
-      push(left[i]);
-    }
-    if (yygrammar[dot[i]] < 0) {
-      return yygrammar[dot[i] + 1];
+PUBLIC int yyevent_next(struct yyevent *e) {
+  struct eventframe *f;
+  int j, rule;
+
+  while (event_count > 0) {
+    f = &event_frames[event_count - 1];
+    j = f->next++;
+    if (yygrammar[j] < 0) {
+      event_count--;
+      if (! rule_inline[f->rule]) {
+        e->kind = YYEVENT_EXIT;
+        e->rule = f->rule;
+        e->nonterm = rule_lhs[f->rule];
+        e->token = 0;
+        e->pos = yypos;
+        e->lexval = 0;
+        return 1;
+      }
+    } else if (yygrammar[j] >= term_base) {
+      get_lexval();
+      if (f->owner == 0) {
+        /* the end of input, a member of YYSTART */
+        continue;
+      }
+      e->kind = YYEVENT_TOKEN;
+      e->rule = f->owner;
+      e->nonterm = rule_lhs[f->owner];
+      e->token = yygrammar[j] - term_base;
+      e->pos = yypos;
+      e->lexval = yylval_address();
+      return 1;
+    } else {
+      rule = yyselect();
+      if (rule_inline[rule]) {
+        push_event_frame(rule, f->owner);
+      } else {
+        push_event_frame(rule, rule);
+        e->kind = YYEVENT_ENTER;
+        e->rule = rule;
+        e->nonterm = rule_lhs[rule];
+        e->token = 0;
+        e->pos = next_token_pos();
+        e->lexval = 0;
+        return 1;
+      }
     }
   }
+  if (events_held) {
+    yyevents_release();
+  }
+  return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * pass all events of the derivation to the callback
+ */
+PRIVATE void stream_events() {
+  struct yyevent e;
+
+  start_events();
+  while (yyevent_next(&e)) {
+    event_function(&e, event_data);
+  }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release the parse kept for yyevent_next()
+ */
+PUBLIC void yyevents_release() {
+  if (! events_held) {
+    return;
+  }
+  events_held = 0;
+  event_count = 0;
+  finish_parse();
 }
 
+#endif
+
 /*============================================================================*/
 /* MAIN FUNCTION YYPARSE                                                      */
 /*============================================================================*/
 
+/*
+ * the parse is abandoned after recognition:
+ * release (or keep) the memory of the parser
+ */
+PRIVATE abandon_parse() {
+  PHASE(-1);
+#if LEXERTHREAD
+  stop_lexer();
+#endif
+#if KEEPMEMORY
+  free_lexelems();
+#else
+#if DYNAMICITEMS
+  release_items();
+#endif
+  release_lexelems();
+#if LEXERTHREAD
+  release_lexer();
+#endif
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * write the derivation log and release the memory of the parse
+ * (unless it is kept by KEEPMEMORY or for the forest)
+ */
+PRIVATE void finish_parse() {
+#if WALK && DERIVATIONLOG
+  if (log_walk) {
+    log_walk = 0;
+    encode_log();
+    if (log_file) {
+      write_log();
+    }
+#if PARSECACHE
+    if (log_capture) {
+      capture_log();
+    }
+#endif
+  }
+#endif
+  PHASE(-1);
+
+#if ! SPPF
+  /* with SPPF the forest is kept until yyforest_release() is called */
+#if KEEPMEMORY
+  free_lexelems();
+#else
+#if DYNAMICITEMS
+  release_items();
+#endif
+  release_stack();
+#if LINEARWALK
+  release_derivation();
+#endif
+  release_lexelems();
+#if LEXERTHREAD
+  release_lexer();
+#endif
+#endif
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * walk the derivation: call the generated YYSTART
+ * or pass the events to the callback (option EVENTSTREAM)
+ */
+PRIVATE void walk() {
+#if EVENTSTREAM
+  if (event_function) {
+    stream_events();
+    return;
+  }
+#endif
+#if GRAMMARTABLES
+  if (current_tables != &builtin_tables) {
+    /* YYSTART walks the compiled grammar */
+    return;
+  }
+#endif
+  YYSTART();
+}
+
+/*----------------------------------------------------------------------------*/
+
+#if PARALLELWALK
+/*
+ * 1 if walk() invokes the generated tree walker
+ * (which the parallel walk needs)
+ */
+PRIVATE int generated_walk() {
+#if EVENTSTREAM
+  if (event_function || event_iterate) {
+    return 0;
+  }
+#endif
+#if GRAMMARTABLES
+  if (current_tables != &builtin_tables) {
+    return 0;
+  }
+#endif
+  return 1;
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+
 /*
  * main function of the parser
  *
@@ -1474,14 +6331,76 @@ PUBLIC int yyselect() {
  * in the order of a left derivation
  */
 PUBLIC int yyparse() {
+#if SPPF
+  yyforest_release();
+#endif
+#if EVENTSTREAM
+  yyevents_release();
+#endif
+#if STATISTICS
+  reset_statistics();
+#endif
+#if PHASETIMING
+  start_phases();
+#endif
+#if PROFILE
+  init_profile();
+#endif
+#if TIMELINE
+  start_timeline();
+#endif
+#if LIMITS
+  start_limits();
+  if (setjmp(limit_env)) {
+    /* a limit has been exceeded during recognition */
+    abandon_parse();
+    return YYPARSE_LIMIT;
+  }
+#endif
   init_dirsets();
-  lookaheadsym = yylex() + term_base;
-  lookaheadpos = yypos;
-  first_lexval();
+#if LEXERTHREAD
+  start_lexer();
+#endif
+  PHASE(YYPHASE_LEX);
+  lookaheadsym = LEX() + term_base;
+  lookaheadpos = LEXPOS;
+  PHASE(YYPHASE_RECOGNIZE);
+  FIRST_LEXVAL();
+#if LOOKAHEAD2
+  lookaheadsym2 = lookaheadsym;
+  lookaheadpos2 = lookaheadpos;
+  if (lookaheadsym != 50000 /*EOF*/) {
+    PHASE(YYPHASE_LEX);
+    lookaheadsym2 = LEX() + term_base;
+    lookaheadpos2 = LEXPOS;
+    PHASE(YYPHASE_RECOGNIZE);
+    NEXT_LEXVAL();
+  }
+#endif
+#if ERRORRECOVERY
+  itemlist_sequence_with_recovery();
+  if (diagnostics_length) {
+    abandon_parse();
+    return YYPARSE_ERROR;
+  }
+#else
   itemlist_sequence();
+#endif
+#if LEXERTHREAD
+  /* EOF has been read: the scanner thread has finished */
+  stop_lexer();
+#endif
 
-#if DYNAMICITEMS
-  free(back);
+#if DYNAMICITEMS && ! KEEPMEMORY
+  /* not needed by the tree walker */
+  yymemfree(back);
+  back = 0;
+#endif
+
+#if SPPF
+  forest_root = thislist;
+  forest_held = 1;
+  yyforest_first();
 #endif
 
 #if PRINTTREE
@@ -1493,18 +6412,182 @@ PUBLIC int yyparse() {
    *    YYSTART : UserRoot EOF *
    * i.e. the root of the derivation tree
    */
+  PHASE(YYPHASE_WALK);
+#if DERIVATIONLOG
+  log_walk = log_file || log_capture;
+  rule_log_length = 0;
+  rule_log_count = 0;
+#endif
+#if LINEARWALK
+  linearize(thislist);
+#if PARALLELWALK
+  if (generated_walk()) {
+    start_parallel_walk();
+  }
+#endif
+#if DYNAMICITEMS && ! KEEPMEMORY && ! SPPF
+  /* the walk only reads the derivation */
+  release_items();
+  release_stack();
+#endif
+#else
   init_stack();
   push(thislist);
+#endif
   init_lexelem();
-  YYSTART();
+#if EVENTSTREAM
+  if (event_iterate) {
+    /* the events are fetched by yyevent_next() */
+    start_events();
+    events_held = 1;
+    return YYPARSE_OK;
+  }
+#endif
+  walk();
+#if PARALLELWALK
+  finish_parallel_walk();
+#endif
+#endif
+  finish_parse();
+  return YYPARSE_OK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release the tables computed from the grammar
+ */
+PRIVATE void release_grammar_tables() {
+#if SUBTREESKIP
+  if (rule_nonterms) {
+    yymemfree(rule_nonterms);
+    yymemfree(rule_terms);
+    yymemfree(rule_alt);
+  }
+  rule_nonterms = rule_terms = rule_alt = 0;
+  rule_limit = 0;
 #endif
+#if PARALLELWALK
+  if (parallel_rule) {
+    yymemfree(parallel_rule);
+  }
+  parallel_rule = 0;
+#endif
+#if ASTBUILDER || EVENTSTREAM
+  release_rule_table();
+#endif
+}
 
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release all memory kept by the parser
+ * (with option KEEPMEMORY the item table, the stack and the list of
+ * lexical values are kept from one parse to the next)
+ */
+PUBLIC void yyparse_release() {
+#if SPPF
+  yyforest_release();
+#endif
+#if EVENTSTREAM
+  yyevents_release();
+  if (event_frames) {
+    yymemfree(event_frames);
+  }
+  event_frames = 0;
+  event_room = 0;
+#endif
 #if DYNAMICITEMS
-  free(dot);
-  free(left);
-  free(sub);
+  release_items();
+#endif
+  release_stack();
+#if LINEARWALK
+  release_derivation();
+#endif
+  release_lexelems();
+#if LEXERTHREAD
+  release_lexer();
+#endif
+#if SOURCEBUFFER
+  yysource_release();
+#endif
+  release_grammar_tables();
+#if ASTBUILDER
+  release_ast_tables();
+#endif
+#if DERIVATIONLOG
+  if (rule_log) {
+    yymemfree(rule_log);
+  }
+  rule_log = 0;
+  rule_log_room = 0;
+  if (log_buf) {
+    yymemfree(log_buf);
+  }
+  log_buf = 0;
+  log_buf_length = 0;
+  log_buf_room = 0;
 #endif
+  if (trav_stack) {
+    yymemfree(trav_stack);
+  }
+  trav_stack = 0;
+  trav_limit = 0;
+}
 
-  return 0;
+#if SPPF
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * walk the tree selected by yyforest_first() or yyforest_next()
+ */
+PUBLIC void yyforest_walk() {
+  ch_ptr = 0;
+#if LINEARWALK
+  linearize(forest_root);
+#if PARALLELWALK
+  if (generated_walk()) {
+    start_parallel_walk();
+  }
+#endif
+#else
+  init_stack();
+  push(forest_root);
+#endif
+  init_lexelem();
+  walk();
+#if PARALLELWALK
+  finish_parallel_walk();
+#endif
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * release the item lists and the lexical values kept for the forest
+ */
+PUBLIC void yyforest_release() {
+  if (! forest_held) {
+    return;
+  }
+  forest_held = 0;
+  last_packed = 0;
+  ch_len = 0;
+#if KEEPMEMORY
+  free_lexelems();
+#else
+#if DYNAMICITEMS
+  release_items();
+#endif
+  release_stack();
+#if LINEARWALK
+  release_derivation();
+#endif
+  release_lexelems();
+#endif
 }
+
+#endif
 /*================================================================ THE END ===*/
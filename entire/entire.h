@@ -0,0 +1,277 @@
+/* entire.c */
+#ifndef _ENTIRE_H
+#define _ENTIRE_H
+#include <stdio.h>
+
+int yyparse(void);
+void yyparse_release(void);
+
+/* memory management, all memory is obtained through these functions */
+struct yyallocator {
+   void *(*alloc)(size_t n, void *data);
+   void *(*resize)(void *p, size_t n, void *data);
+   void (*release)(void *p, void *data);
+   void *data;                   /* passed to the functions unchanged */
+};
+
+void yyset_allocator(struct yyallocator *a);
+void *yymemalloc(size_t n);
+void *yymemrealloc(void *p, size_t n);
+void yymemfree(void *p);
+
+/* results of yyparse */
+#define YYPARSE_OK 0
+#define YYPARSE_ERROR 1          /* syntax errors (option ERRORRECOVERY) */
+#define YYPARSE_LIMIT 2          /* a resource limit has been exceeded */
+#define YYPARSE_BADLOG 3         /* yyreplay: not a log of this grammar */
+
+/* shared packed parse forest (option SPPF) */
+void yyforest_first(void);
+int yyforest_next(void);
+void yyforest_walk(void);
+void yyforest_release(void);
+long yyforest_packednodes(void);
+double yyforest_trees(void);
+
+/* statistics of the last parse (option STATISTICS) */
+#define YYSTATBUCKETS 32
+
+struct yystatistics {
+   long lists;                   /* item lists computed */
+   long items;                   /* items in all lists */
+   long peak_list_size;          /* items in the largest list */
+   long list_sizes[YYSTATBUCKETS];
+                                 /* [k]: lists with 2^k <= size < 2^(k+1) */
+   long kernel_calls;
+   long predictor_calls;
+   long completer_calls;
+   long hash_hits;               /* hash entry found, SEARCH invoked */
+   long search_probes;           /* items inspected by SEARCH */
+   long viable_rejections;       /* items rejected by is_viable */
+   long dirset_rejections;       /* predictions rejected by lookup_dirset */
+   long conjunctive_ambiguities;
+   long disjunctive_ambiguities;
+   long confilter_calls;
+   long disfilter_calls;
+   long table_growths;           /* calls of table_full */
+   long bytes_allocated;         /* bytes allocated by the parser */
+};
+
+struct yystatistics *yyparse_statistics(void);
+void yyprint_statistics(FILE *f);
+
+/* recognizer events (option TRACE) */
+#define YYTRACE_ADDED 1          /* item added to the current list */
+#define YYTRACE_REJECTED 2       /* item not added, see reason */
+#define YYTRACE_PREDICTION 3     /* predictor applied to item */
+#define YYTRACE_COMPLETION 4     /* completer applied to item */
+#define YYTRACE_AMBIGUITY 5      /* ambiguity resolved, see reason */
+#define YYTRACE_TOKEN 6          /* token consumed */
+
+/* reasons */
+#define YYTRACE_NOTVIABLE 1      /* REJECTED: is_viable failed */
+#define YYTRACE_NOTINDIRSET 2    /* REJECTED: lookahead not in director set */
+#define YYTRACE_CONJUNCTIVE 1    /* AMBIGUITY: different left pointers */
+#define YYTRACE_DISJUNCTIVE 2    /* AMBIGUITY: different sub pointers */
+
+struct yytrace_event {
+   int kind;
+   int reason;
+   long list;                    /* index of the current item list */
+   long dot, back, left, sub;    /* item, for AMBIGUITY the selected one */
+                                 /* TOKEN: dot = token, back = position */
+};
+
+typedef void (*yytrace_function)(struct yytrace_event *e, void *data);
+
+void yytrace_callback(yytrace_function f, void *data);
+void yytrace_ring(struct yytrace_event *buf, unsigned long size);
+unsigned long yytrace_fetch(struct yytrace_event *dst, unsigned long max);
+unsigned long yytrace_dropped(void);
+
+/* time spent in the phases of the last parse (option PHASETIMING) */
+#define YYPHASE_LEX 0
+#define YYPHASE_RECOGNIZE 1
+#define YYPHASE_WALK 2
+#define YYPHASES 3
+
+struct yyphase {
+   double seconds;
+   long long cycles;             /* hardware counters (option PERFCOUNTERS) */
+   long long instructions;
+   long long cache_misses;
+   long long branch_misses;
+};
+
+struct yyphasetimes {
+   struct yyphase phase[YYPHASES];
+   int counters;                 /* 1 if the hardware counters are valid */
+};
+
+struct yyphasetimes *yyparse_phases(void);
+void yyprint_phases(FILE *f);
+
+/* work per grammar position, accumulated over parses (option PROFILE) */
+void yyprint_profile(FILE *f);
+void yyprofile_reset(void);
+
+/* one entry per item list of the last parse (option TIMELINE) */
+struct yytimeline_entry {
+   long list;                    /* number of the item list */
+   long token;                   /* token read for it (-1: initial list) */
+   long pos;                     /* yypos of that token */
+   long items;
+   long completions;             /* completer calls */
+   long long nanoseconds;        /* to read the token and compute the list */
+};
+
+struct yytimeline_entry *yyparse_timeline(long *ref_length);
+void yywrite_timeline_csv(FILE *f);
+void yywrite_timeline_binary(FILE *f);
+
+/* resource limits (option LIMITS), 0 means: no limit */
+struct yylimits {
+   long max_items;               /* items in all item lists */
+   long max_bytes;               /* size of the item table (any size) */
+   double max_seconds;           /* elapsed time of the recognizer */
+   volatile int *cancel;         /* abandon the parse if *cancel != 0 */
+};
+
+#define YYLIMIT_ITEMS 1
+#define YYLIMIT_BYTES 2
+#define YYLIMIT_DEADLINE 3
+#define YYLIMIT_CANCELLED 4
+
+void yyset_limits(struct yylimits *l);
+int yyparse_limit(void);
+
+/* syntax errors repaired in the last parse (option ERRORRECOVERY) */
+#define YYDIAG_INSERTED 1        /* token inserted before pos */
+#define YYDIAG_DELETED 2         /* token at pos (and count-1 more) deleted */
+#define YYDIAG_ABANDONED 3       /* token at pos unexpected, parse abandoned */
+
+struct yydiagnostic {
+   int kind;
+   long pos;                     /* yypos of the token */
+   long token;                   /* token (as returned by yylex) */
+   long count;
+};
+
+struct yydiagnostic *yyparse_diagnostics(long *ref_length);
+void yyprint_diagnostics(FILE *f);
+
+/* source text in memory (option SOURCEBUFFER) */
+/* in the flex specification:
+ *    #define YY_INPUT(buf, result, max) ((result) = yysource_read((buf), (max)))
+ *    #define YY_USER_ACTION yyoffset += yyleng;
+ * and for a token with text: yylval = yytokenslice(yyleng);
+ */
+struct yyslice {
+   long offset;                  /* of the first character in the source */
+   long length;
+};
+
+extern long yyoffset;            /* end of the current token */
+
+int yysource_map(const char *path);
+void yysource_buffer(const char *text, long length);
+void yysource_release(void);
+int yysource_read(char *buf, int max);
+const char *yysource_text(void);
+long yysource_length(void);
+struct yyslice yytokenslice(long length);
+const char *yyslice_text(struct yyslice s);
+char *yyslice_copy(struct yyslice s, char *buf, long size);
+void yysource_position(long offset, long *ref_line, long *ref_col);
+                                 /* line index built on first use */
+
+/* derivation log, walk again without parsing (option DERIVATIONLOG) */
+void yyderivation_log(FILE *f);  /* log following parses to f, 0: none */
+int yyreplay(const void *log, long length);
+int yyreplay_file(const char *path);
+
+/* parse results keyed by the source text (option PARSECACHE, needs
+   SOURCEBUFFER and DERIVATIONLOG): a source parsed before is replayed */
+struct yycachestatistics {
+   long hits;                    /* logs replayed from memory */
+   long disk_hits;               /* logs replayed from the directory */
+   long misses;                  /* sources parsed */
+   long entries;                 /* logs in memory */
+   long bytes;                   /* their size */
+};
+
+void yyparse_cache(long max_bytes, const char *dir);
+                                 /* memory limit, directory (0: none) */
+int yyparse_cached(void);        /* instead of yyparse */
+struct yycachestatistics *yyparse_cache_statistics(void);
+void yyparse_cache_clear(void);  /* drop the logs kept in memory */
+
+/* skip the rest of the current alternative in the tree walk
+   (options LINEARWALK and SUBTREESKIP), to be called from an action */
+int yyskip(void);
+
+/* walk the nonterminal given by 'accent -parallel name' in threads
+   (option PARALLELWALK) */
+void yyparallel_threads(int n);  /* number of threads, 0: one per processor */
+void *yyparallel_result(void);   /* called by the generated function */
+int yyparallel_worker(void);     /* called by the generated get_lexval,
+                                    yypos is not set in a worker thread */
+
+/* derivation tree in an arena (option ASTBUILDER, accent -ast),
+   yyast.h defines yynonterm_NAME, yyrule_NAME_k (rule number of
+   the k-th alternative) and yymember_NAME_k_MEMBER (index in the
+   member array), the members of subphrases belong to the enclosing rule */
+struct yyastmember {
+   int token;                    /* token code of a token */
+   long pos;                     /* position of the token or node */
+   struct yyastnode *node;       /* 0 for a token */
+   void *lexval;                 /* lexical value of a token, see yyast_lexval */
+};
+
+struct yyastnode {
+   int rule;                     /* rule number of the alternative */
+   int nonterm;                  /* nonterminal, see yyprintname */
+   long pos;                     /* position of the first token */
+   int count;                    /* number of members */
+   struct yyastmember *member;   /* the members, one array */
+};
+
+struct yyastnode *yyast_build(void);  /* called by the generated YYSTART */
+struct yyastnode *yyast_root(void);
+void yyast_free(void);           /* releases the whole tree */
+
+/* the derivation as a sequence of events (option EVENTSTREAM),
+   subphrases give no events, their tokens belong to the enclosing rule */
+#define YYEVENT_ENTER 1
+#define YYEVENT_TOKEN 2
+#define YYEVENT_EXIT 3
+
+struct yyevent {
+   int kind;
+   int rule;                     /* rule number of the alternative */
+   int nonterm;                  /* its nonterminal, see yyprintname */
+   int token;                    /* TOKEN: token code */
+   long pos;                     /* TOKEN: its position, ENTER: of the next
+                                    token, EXIT: of the last token */
+   void *lexval;                 /* TOKEN: lexical value, valid until the
+                                    next event */
+};
+
+typedef void (*yyevent_function)(struct yyevent *e, void *data);
+
+void yyevents_callback(yyevent_function f, void *data);
+                                 /* instead of YYSTART, 0: YYSTART */
+void yyevents_iterate(int on);   /* yyparse returns before the walk */
+int yyevent_next(struct yyevent *e);  /* 0: no more events */
+void yyevents_release(void);     /* abandon the remaining events */
+
+/* grammar tables written by accent -tables (option GRAMMARTABLES),
+   a loaded grammar is walked only by the event stream */
+struct yytables;
+
+struct yytables *yytables_load(const char *path);  /* 0: not a table file */
+void yytables_use(struct yytables *t);  /* 0: the compiled tables */
+void yytables_unload(struct yytables *t);
+char *yytables_printname(struct yytables *t, int n);
+                                 /* names the nonterm of an event */
+#endif
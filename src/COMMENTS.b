@@ -3,7 +3,6 @@
    for(;;) {
       int ch = input(); yypos++;
       if (ch == '\n') {
-	 yyPosToNextLine();
 	 break;
       }
       else if (ch <= 0) {
@@ -22,7 +21,6 @@
    yypos++;
    
    for (;;) {
-      if (ch == '\n') yyPosToNextLine();
       /* begin of comment ? */
       if (ch == '/') {
          ch = input();
@@ -34,14 +34,12 @@
 	       }
 	       AppendToString('\\');
 	       AppendToString(ch);
-               if (ch == '\n') yyPosToNextLine();
 	    }
 	    else if (ch == this_terminator) {
 	       break;
 	    }
 	    else {
 	       AppendToString(ch);
-               if (ch == '\n') yyPosToNextLine();
             }
 	 }
 	 AppendToString(this_terminator);
@@ -57,7 +55,6 @@
 	 }
 	 AppendToString('\\');
 	 AppendToString(ch);
-         if (ch == '\n') yyPosToNextLine();
          ch = input(); yypos++;
       }
 
@@ -94,7 +91,6 @@
 	       AppendToString(ch);
 	       if (ch == '\n') {
 		  AppendToString(ch);
-		  yyPosToNextLine();
 	       }
 	       ch = input(); yypos++;
 	       if (ch == '*') {
@@ -120,8 +116,7 @@
 	       ch = input(); yypos++;
 	       if (ch == '\n') {
 		  AppendToString(ch);
-                  ch = input();
-		  yyPosToNextLine();
+                  ch = input(); yypos++;
 		  break;
 	       }
 	       else if (ch <= 0) {
@@ -139,9 +134,6 @@
       /* 7: else */
       else {
          AppendToString(ch);
-         if (ch == '\n') {
-            yyPosToNextLine();
-         }
          ch = input(); yypos++;
       }
    }
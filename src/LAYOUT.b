@@ -1,4 +1,4 @@
 \  { yypos += 1; }
-\n { yyPosToNextLine(); }
-\r { }
+\n { yypos += 1; }
+\r { yypos += 1; }
 \t { yypos += 1; }
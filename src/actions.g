@@ -29,6 +29,7 @@
 
 'export'
    put_actions
+   put_ast_header
 
 'action' put_actions
    'rule' put_actions
@@ -51,7 +52,25 @@
       LabelCount <- 1
       LHS_List -> Keys
       -- put_fwd_decl_LHSKEYS(Keys)
-      put_actions_LHSKEYS(Keys)
+      (|
+	 AstMode
+	 PutAstStart
+      ||
+	 StackMode
+	 PutStackWalkSupport
+	 -- a first pass without output finds the declarations
+	 -- of the actions, they become fields of the frames
+	 StartDeclPass
+	 put_actions_LHSKEYS(Keys)
+	 EndDeclPass
+	 put_frame_LHSKEYS(Keys)
+	 PutStackWalkStart
+	 put_actions_LHSKEYS(Keys)
+	 PutStackWalkEnd
+      ||
+	 put_actions_LHSKEYS(Keys)
+      |)
+      PutParallelDefault
 
       fix_code
 
@@ -94,7 +113,12 @@
 'action'  put_actions_LHSKEYS(LHSKEYS)
    'rule' put_actions_LHSKEYS(keys(Keys, Key))
       put_actions_LHSKEYS(Keys)
-      put_actions_LHSKEY(Key)
+      (|
+	 StackMode
+	 put_stack_LHSKEY(Key)
+      ||
+	 put_actions_LHSKEY(Key)
+      |)
    'rule' put_actions_LHSKEYS(nil)
 
 'action' put_actions_LHSKEY(LHSKEY)
@@ -108,6 +132,7 @@
 	 HasMeaning(Id -> nontermobj(_,_,FP))
 	 Nl
 	 id_to_string(Id -> Str)
+	 put_parallel_struct(Str, FP)
    Put("void ")
 	 Put(Str)
 	 Put(" (")
@@ -124,6 +149,7 @@
 	 indentation(+1)
 
 	 local_declarations(Clauses)
+	 put_parallel_prologue(Str, FP)
 
 	 Key'RulePrelude -> Prelude
 	 put_CodeBlock("", Prelude, "")
@@ -149,6 +175,7 @@
 	 indentation(-1)
 	 indent
 	 Put("}") Nl
+	 put_parallel_walk(Str, FP, Clauses)
       |]
 
 'action' put_actions_for_nonterm_CLAUSEKEYS(CLAUSEKEYS)
@@ -177,7 +204,7 @@
       |)
 
       indentation(+1)
-      put_actions_MEMBERLIST(Members)
+      put_scoped_MEMBERLIST(Members)
       (|
 	 GrammarClass -> cfg
          indent
@@ -190,6 +217,12 @@
 	 -- no Newline
       |)
 
+'action' put_scoped_MEMBERLIST(MEMBERLIST)
+   'rule' put_scoped_MEMBERLIST(Members)
+      OpenActionScope
+      put_actions_MEMBERLIST(Members)
+      CloseActionScope
+
 'action' put_actions_MEMBERLIST(MEMBERLIST)
    'rule' put_actions_MEMBERLIST(list(H, T))
       put_actions_MEMBER(H)
@@ -224,12 +257,17 @@
 	 |)
       ||
 	 HasMeaning(Id -> nontermobj(_,_,Formals))
-	 indent
-	 Put(Str)
-	 Put("(")
-	 handle_actual_params(Params, Formals)
-	 Put(");")
-	 Nl
+	 (|
+	    StackMode
+	    put_stack_call(Str, Params, Formals)
+	 ||
+	    indent
+	    Put(Str)
+	    Put("(")
+	    handle_actual_params(Params, Formals)
+	    Put(");")
+	    Nl
+	 |)
       |)
    'rule' put_actions_MEMBER(token(N))
       (|
@@ -295,6 +333,10 @@
       Nl
       put_actions_ALTERNATIVELIST(Alternatives)
       indent
+      -- yyselect() returns 0 for members skipped by yyskip()
+      Put("case 0: break;")
+      Nl
+      indent
       Put("default: printf(\"???\\n\"); exit(1);") -- xx
       Nl
       indent
@@ -328,7 +370,7 @@
       -- ClauseKey'Pos -> Pos
 
       indentation(+1)
-      put_actions_MEMBERLIST(Members)
+      put_scoped_MEMBERLIST(Members)
       indent
       Put("} break;")
       Nl
@@ -394,17 +436,13 @@
 'action' handle_formal_param_2(FORMPARAM)
    'rule' handle_formal_param_2 (param(Mode, Type, Name, Pos))
       id_to_string(Type -> TStr)
-      Put("   ")
-      Put(TStr)
-      Put(" ")
-      [|
-         where(Mode -> out)
-	 Put("*")
-      |]
       id_to_string(Name -> NStr)
-      Put(NStr)
-      Put(";")
-      Nl
+      (|
+         where(Mode -> out)
+	 PutLocalDecl(TStr, "*", NStr)
+      ||
+	 PutLocalDecl(TStr, "", NStr)
+      |)
 
       define_local_name(Mode, Type, Name)
 ---
@@ -532,14 +570,9 @@
 	 |]
       ||
 	 define_local_name(none, FType, AName)
-	 Put("   ")
 	 id_to_string(FType -> FTypeStr)
-	 Put(FTypeStr)
-	 Put(" ")
 	 id_to_string(AName -> ANameStr)
-	 Put(ANameStr)
-	 Put(";")
-	 Nl
+	 PutLocalDecl(FTypeStr, "", ANameStr)
       |)
 
 'action' process_token_param(ACTPARAMLIST)
@@ -554,14 +587,9 @@
 	 |]
       ||
 	 define_local_name(none, FType, AName)
-	 Put("   ")
 	 id_to_string(FType -> FTypeStr)
-	 Put(FTypeStr)
-	 Put(" ")
 	 id_to_string(AName -> ANameStr)
-	 Put(ANameStr)
-	 Put(";")
-	 Nl
+	 PutLocalDecl(FTypeStr, "", ANameStr)
       |)
    'rule' process_token_param(nil)
    'rule' process_token_param(list(id(Name, Pos), list(id(Name2, Pos2),Tl,_),_))
@@ -600,6 +628,7 @@
 
 'action' put_CodeBlock(STRING, ACTIONBLOCK, STRING)
    'rule' put_CodeBlock(Str1, action(BlkTxt, BlkPos), Str2)
+      PutFrameIn(BlkTxt)
       Put("#line ")
       POS_to_LineNumber(BlkPos -> N1)
       PutI(N1)
@@ -609,7 +638,7 @@
       Put("\"")
       Nl
       Put(Str1)
-      PutBlockText(BlkTxt)
+      PutActionText(BlkTxt)
       Put(Str2)
       Nl
       GetOutputLineCount(-> N2)
@@ -617,11 +646,350 @@
       PutI(N2+2)
       Put(" \"yygrammar.c\"")
       Nl
+      PutFrameOut
    'rule' put_CodeBlock(_, none, _)
 
-'action' PutBlockText(STRING)
+'action' PutActionText(STRING)
+'action' PutFrameIn(STRING)
+'action' PutFrameOut
 'action' GetOutputLineCount(-> INT)
 
+---
+-- option -stackwalk (see main.c):
+-- the walker is one function YYSTART with a region for each nonterminal,
+-- the parameters and locals of a nonterminal are the fields of its frame
+-- (struct yyframe_<name>, allocated by yypush_frame),
+-- inside the region they are macros that select the fields of the current
+-- frame yyfp, a call pushes a frame and jumps to the region of the callee,
+-- the return jumps to the label after the call (yyreturn),
+-- the declarations of the actions and of the rule prelude are fields
+-- of the frame as well (yyl<k>_<name>, PutDeclFields)
+
+'action' put_frame_LHSKEYS(LHSKEYS)
+   'rule' put_frame_LHSKEYS(keys(Keys, Key))
+      put_frame_LHSKEYS(Keys)
+      put_frame_LHSKEY(Key)
+   'rule' put_frame_LHSKEYS(nil)
+
+'action' put_frame_LHSKEY(LHSKEY)
+   'rule' put_frame_LHSKEY(Key)
+      Key'Lhs -> Lhs
+      where(Lhs -> nonterm(Id))
+      HasMeaning(Id -> nontermobj(_,_,FP))
+      id_to_string(Id -> Str)
+      Nl
+      Put("struct yyframe_")
+      Put(Str)
+      Put(" {")
+      Nl
+      Put("   struct yyframe yyf;")
+      Nl
+      SetDeclMode(1, Str)
+      LocalNames <- nil
+      handle_formal_params_2(FP)
+      Key'Clauses -> Clauses
+      local_declarations(Clauses)
+      PutDeclFields(Str)
+      SetDeclMode(0, Str)
+      Put("};")
+      Nl
+   'rule' put_frame_LHSKEY(_)
+
+'action' put_stack_LHSKEY(LHSKEY)
+   'rule' put_stack_LHSKEY(Key)
+      Key'Lhs -> Lhs
+      where(Lhs -> nonterm(Id))
+      HasMeaning(Id -> nontermobj(_,_,FP))
+      id_to_string(Id -> Str)
+      Nl
+      SetDeclMode(2, Str)
+      LocalNames <- nil
+      handle_formal_params_2(FP)
+      Key'Clauses -> Clauses
+      local_declarations(Clauses)
+      Put("yyenter_")
+      Put(Str)
+      Put(":")
+      Nl
+      indentation(+1)
+      Key'RulePrelude -> Prelude
+      put_CodeBlock("", Prelude, "")
+      indent
+      Put("switch(yyselect()) {")
+      Nl
+      put_actions_for_nonterm_CLAUSEKEYS(Clauses)
+      indent
+      Put("}")
+      Nl
+      indent
+      Put("goto yyreturn;")
+      Nl
+      indentation(-1)
+      PutUndefs
+   'rule' put_stack_LHSKEY(_)
+
+'action' put_stack_call(STRING, ACTPARAMLIST, FORMPARAMLIST)
+   'rule' put_stack_call(Str, Params, Formals)
+      NextReturnLabel(-> L)
+      indent
+      Put("yynew = yypush_frame(sizeof(struct yyframe_")
+      Put(Str)
+      Put("), yyfp, ")
+      PutI(L)
+      Put(");")
+      Nl
+      put_stack_params(Str, Params, Formals)
+      indent
+      Put("yyfp = yynew;")
+      Nl
+      indent
+      Put("goto yyenter_")
+      Put(Str)
+      Put(";")
+      Nl
+      indent
+      Put("yyr")
+      PutI(L)
+      Put(": ;")
+      Nl
+
+'action' put_stack_params(STRING, ACTPARAMLIST, FORMPARAMLIST)
+   'rule' put_stack_params(Str, list(H, T, _), list(H2, T2))
+      where(H2 -> param(_, _, Name, _))
+      id_to_string(Name -> NStr)
+      indent
+      Put("((struct yyframe_")
+      Put(Str)
+      Put(" *) yynew)->yya_")
+      Put(NStr)
+      Put(" = ")
+      handle_actual_param(H, H2)
+      Put(";")
+      Nl
+      put_stack_params(Str, T, T2)
+   'rule' put_stack_params(_, _, _)
+
+'condition' StackMode
+'action' PutStackWalkSupport
+'action' PutStackWalkStart
+'action' PutStackWalkEnd
+'action' SetDeclMode(INT, STRING)
+'action' StartDeclPass
+'action' EndDeclPass
+'action' PutDeclFields(STRING)
+'action' OpenActionScope
+'action' CloseActionScope
+'action' PutLocalDecl(STRING, STRING, STRING)
+'action' PutUndefs
+'action' NextReturnLabel(-> INT)
+
+---
+-- option -parallel (see main.c):
+-- the output attributes of the parallel nonterminal are returned
+-- in a struct yyres_<name>,
+-- its function takes them from the parallel walk if it has been done
+-- (yyparallel_result() in entire.c),
+-- yyparallel_walk() walks one element in a worker thread
+
+'action' put_parallel_struct(STRING, FORMPARAMLIST)
+   'rule' put_parallel_struct(Str, FP)
+      IsParallelNonterm(Str)
+      Put("struct yyres_")
+      Put(Str)
+      Put(" {")
+      Nl
+      put_parallel_fields(FP)
+      [|
+	 where(FP -> nil)
+	 Put("   int yyunused;")
+	 Nl
+      |]
+      Put("};")
+      Nl
+      Put("extern void *yyparallel_result();")
+      Nl
+      Put("extern int yyparallel_worker();")
+      Nl
+      Nl
+   'rule' put_parallel_struct(_, _)
+
+'action' put_parallel_fields(FORMPARAMLIST)
+   'rule' put_parallel_fields(list(param(Mode, Type, Name, Pos), T))
+      [|
+	 where(Mode -> xxin)
+	 ErrorI("parameter '", Name, "' of a parallel nonterminal must be an output parameter", Pos)
+      |]
+      id_to_string(Type -> TStr)
+      id_to_string(Name -> NStr)
+      Put("   ")
+      Put(TStr)
+      Put(" ")
+      Put(NStr)
+      Put(";")
+      Nl
+      put_parallel_fields(T)
+   'rule' put_parallel_fields(nil)
+
+'action' put_parallel_prologue(STRING, FORMPARAMLIST)
+   'rule' put_parallel_prologue(Str, FP)
+      IsParallelNonterm(Str)
+      indent
+      Put("struct yyres_")
+      Put(Str)
+      Put(" *yyres;")
+      Nl
+      indent
+      Put("if ((yyres = (struct yyres_")
+      Put(Str)
+      Put(" *) yyparallel_result()) != 0) {")
+      Nl
+      put_parallel_copies(FP)
+      indent
+      Put("   return;")
+      Nl
+      indent
+      Put("}")
+      Nl
+   'rule' put_parallel_prologue(_, _)
+
+'action' put_parallel_copies(FORMPARAMLIST)
+   'rule' put_parallel_copies(list(param(_, _, Name, _), T))
+      id_to_string(Name -> NStr)
+      indent
+      Put("   *")
+      Put(NStr)
+      Put(" = yyres->")
+      Put(NStr)
+      Put(";")
+      Nl
+      put_parallel_copies(T)
+   'rule' put_parallel_copies(nil)
+
+'action' put_parallel_walk(STRING, FORMPARAMLIST, CLAUSEKEYS)
+   'rule' put_parallel_walk(Str, FP, Clauses)
+      IsParallelNonterm(Str)
+      Nl
+      Put("void yyparallel_walk (res)") Nl
+      Put("   void *res;") Nl
+      Put("{") Nl
+      Put("   struct yyres_")
+      Put(Str)
+      Put(" *yyres = (struct yyres_")
+      Put(Str)
+      Put(" *) res;")
+      Nl
+      Put("   ")
+      Put(Str)
+      Put("(")
+      put_parallel_args(FP)
+      Put(");")
+      Nl
+      Put("}") Nl
+      Nl
+      Put("int yyparallel_width = sizeof(struct yyres_")
+      Put(Str)
+      Put(");")
+      Nl
+      Put("int yyparallel_rules[] = {") Nl
+      put_parallel_rules(Clauses)
+      Put("0") Nl
+      Put("};") Nl
+   'rule' put_parallel_walk(_, _, _)
+
+'action' put_parallel_args(FORMPARAMLIST)
+   'rule' put_parallel_args(list(param(_, _, Name, _), T))
+      id_to_string(Name -> NStr)
+      Put("&yyres->")
+      Put(NStr)
+      [| where(T -> list) Put(", ") |]
+      put_parallel_args(T)
+   'rule' put_parallel_args(nil)
+
+'action' put_parallel_rules(CLAUSEKEYS)
+   'rule' put_parallel_rules(clausekeys(Keys, Key))
+      put_parallel_rules(Keys)
+      Key'Number -> N
+      PutI(N)
+      Put(", ")
+   'rule' put_parallel_rules(nil)
+
+'condition' IsParallelNonterm(STRING)
+'action' PutParallelDefault
+
+--------------------------------------------------------------------------------
+
+-- accent -ast: the tree built by yyast_build() replaces the actions,
+-- yyast.h defines the numbers of the nonterminals and of their alternatives
+-- and the indices of the members (see main.c)
+
+'action' put_ast_header
+   'rule' put_ast_header
+      AstMode
+      OpenOutput("yyast.h")
+      Put("#include \"yygrammar.h\"") Nl
+      Put("#define yyast_lexval(m) (*(YYSTYPE *) (m)->lexval)") Nl
+      LHS_List -> Keys
+      put_ast_LHSKEYS(Keys)
+      CloseOutput
+   'rule' put_ast_header
+
+'action' put_ast_LHSKEYS(LHSKEYS)
+   'rule' put_ast_LHSKEYS(keys(Keys, Key))
+      put_ast_LHSKEYS(Keys)
+      put_ast_LHSKEY(Key)
+   'rule' put_ast_LHSKEYS(nil)
+
+'action' put_ast_LHSKEY(LHSKEY)
+   'rule' put_ast_LHSKEY(Key)
+      Key'Lhs -> Lhs
+      where(Lhs -> nonterm(Id))
+      id_to_string(Id -> Str)
+      Key'Pos -> Pos
+      Nl
+      Put("#define yynonterm_")
+      Put(Str)
+      Put(" ")
+      PutI(Pos)
+      Nl
+      Key'Clauses -> Clauses
+      put_ast_clauses(Str, Clauses -> _)
+   'rule' put_ast_LHSKEY(_)
+
+'action' put_ast_clauses(STRING, CLAUSEKEYS -> INT)
+   'rule' put_ast_clauses(Str, clausekeys(Keys, Key) -> N+1)
+      put_ast_clauses(Str, Keys -> N)
+      Key'Number -> Rule
+      Put("#define yyrule_")
+      Put(Str)
+      Put("_")
+      PutI(N+1)
+      Put(" ")
+      PutI(Rule)
+      Nl
+      Key'Elems -> Elems
+      StartAstMembers(Str, N+1)
+      put_ast_members(Elems)
+   'rule' put_ast_clauses(_, nil -> 0)
+
+'action' put_ast_members(ELEMS)
+   'rule' put_ast_members(elems(Elems, nonterm(Id, _, _)))
+      put_ast_members(Elems)
+      id_to_string(Id -> Name)
+      PutAstMember(Name)
+   'rule' put_ast_members(elems(Elems, token(_)))
+      put_ast_members(Elems)
+      PutAstMember("")
+   'rule' put_ast_members(elems(Elems, subphrase(_, _, _)))
+      put_ast_members(Elems)
+      PutAstSubphrase
+   'rule' put_ast_members(nil)
+
+'condition' AstMode
+'action' PutAstStart
+'action' StartAstMembers(STRING, INT)
+'action' PutAstMember(STRING)
+'action' PutAstSubphrase
+
 ---
 
 'action' GetSourceFileName(-> STRING)
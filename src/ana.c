@@ -27,6 +27,7 @@
 
 /*----------------------------------------------------------------------------*/
 
+#include <stdlib.h>
 #include "sets.h"
 
 #define PUBLIC
@@ -39,6 +40,7 @@ PRIVATE void compute_first ();
 PRIVATE void compute_follow ();
 PRIVATE void compute_dir ();
 PRIVATE void process_rhs();
+PRIVATE void note_token();
 
 /*----------------------------------------------------------------------------*/
 /* Grammar Definition                                                         */
@@ -139,6 +141,7 @@ PUBLIC void append_nonterm_member(n)
 
 PUBLIC void append_token_member(n)
 {
+   note_token(n);
    append_member(- n);
 }
 
@@ -470,3 +473,344 @@ PUBLIC get_max_char(int *ref_n)
 }
 
 /*----------------------------------------------------------------------------*/
+/* LL(2) Analysis                                                             */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Only computed if accent is invoked with option -ll2.
+ *
+ * A terminal string of length <= 2 is encoded as an integer:
+ *    empty string:  0
+ *    a:             (a+1)*STRWIDTH
+ *    a b:           (a+1)*STRWIDTH + (b+1)
+ * where a and b are token numbers (0 is EOF).
+ * A set of strings is kept as a sorted array of such codes.
+ */
+
+extern int LL2Flag;
+
+typedef struct {
+   int count;
+   int room;
+   int *elem;
+} strset;
+
+PRIVATE int max_token = 0;
+PRIVATE int STRWIDTH;
+
+PRIVATE strset *FIRST2;
+PRIVATE strset *FOLLOW2;
+PRIVATE strset *DIRSET2;
+
+PRIVATE int *rule_of_key = 0;   /* encoded rule number -> rule handle */
+PRIVATE int max_key = 0;
+
+#define FIRSTTOKEN(c)  ((c) / STRWIDTH - 1)
+#define SECONDTOKEN(c) ((c) % STRWIDTH - 1)
+#define STRLEN(c)      ((c) == 0 ? 0 : (c) % STRWIDTH == 0 ? 1 : 2)
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void note_token(int n)
+{
+   if (n > max_token) max_token = n;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* insert code c into s, keeping s sorted; returns 1 if c is new */
+
+PRIVATE int strset_include(strset *s, int c)
+{
+   int lo, hi, mid;
+
+   lo = 0; hi = s->count;
+   while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (s->elem[mid] < c) lo = mid + 1;
+      else hi = mid;
+   }
+   if (lo < s->count && s->elem[lo] == c) return 0;
+
+   if (s->count == s->room) {
+      s->room = s->room ? 2 * s->room : 8;
+      s->elem = (int *) realloc (s->elem, sizeof(int) * s->room);
+      if (! s->elem) mallocerror();
+   }
+   for (hi = s->count; hi > lo; hi--) s->elem[hi] = s->elem[hi-1];
+   s->elem[lo] = c;
+   s->count++;
+   return 1;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE int strset_include_set(strset *s, strset *x)
+{
+   int i, grown = 0;
+
+   for (i = 0; i < x->count; i++) grown |= strset_include(s, x->elem[i]);
+   return grown;
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* r := x . y truncated to length 2 */
+
+PRIVATE void concat2(strset *r, strset *x, strset *y)
+{
+   int i, j, c, d;
+
+   r->count = 0;
+   for (i = 0; i < x->count; i++) {
+      c = x->elem[i];
+      if (STRLEN(c) == 2) {
+	 strset_include(r, c);
+      }
+      else if (STRLEN(c) == 1) {
+	 for (j = 0; j < y->count; j++) {
+	    d = y->elem[j];
+	    if (d == 0) strset_include(r, c);
+	    else strset_include(r, c + FIRSTTOKEN(d) + 1);
+	 }
+      }
+      else {
+	 strset_include_set(r, y);
+      }
+   }
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * r := FIRST2(ml) . tail
+ * if update_follow is set, FOLLOW2 of each nonterm in ml is extended
+ * by the right context of that nonterm
+ * returns 1 if a FOLLOW2 set has grown
+ */
+
+PRIVATE int rhs_first2(memberlist ml, strset *tail, strset *r,
+   int update_follow)
+{
+   strset rest, sym;
+   member m;
+   int grown = 0;
+
+   r->count = 0;
+   if (ml == 0) {
+      strset_include_set(r, tail);
+      return 0;
+   }
+
+   rest.count = rest.room = 0; rest.elem = 0;
+   sym.count = sym.room = 0; sym.elem = 0;
+
+   grown = rhs_first2(ml->tail, tail, &rest, update_follow);
+
+   m = ml->head;
+   if (m <= 0) { /* m is a token */
+      strset_include(&sym, (- m + 1) * STRWIDTH);
+   }
+   else {
+      if (update_follow) grown |= strset_include_set(&FOLLOW2[m], &rest);
+      strset_include_set(&sym, &FIRST2[m]);
+   }
+   concat2(r, &sym, &rest);
+
+   free(rest.elem);
+   free(sym.elem);
+   return grown;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void compute_ll2()
+{
+   rulelist rl;
+   memberlist ml;
+   strset epsilon, cur;
+   int *on_rhs;
+   int i, ruleindex, grown;
+
+   STRWIDTH = max_token + 2;
+
+   FIRST2 = (strset *) calloc (n_of_nonterms+1, sizeof(strset));
+   FOLLOW2 = (strset *) calloc (n_of_nonterms+1, sizeof(strset));
+   DIRSET2 = (strset *) calloc (rulecount+1, sizeof(strset));
+   on_rhs = (int *) calloc (n_of_nonterms+1, sizeof(int));
+   if (! FIRST2 || ! FOLLOW2 || ! DIRSET2 || ! on_rhs) mallocerror();
+
+   epsilon.count = epsilon.room = 0; epsilon.elem = 0;
+   strset_include(&epsilon, 0);
+   cur.count = cur.room = 0; cur.elem = 0;
+
+   /* FIRST2 */
+   do {
+      grown = 0;
+      for (rl = cur_rule_list; rl; rl = rl->tail) {
+	 ml = rl->head;
+	 rhs_first2(ml->tail, &epsilon, &cur, 0);
+	 grown |= strset_include_set(&FIRST2[ml->head], &cur);
+      }
+   } while (grown);
+
+   /* FOLLOW2, starting with the nonterms that do not occur in a rhs */
+   for (rl = cur_rule_list; rl; rl = rl->tail) {
+      for (ml = rl->head->tail; ml; ml = ml->tail) {
+	 if (ml->head > 0) on_rhs[ml->head] = 1;
+      }
+   }
+   for (i = 1; i <= n_of_nonterms; i++) {
+      if (! on_rhs[i]) strset_include(&FOLLOW2[i], 0);
+   }
+   do {
+      grown = 0;
+      for (rl = cur_rule_list; rl; rl = rl->tail) {
+	 ml = rl->head;
+	 grown |= rhs_first2(ml->tail, &FOLLOW2[ml->head], &cur, 1);
+      }
+   } while (grown);
+
+   /* DIRSET2 */
+   ruleindex = 0;
+   for (rl = cur_rule_list; rl; rl = rl->tail) {
+      ml = rl->head;
+      ruleindex++;
+      rhs_first2(ml->tail, &FOLLOW2[ml->head], &DIRSET2[ruleindex], 0);
+   }
+
+   free(on_rhs);
+   free(epsilon.elem);
+   free(cur.elem);
+}
+
+/*----------------------------------------------------------------------------*/
+
+/* record that the encoded rule number k belongs to rule handle */
+
+PUBLIC void add_dirset2(int k, int handle)
+{
+   if (! LL2Flag) return;
+
+   if (k > max_key) {
+      rule_of_key = (int *) realloc (rule_of_key, sizeof(int) * (k+1));
+      if (! rule_of_key) mallocerror();
+      while (max_key < k) rule_of_key[++max_key] = 0;
+   }
+   rule_of_key[k] = handle;
+}
+
+/*----------------------------------------------------------------------------*/
+
+PRIVATE void put_table(char *name, int *val, int n)
+{
+   int i;
+
+   Put("int "); Put(name); Put("[] = {"); Nl();
+   for (i = 0; i < n; i++) {
+      PutI((long) val[i]); Put(",");
+      if (i % 16 == 15) Nl();
+   }
+   Put("0"); Nl();
+   Put("};"); Nl();
+}
+
+/*----------------------------------------------------------------------------*/
+
+/*
+ * emit yydirset2(rule, a, b): is the token pair a b in the LL(2)
+ * director set of the rule?
+ * The table has two levels:
+ *    yyll2rule[rule] .. yyll2rule[rule+1]-1 index the first tokens
+ *    yyll2first[i] of the rule (sorted),
+ *    yyll2next[i] .. yyll2next[i+1]-1 index the second tokens
+ *    yyll2second[j] that may follow yyll2first[i] (sorted).
+ * A string that ends after its first token is stored with
+ * EOF as second token.
+ * Without option -ll2 yydirset2 accepts everything.
+ */
+
+PUBLIC void write_dirset2_table()
+{
+   int *ruletab, *firsttab, *nexttab, *secondtab;
+   int nfirst, nsecond, room;
+   int k, i, c, a, b;
+   strset *s;
+
+   Put("extern int yydirset2();"); Nl();
+
+   if (! LL2Flag) {
+      Put("int yydirset2(int rule, int a, int b)"); Nl();
+      Put("{"); Nl();
+      Put("   return 1;"); Nl();
+      Put("}"); Nl();
+      return;
+   }
+
+   compute_ll2();
+
+   room = 0;
+   for (k = 1; k <= max_key; k++) {
+      if (rule_of_key[k]) room += DIRSET2[rule_of_key[k]].count;
+   }
+   ruletab = (int *) malloc (sizeof(int) * (max_key+2));
+   firsttab = (int *) malloc (sizeof(int) * (room+1));
+   nexttab = (int *) malloc (sizeof(int) * (room+1));
+   secondtab = (int *) malloc (sizeof(int) * (room+1));
+   if (! ruletab || ! firsttab || ! nexttab || ! secondtab) mallocerror();
+
+   nfirst = 0; nsecond = 0;
+   ruletab[0] = 0;
+   for (k = 1; k <= max_key; k++) {
+      ruletab[k] = nfirst;
+      if (! rule_of_key[k]) continue;
+      s = &DIRSET2[rule_of_key[k]];
+
+      /* codes are sorted by first token, then by second token */
+      for (i = 0; i < s->count; i++) {
+	 c = s->elem[i];
+	 if (c == 0) continue;
+	 a = FIRSTTOKEN(c);
+	 b = STRLEN(c) == 2 ? SECONDTOKEN(c) : 0;
+	 if (nfirst == ruletab[k] || firsttab[nfirst-1] != a) {
+	    firsttab[nfirst] = a;
+	    nexttab[nfirst] = nsecond;
+	    nfirst++;
+	 }
+	 if (nsecond == nexttab[nfirst-1] || secondtab[nsecond-1] != b) {
+	    secondtab[nsecond++] = b;
+	 }
+      }
+   }
+   ruletab[max_key+1] = nfirst;
+   nexttab[nfirst] = nsecond;
+
+   put_table("yyll2rule", ruletab, max_key+2);
+   put_table("yyll2first", firsttab, nfirst);
+   put_table("yyll2next", nexttab, nfirst+1);
+   put_table("yyll2second", secondtab, nsecond);
+
+   Put("int yydirset2(int rule, int a, int b)"); Nl();
+   Put("{"); Nl();
+   Put("   int lo, hi, mid, end;"); Nl();
+   Put("   lo = yyll2rule[rule]; hi = yyll2rule[rule+1];"); Nl();
+   Put("   while (lo < hi) {"); Nl();
+   Put("      mid = (lo + hi) / 2;"); Nl();
+   Put("      if (yyll2first[mid] < a) lo = mid + 1; else hi = mid;"); Nl();
+   Put("   }"); Nl();
+   Put("   if (lo == yyll2rule[rule+1] || yyll2first[lo] != a) return 0;"); Nl();
+   Put("   end = yyll2next[lo+1]; lo = yyll2next[lo]; hi = end;"); Nl();
+   Put("   while (lo < hi) {"); Nl();
+   Put("      mid = (lo + hi) / 2;"); Nl();
+   Put("      if (yyll2second[mid] < b) lo = mid + 1; else hi = mid;"); Nl();
+   Put("   }"); Nl();
+   Put("   return lo < end && yyll2second[lo] == b;"); Nl();
+   Put("}"); Nl();
+
+   free(ruletab);
+   free(firsttab);
+   free(nexttab);
+   free(secondtab);
+}
+
+/*----------------------------------------------------------------------------*/
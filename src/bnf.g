@@ -118,6 +118,8 @@
    ENCODE
 
    CloseOutput
+
+   put_ast_header -- (uses the positions computed by ENCODE)
    -- put_grammar
    
 
@@ -27,14 +27,18 @@
 
 'action' Put(STRING)
 'action' Nl
+'action' PutThreadLocal
+'action' PutSetPos
 
 'action' fix_code
    
    'rule' fix_code
 
       Nl
-      Put("extern YYSTYPE yylval;") Nl
-      Put("YYSTYPE yylval;") Nl
+      -- with option -parallel yylval and the token cursor
+      -- are thread local, yypos is not (see main.c)
+      Put("extern ") PutThreadLocal Put("YYSTYPE yylval;") Nl
+      PutThreadLocal Put("YYSTYPE yylval;") Nl
       Put("extern long yypos;") Nl
       --Put("extern char * yytokenname;") Nl --xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
       (|
@@ -47,54 +51,111 @@
          Put("/* GentleFlag = no */") Nl
       |)
       Put("") Nl
-      Put("typedef struct LEXELEMSTRUCT {") Nl
+      -- the lexical values of all tokens are kept in a growable array,
+      -- it is released in one piece (see free_lexelems, release_lexelems)
+      Put("typedef struct {") Nl
       Put("   YYSTYPE val;") Nl
       Put("   long pos;") Nl
-      Put("   long sym;") Nl
-      Put("   char * text;") Nl --xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
-      Put("   struct LEXELEMSTRUCT *next;") Nl
       Put("} LEXELEM;") Nl
       Put("   ") Nl
-      Put("LEXELEM *first_lexelem, *cur_lexelem;") Nl
+      Put("LEXELEM *lexelems = 0;") Nl
+      Put("long lexelem_count = 0;") Nl
+      Put("long lexelem_room = 0;") Nl
+      PutThreadLocal Put("long cur_lexelem = 0;") Nl
+      Put("") Nl
+      Put("extern void *yymemrealloc();") Nl
+      Put("extern void yymemfree();") Nl
       Put("") Nl
       Put("void init_lexelem()") Nl
       Put("{") Nl
-      Put("   cur_lexelem = first_lexelem;") Nl
+      Put("   cur_lexelem = 0;") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("static void append_lexelem(YYSTYPE *val, long pos) {") Nl
+      Put("   if (lexelem_count == lexelem_room) {") Nl
+      Put("      long room = lexelem_room ? 2 * lexelem_room : 1024;") Nl
+      Put("      LEXELEM *p;") Nl
+      Put("      p = (LEXELEM *)yymemrealloc(lexelems, room * sizeof(LEXELEM));") Nl
+      Put("      if (! p) yymallocerror();") Nl
+      Put("      lexelems = p;") Nl
+      Put("      lexelem_room = room;") Nl
+      Put("   }") Nl
+      Put("   lexelems[lexelem_count].val = *val;") Nl
+      Put("   lexelems[lexelem_count].pos = pos;") Nl
+      Put("   lexelem_count++;") Nl
+      Put("}") Nl
+      Put("") Nl
+      -- the _at variants take the value and position of the token
+      -- from the caller instead of yylval and yypos
+      -- (used by ENTIRE if the scanner runs on a thread of its own)
+      Put("void first_lexval_at (void *val, long pos) {") Nl
+      Put("   lexelem_count = 0;") Nl
+      Put("   cur_lexelem = 0;") Nl
+      Put("   append_lexelem((YYSTYPE *)val, pos);") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("void next_lexval_at (void *val, long pos) {") Nl
+      Put("   append_lexelem((YYSTYPE *)val, pos);") Nl
       Put("}") Nl
       Put("") Nl
       Put("void first_lexval () {") Nl
-      Put("   LEXELEM *p;") Nl
-      Put("   p = (LEXELEM *)malloc(sizeof(LEXELEM));") Nl
-      Put("   if (! p) yymallocerror();") Nl
-      Put("   p->val = yylval;") Nl
-      Put("   p->pos = yypos;") Nl
-      --Put("   p->text = yytokenname;") Nl --xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
-      Put("   p->next = 0;") Nl
-      Put("   cur_lexelem = p;") Nl
-      Put("   first_lexelem = p;") Nl
+      Put("   first_lexval_at(&yylval, yypos);") Nl
       Put("}") Nl
       Put("") Nl
       Put("void next_lexval() {") Nl
-      Put("   LEXELEM *p;") Nl
-      Put("   p = (LEXELEM *)malloc(sizeof(LEXELEM));") Nl
-      Put("   if (! p) yymallocerror();") Nl
-      Put("   cur_lexelem-> next = p;") Nl
-      Put("   p->val = yylval;") Nl
-      Put("   p->pos = yypos;") Nl
-      --Put("   p->text = yytokenname;") Nl --xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
-      Put("   p->next = 0;") Nl
-      Put("   cur_lexelem = p;") Nl
+      Put("   next_lexval_at(&yylval, yypos);") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("int yylval_size() {") Nl
+      Put("   return sizeof(YYSTYPE);") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("void *yylval_address() {") Nl
+      Put("   return &yylval;") Nl
       Put("}") Nl
       Put("") Nl
       Put("void get_lexval() {") Nl
-      Put("   extern int FREE_LEXELEMS;") Nl
-      Put("   LEXELEM *p;") Nl -- xxx new
-      Put("   yylval = cur_lexelem->val;") Nl
-      Put("   yypos = cur_lexelem->pos;") Nl
-      --Put("   yytokenname = cur_lexelem->text;") Nl --xxxxxxxxxxxxxxxxxxxxx
-      --Put("   printf(\"<%s pos=\\\"%d\\\"/>\\n\", yytokenname, yypos);") Nl --xxxxxxxxxxxxxxxxxxxxx
-      Put("   p = cur_lexelem;") Nl -- xxx new
-      Put("   cur_lexelem = cur_lexelem->next;") Nl
-      Put("   free(p);") Nl -- xxx new
+      Put("   yylval = lexelems[cur_lexelem].val;") Nl
+      PutSetPos Nl
+      Put("   cur_lexelem++;") Nl
+      Put("}") Nl
+      Put("") Nl
+      -- skip_lexvals(n) passes over n tokens (used by yyskip())
+      Put("void skip_lexvals(long n) {") Nl
+      Put("   cur_lexelem += n;") Nl
+      Put("}") Nl
+      Put("") Nl
+      -- random access for semantic actions:
+      -- tokens are numbered from 0 in the order of the input,
+      -- yytokencount() includes the final EOF token,
+      -- yytokenindex() is the number of the token last passed to an action
+      Put("long yytokenindex() {") Nl
+      Put("   return cur_lexelem - 1;") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("long yytokencount() {") Nl
+      Put("   return lexelem_count;") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("YYSTYPE *yylexval(long i) {") Nl
+      Put("   return &lexelems[i].val;") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("long yylexpos(long i) {") Nl
+      Put("   return lexelems[i].pos;") Nl
+      Put("}") Nl
+      Put("") Nl
+      -- the array is kept until the tree walker(s) are finished,
+      -- then its memory is kept for the next parse
+      Put("void free_lexelems() {") Nl
+      Put("   lexelem_count = 0;") Nl
+      Put("   cur_lexelem = 0;") Nl
+      Put("}") Nl
+      Put("") Nl
+      Put("void release_lexelems() {") Nl
+      Put("   free_lexelems();") Nl
+      Put("   if (lexelems) yymemfree(lexelems);") Nl
+      Put("   lexelems = 0;") Nl
+      Put("   lexelem_room = 0;") Nl
       Put("}") Nl
       Nl
@@ -185,10 +185,14 @@
    Put("   return TABLE[i][j];") Nl
    Put("}") Nl
 
+   write_dirset2_table
+
    write_transparent
 
    write_printnames
 
+   WriteTables
+
 'action' get_rulecount(-> INT)
 
 --------------------------------------------------------------------------------
@@ -311,6 +315,11 @@
 
 'action' get_dirset(RuleId: INT -> DirSet: SET)
 
+-- LL(2) director sets (only with option -ll2)
+
+'action' add_dirset2(RuleNumber: INT, RuleId: INT)
+'action' write_dirset2_table
+
 -- sets:
 'type' SET
 'action' emit_set(SET)
@@ -437,6 +446,7 @@
       FieldIndex -> X
       Put("/* ") PutI(X) Put(" */ ") PutI(N) Put(",") Nl
       FieldIndex <- X+1
+      TableField(X, N)
 
 --------------------------------------------------------------------------------
 
@@ -599,6 +609,7 @@
       Key'RuleHandle -> Handle
       get_dirset(Handle -> Set)
       write_set(K, Set)
+      add_dirset2(K, Handle)
 
 --------------------------------------------------------------------------------
 'action' write_transparent
@@ -743,9 +754,11 @@
 	 where(Lhs -> nonterm(Id))
 	 id_to_string(Id -> Str)
 	 Put(Str)
+	 TableName(Pos, Str)
       ||
 	 where(Lhs -> subphrase(Sub))
 	 Put("Subphrase")
+	 TableName(Pos, "Subphrase")
       |)
       Put("\"; break;")
       Nl
@@ -762,3 +775,17 @@
 	 gt(N, Old)
 	 TABLEUPB2 <- N
       |]
+
+--------------------------------------------------------------------------------
+
+--
+-- Binary Tables (option -tables)
+--
+
+-- the fields of yygrammar, yyannotation and yycoordinate (each array
+-- starts with field index 1), the director sets and the printnames
+-- are also collected and written to yygrammar.tab
+
+'action' TableField(Index: INT, Value: INT)
+'action' TableName(Code: INT, Name: STRING)
+'action' WriteTables
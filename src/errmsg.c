@@ -26,17 +26,33 @@
  */
 
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #define PRIVATE static
 
 /*--------------------------------------------------------------------*/
 /* Source Positions                                                   */
 /*--------------------------------------------------------------------*/
 
-#define yyLCODE 1000L
+/*
+ * A source position is the byte offset of a character in the source
+ * file (the first character has offset 0).
+ * The scanner only advances yypos, newlines are not treated specially.
+ * Line and column are obtained from an index of line starts that is
+ * built when it is needed for the first time (by rereading the file).
+ * If the source cannot be reread (stdin), messages show the offset.
+ */
 
-long yypos = (yyLCODE+1);
+long yypos = 0;
 
-PRIVATE long yyLineCount = 1;
+extern void GetSourceFileName(char **ref_string);
+
+PRIVATE long *yyLineStart = 0;  /* offsets of the first chars of lines */
+PRIVATE long yyLineCount = 0;
+PRIVATE long yyLineRoom = 0;
+PRIVATE int yyLinesKnown = 0;   /* 0 if the source could not be reread */
 
 /*--------------------------------------------------------------------*/
 void yyGetPos(long *ref_pos) {
@@ -45,24 +61,87 @@ void yyGetPos(long *ref_pos) {
 
 /*--------------------------------------------------------------------*/
 
-void yyPosToNextLine() {
-   yyLineCount++;
-   yypos = yyLineCount*yyLCODE+1;
+PRIVATE void yyAddLine(long start) {
+   if (yyLineCount == yyLineRoom) {
+      yyLineRoom = yyLineRoom ? 2*yyLineRoom : 1024;
+      yyLineStart = (long *) realloc(yyLineStart, yyLineRoom*sizeof(long));
+      if (! yyLineStart) {
+         printf("running out of memory\n");
+         exit(1);
+      }
+   }
+   yyLineStart[yyLineCount++] = start;
+}
+
+/*--------------------------------------------------------------------*/
+
+/* build the index of line starts, newlines are found with memchr */
+
+PRIVATE void yyBuildLineIndex() {
+   char *name;
+   FILE *f;
+   static char buf[65536];
+   long offset, n;
+   char *p, *end;
+
+   yyAddLine(0);
+
+   GetSourceFileName(&name);
+   if (! name) return; /* stdin cannot be reread: a single line */
+   f = fopen(name, "rb");
+   if (! f) return;
+   yyLinesKnown = 1;
+
+   offset = 0;
+   while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+      p = buf;
+      end = buf + n;
+      while ((p = memchr(p, '\n', end - p)) != 0) {
+         p++;
+         yyAddLine(offset + (p - buf));
+      }
+      offset += n;
+   }
+   fclose(f);
+}
+
+/*--------------------------------------------------------------------*/
+
+/*
+ * line and column of the position following pos
+ * (yyGetPos yields the position of the last character read,
+ * the column is counted from 1)
+ */
+
+PRIVATE void yyLineColAtPos(long pos, long *ref_line, long *ref_col) {
+   long lo, hi, mid;
+
+   if (! yyLineStart) yyBuildLineIndex();
+
+   pos++;
+   lo = 0; hi = yyLineCount - 1;
+   while (lo < hi) {
+      mid = (lo + hi + 1) / 2;
+      if (yyLineStart[mid] <= pos) lo = mid;
+      else hi = mid - 1;
+   }
+   *ref_line = lo + 1;
+   *ref_col = pos - yyLineStart[lo];
 }
 
 /*--------------------------------------------------------------------*/
 
-PRIVATE long yyLineAtPos(long pos) {
-   long l;
-   l = pos / yyLCODE;
+long yyLineAtPos(long pos) {
+   long l, c;
+   yyLineColAtPos(pos, &l, &c);
    return l;
 }
 
 /*--------------------------------------------------------------------*/
 
-PRIVATE long yyColAtPos(long pos) {
-   long c;
-   c = pos % yyLCODE;
+long yyColAtPos(long pos) {
+   long l, c;
+   yyLineColAtPos(pos, &l, &c);
    return c;
 }
 
@@ -71,7 +150,12 @@ PRIVATE long yyColAtPos(long pos) {
 /*--------------------------------------------------------------------*/
 
 void Error(char *msg, long pos) {
-   printf("line %d, col %d: %s\n",
+   if (! yyLineStart) yyBuildLineIndex();
+   if (! yyLinesKnown) {
+      printf("offset %ld: %s\n", pos+1, msg);
+      exit(1);
+   }
+   printf("line %ld, col %ld: %s\n",
    yyLineAtPos(pos), yyColAtPos(pos), msg);
    exit(1);
 }
@@ -64,6 +64,9 @@
       Literals -> L
       Literals <- list(literal(Str, N), L)
 
+'action' PutThreadLocal
+'action' TableTokenName(INT, STRING)
+
 'action' lexinfo
 
 'rule' lexinfo
@@ -71,8 +74,12 @@
    Put("#ifndef YYSTYPE") Nl
    Put("#define YYSTYPE long") Nl
    Put("#endif") Nl
-   Put("extern YYSTYPE yylval;") Nl
+   Put("extern ") PutThreadLocal Put("YYSTYPE yylval;") Nl
    Put("extern long yypos;") Nl
+   Put("extern long yytokenindex();") Nl
+   Put("extern long yytokencount();") Nl
+   Put("extern YYSTYPE *yylexval();") Nl
+   Put("extern long yylexpos();") Nl
    Nl
 
    Tokens -> TL
@@ -117,6 +124,7 @@
       id_to_string(Id -> Str)
       Put(Str)
       Put("\"; break;") Nl
+      TableTokenName(N, Str)
 
       wherenext(Tail -> TL)
    *>
@@ -130,6 +138,7 @@
       Put(": return \"")
       Put(Str)
       Put("\"; break;") Nl
+      TableTokenName(N, Str)
 
       wherenext(Tail -> LL)
    *>
@@ -79,6 +79,7 @@ PUBLIC void write_set(int n, set s) {
       PutI(p->head);
       Put("] = 1;");
       Nl();
+      TableDirset(n, p->head);
       p = p->tail;
    }
 }
@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "yygrammar.h"
+
+extern YYSTYPE yylval;
+extern long yypos;
+
+/* yypos is the offset of the token in the input */
+static long offset = 0;
+
+yylex()
+{
+   int c;
+
+   do {
+      c = getchar();
+      offset++;
+   } while (c == ' ' || c == '\t' || c == '\n');
+   yypos = offset;
+   if (c == EOF) {
+      return 0;
+   }
+   if (isalpha(c)) {
+      while (isalnum(c = getchar())) offset++;
+      ungetc(c, stdin);
+      return IDENT;
+   }
+   if (isdigit(c)) {
+      while (isdigit(c = getchar())) offset++;
+      ungetc(c, stdin);
+      return NUMBER;
+   }
+   return c;
+}
+
+main()
+{
+   yyparse();
+   printf("ok\n");
+   return 0;
+}
+
+yyerror(msg)
+   char *msg;
+{
+   printf("%ld: %s\n", yypos, msg);
+   exit(1);
+}
@@ -0,0 +1,43 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "yygrammar.h"
+
+extern YYSTYPE yylval;
+extern long yypos;
+
+yylex()
+{
+   int c;
+
+   do {
+      c = getchar();
+      if (c == '\n') yypos++;
+   } while (c == ' ' || c == '\t' || c == '\n');
+   if (c == EOF) {
+      return 0;
+   }
+   if (isdigit(c)) {
+      yylval = 0;
+      while (isdigit(c)) {
+	 yylval = 10*yylval + c - '0';
+	 c = getchar();
+      }
+      ungetc(c, stdin);
+      return NUMBER;
+   }
+   return c;
+}
+
+main()
+{
+   yyparse();
+   return 0;
+}
+
+yyerror(msg)
+   char *msg;
+{
+   printf("line %ld: %s\n", yypos, msg);
+   exit(1);
+}